@@ -4,6 +4,7 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../src/argsort.c \
 ../src/bubblesort.c \
 ../src/bubblesortll.c \
 ../src/bucketsort.c \
@@ -13,24 +14,33 @@ C_SRCS += \
 ../src/insertionsort.c \
 ../src/insertionsortll.c \
 ../src/introsort.c \
+../src/kvsort.c \
 ../src/linkedlist.c \
 ../src/llsort.c \
 ../src/main.c \
 ../src/mergesort.c \
 ../src/mergesortll.c \
+../src/pdqsort.c \
 ../src/quicksort.c \
 ../src/quicksortll.c \
+../src/radixsortkey.c \
 ../src/radixsortlsd.c \
 ../src/radixsortmsd.c \
 ../src/radixsortstr.c \
+../src/samplesort.c \
 ../src/selectionsort.c \
 ../src/shellsort.c \
 ../src/sort.c \
+../src/sortauto.c \
+../src/sortstats.c \
+../src/sorttyped.c \
+../src/threadpool.c \
 ../src/timsort.c \
 ../src/treesort.c \
 ../src/twayquicksort.c 
 
 C_DEPS += \
+./src/argsort.d \
 ./src/bubblesort.d \
 ./src/bubblesortll.d \
 ./src/bucketsort.d \
@@ -40,24 +50,33 @@ C_DEPS += \
 ./src/insertionsort.d \
 ./src/insertionsortll.d \
 ./src/introsort.d \
+./src/kvsort.d \
 ./src/linkedlist.d \
 ./src/llsort.d \
 ./src/main.d \
 ./src/mergesort.d \
 ./src/mergesortll.d \
+./src/pdqsort.d \
 ./src/quicksort.d \
 ./src/quicksortll.d \
+./src/radixsortkey.d \
 ./src/radixsortlsd.d \
 ./src/radixsortmsd.d \
 ./src/radixsortstr.d \
+./src/samplesort.d \
 ./src/selectionsort.d \
 ./src/shellsort.d \
 ./src/sort.d \
+./src/sortauto.d \
+./src/sortstats.d \
+./src/sorttyped.d \
+./src/threadpool.d \
 ./src/timsort.d \
 ./src/treesort.d \
 ./src/twayquicksort.d 
 
 OBJS += \
+./src/argsort.o \
 ./src/bubblesort.o \
 ./src/bubblesortll.o \
 ./src/bucketsort.o \
@@ -67,19 +86,27 @@ OBJS += \
 ./src/insertionsort.o \
 ./src/insertionsortll.o \
 ./src/introsort.o \
+./src/kvsort.o \
 ./src/linkedlist.o \
 ./src/llsort.o \
 ./src/main.o \
 ./src/mergesort.o \
 ./src/mergesortll.o \
+./src/pdqsort.o \
 ./src/quicksort.o \
 ./src/quicksortll.o \
+./src/radixsortkey.o \
 ./src/radixsortlsd.o \
 ./src/radixsortmsd.o \
 ./src/radixsortstr.o \
+./src/samplesort.o \
 ./src/selectionsort.o \
 ./src/shellsort.o \
 ./src/sort.o \
+./src/sortauto.o \
+./src/sortstats.o \
+./src/sorttyped.o \
+./src/threadpool.o \
 ./src/timsort.o \
 ./src/treesort.o \
 ./src/twayquicksort.o 
@@ -97,7 +124,7 @@ src/%.o: ../src/%.c src/subdir.mk
 clean: clean-src
 
 clean-src:
-	-$(RM) ./src/bubblesort.d ./src/bubblesort.o ./src/bubblesortll.d ./src/bubblesortll.o ./src/bucketsort.d ./src/bucketsort.o ./src/combsort.d ./src/combsort.o ./src/countingsort.d ./src/countingsort.o ./src/heapsort.d ./src/heapsort.o ./src/insertionsort.d ./src/insertionsort.o ./src/insertionsortll.d ./src/insertionsortll.o ./src/introsort.d ./src/introsort.o ./src/linkedlist.d ./src/linkedlist.o ./src/llsort.d ./src/llsort.o ./src/main.d ./src/main.o ./src/mergesort.d ./src/mergesort.o ./src/mergesortll.d ./src/mergesortll.o ./src/quicksort.d ./src/quicksort.o ./src/quicksortll.d ./src/quicksortll.o ./src/radixsortlsd.d ./src/radixsortlsd.o ./src/radixsortmsd.d ./src/radixsortmsd.o ./src/radixsortstr.d ./src/radixsortstr.o ./src/selectionsort.d ./src/selectionsort.o ./src/shellsort.d ./src/shellsort.o ./src/sort.d ./src/sort.o ./src/timsort.d ./src/timsort.o ./src/treesort.d ./src/treesort.o ./src/twayquicksort.d ./src/twayquicksort.o
+	-$(RM) ./src/argsort.d ./src/argsort.o ./src/bubblesort.d ./src/bubblesort.o ./src/bubblesortll.d ./src/bubblesortll.o ./src/bucketsort.d ./src/bucketsort.o ./src/combsort.d ./src/combsort.o ./src/countingsort.d ./src/countingsort.o ./src/heapsort.d ./src/heapsort.o ./src/insertionsort.d ./src/insertionsort.o ./src/insertionsortll.d ./src/insertionsortll.o ./src/introsort.d ./src/introsort.o ./src/kvsort.d ./src/kvsort.o ./src/linkedlist.d ./src/linkedlist.o ./src/llsort.d ./src/llsort.o ./src/main.d ./src/main.o ./src/mergesort.d ./src/mergesort.o ./src/mergesortll.d ./src/mergesortll.o ./src/pdqsort.d ./src/pdqsort.o ./src/quicksort.d ./src/quicksort.o ./src/quicksortll.d ./src/quicksortll.o ./src/radixsortkey.d ./src/radixsortkey.o ./src/radixsortlsd.d ./src/radixsortlsd.o ./src/radixsortmsd.d ./src/radixsortmsd.o ./src/radixsortstr.d ./src/radixsortstr.o ./src/samplesort.d ./src/samplesort.o ./src/selectionsort.d ./src/selectionsort.o ./src/shellsort.d ./src/shellsort.o ./src/sort.d ./src/sort.o ./src/sortauto.d ./src/sortauto.o ./src/sortstats.d ./src/sortstats.o ./src/sorttyped.d ./src/sorttyped.o ./src/threadpool.d ./src/threadpool.o ./src/timsort.d ./src/timsort.o ./src/treesort.d ./src/treesort.o ./src/twayquicksort.d ./src/twayquicksort.o
 
 .PHONY: clean-src
 
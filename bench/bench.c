@@ -0,0 +1,1237 @@
+/*
+ * bench.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Benchmark of the sorting functions of the library (libcsorting-bench).
+ *
+ * About:
+ *
+ * 	Every array, linked list, values, counting and radix sorting function is run on
+ * 	each input distribution (see benchinput.h) and size, and the time of each sort
+ * 	is measured over several repetitions. The results are printed as a table and
+ * 	can be written as CSV and JSON to track regressions between versions.
+ *
+ * 	Ints are the keys of all sorts. The sorts of other types get the same inputs
+ * 	converted to their type (int64_t, float, double or decimal strings), so the
+ * 	order of the elements is kept.
+ *
+ * 	Each repetition prepares fresh copies of the input (arrays of pointers, linked
+ * 	lists, arrays of values) before starting the clock, so only the sort is timed.
+ * 	Small sizes sort a batch of copies per repetition, so the time of a repetition
+ * 	is well above the clock resolution, and report the time per sort. The result
+ * 	of every sort is checked.
+ *
+ * 	Quadratic algorithms and algorithms whose recursion depth grows with n on some
+ * 	inputs have a maximum size, the counting sorts are only run on inputs with a
+ * 	small range of keys, and an algorithm is not run on bigger sizes of a
+ * 	distribution once a sort took longer than the time limit (--max-seconds).
+ *
+ *
+ * Usage: libcsorting-bench [options]
+ *
+ * 	--sizes=n1,n2,...	sizes to run (default: powers of 10 from --min-size to --max-size)
+ * 	--min-size=n		smallest size (default 10)
+ * 	--max-size=n		biggest size (default 1000000, up to 100000000)
+ * 	--reps=n			repetitions of each case (default 5)
+ * 	--algo=a1,a2,...	only algorithms whose name contains one of the strings
+ * 	--dist=d1,d2,...	only these distributions
+ * 	--threads=n			threads of the parallel sorts (default 0: online processors)
+ * 	--seed=n			seed of the random inputs (default 1)
+ * 	--max-seconds=s		time limit of a sort before bigger sizes are skipped (default 1)
+ * 	--csv=file			write the results as CSV
+ * 	--json=file			write the results as JSON
+ * 	--stats				count comparisons, swaps, moves and memory of one more sort
+ * 						of each case (all the counts need a -DSORT_STATS build,
+ * 						see libcsorting-bench-stats)
+ * 	--perf				count cycles, instructions, L1 data and last level cache
+ * 						misses, branches and branch misses of the timed sorts with
+ * 						the hardware performance counters (see benchperf.h); the
+ * 						counters not available are reported as n/a
+ * 	--list				list the algorithms and distributions and exit
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "benchinput.h"
+#include "benchperf.h"
+#include "sort.h"
+#include "linkedlist.h"
+#include "llsort.h"
+#include "selectionsort.h"
+#include "bubblesort.h"
+#include "insertionsort.h"
+#include "combsort.h"
+#include "shellsort.h"
+#include "quicksort.h"
+#include "twayquicksort.h"
+#include "mergesort.h"
+#include "heapsort.h"
+#include "timsort.h"
+#include "introsort.h"
+#include "pdqsort.h"
+#include "samplesort.h"
+#include "treesort.h"
+#include "bucketsort.h"
+#include "countingsort.h"
+#include "radixsortlsd.h"
+#include "radixsortmsd.h"
+#include "radixsortstr.h"
+#include "radixsortkey.h"
+#include "argsort.h"
+#include "kvsort.h"
+#include "sortstats.h"
+#include "sortauto.h"
+#include "sorttyped.h"
+#include "bubblesortll.h"
+#include "insertionsortll.h"
+#include "quicksortll.h"
+#include "mergesortll.h"
+
+/*
+ * Layouts of the data given to the sorting functions.
+ */
+#define BENCH_ARRAY 0		// array of pointers to the elements (SortArrayFunc)
+#define BENCH_LIST 1		// linked list of pointers to ints (SortLinkedListFunc)
+#define BENCH_VALUES 2		// contiguous ints (SortValuesFunc)
+#define BENCH_TYPED 3		// contiguous elements of the type (BenchTypedFunc)
+
+/*
+ * Types of the elements.
+ */
+#define BENCH_INT 0
+#define BENCH_INT64 1
+#define BENCH_FLOAT 2
+#define BENCH_DOUBLE 3
+#define BENCH_STRING 4
+
+/*
+ * Maximum size of the quadratic algorithms and of the algorithms whose recursion
+ * depth grows with n on sorted inputs.
+ */
+#define BENCH_MAXN_QUADRATIC 20000
+#define BENCH_MAXN_UNLIMITED 100000000
+
+/*
+ * Maximum range of the keys (max - min) of the counting sorts, whose histogram
+ * has one counter per value of the range.
+ */
+#define BENCH_RANGE_COUNTING (UINT64_C (1) << 24)
+#define BENCH_RANGE_UNLIMITED UINT64_MAX
+
+/*
+ * Small sizes sort copies of the input until this number of elements per repetition.
+ */
+static const size_t bench_BATCH_ELEMENTS = 65536;
+
+/*
+ * Characters of a decimal string of an int, with the terminator.
+ */
+#define BENCH_STRING_SIZE 12
+
+/*
+ * Sorts the contiguous elements arr[from..to] of the type of the algorithm.
+ */
+typedef void (*BenchTypedFunc)(void* arr, const int from, const int to);
+
+/*
+ * Sorting function of the benchmark.
+ */
+struct BenchAlgorithm {
+	const char* name;
+	int layout;
+	int type;
+	SortArrayFunc arrayfunc;
+	SortLinkedListFunc listfunc;
+	SortValuesFunc valuesfunc;
+	BenchTypedFunc typedfunc;
+	size_t maxn;
+	uint64_t maxrange;
+};
+
+/*
+ * Statistics of the repetitions of a case, in nanoseconds per sort.
+ */
+struct BenchResult {
+	const char* algorithm;
+	const char* distribution;
+	size_t n;
+	int reps;
+	size_t batch;
+	double min;
+	double p10;
+	double median;
+	double p90;
+	double p99;
+	double max;
+	double mean;
+	int ok;
+	struct SortStats stats;
+	double perf[BENCHPERF_COUNT];	// counters per sort, NAN if not available
+};
+
+/*
+ * Number of threads of the parallel sorts.
+ */
+static int bench_nthreads = 0;
+
+
+/*
+ * Comparison functions of the elements.
+ */
+static int bench_compare_ints (const void* a, const void* b)
+{
+	int x = *(const int*)a;
+	int y = *(const int*)b;
+	return (x > y) - (x < y);
+}
+
+static int bench_compare_int64 (const void* a, const void* b)
+{
+	int64_t x = *(const int64_t*)a;
+	int64_t y = *(const int64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static int bench_compare_floats (const void* a, const void* b)
+{
+	float x = *(const float*)a;
+	float y = *(const float*)b;
+	return (x > y) - (x < y);
+}
+
+static int bench_compare_doubles (const void* a, const void* b)
+{
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+static int bench_compare_strings (const void* a, const void* b)
+{
+	return strcmp ((const char*)a, (const char*)b);
+}
+
+/*
+ * Returns the comparison function of the elements of 'type'.
+ */
+static SortCompareFunc bench_comparefunc (const int type)
+{
+	switch (type) {
+	case BENCH_INT64:
+		return bench_compare_int64;
+	case BENCH_FLOAT:
+		return bench_compare_floats;
+	case BENCH_DOUBLE:
+		return bench_compare_doubles;
+	case BENCH_STRING:
+		return bench_compare_strings;
+	default:
+		return bench_compare_ints;
+	}
+}
+
+/*
+ * Returns the size of an element of 'type' (a pointer for strings).
+ */
+static size_t bench_type_size (const int type)
+{
+	switch (type) {
+	case BENCH_INT64:
+		return sizeof (int64_t);
+	case BENCH_FLOAT:
+		return sizeof (float);
+	case BENCH_DOUBLE:
+		return sizeof (double);
+	case BENCH_STRING:
+		return sizeof (char*);
+	default:
+		return sizeof (int);
+	}
+}
+
+
+/*
+ * Adapters of the sorting functions with extra arguments.
+ */
+static int bench_int_key (const void* item)
+{
+	return *(const int*)item;
+}
+
+static uint32_t bench_int_key32 (const void* item)
+{
+	return radixsortkey_key_i32 (*(const int32_t*)item);
+}
+
+static void bench_quicksort_parallel (void* arr[], const int from, const int to,
+									  SortCompareFunc comparefunc)
+{
+	quicksort_sort_parallel (arr, from, to, comparefunc, bench_nthreads);
+}
+
+static void bench_mergesort_parallel (void* arr[], const int from, const int to,
+									  SortCompareFunc comparefunc)
+{
+	mergesort_sort_parallel (arr, from, to, comparefunc, bench_nthreads);
+}
+
+static void bench_samplesort_parallel (void* arr[], const int from, const int to,
+									   SortCompareFunc comparefunc)
+{
+	samplesort_sort_parallel (arr, from, to, comparefunc, bench_nthreads);
+}
+
+static void bench_bucketsort_ints_parallel (void* arr[], const int from, const int to,
+											SortCompareFunc comparefunc)
+{
+	bucketsort_sort_ints_parallel (arr, from, to, comparefunc, bench_nthreads);
+}
+
+static void bench_bucketsort_floats_parallel (void* arr[], const int from, const int to,
+											  SortCompareFunc comparefunc)
+{
+	bucketsort_sort_floats_parallel (arr, from, to, comparefunc, bench_nthreads);
+}
+
+static void bench_bucketsort_doubles_parallel (void* arr[], const int from, const int to,
+											   SortCompareFunc comparefunc)
+{
+	bucketsort_sort_doubles_parallel (arr, from, to, comparefunc, bench_nthreads);
+}
+
+static void bench_bucketsort_sampled (void* arr[], const int from, const int to,
+									  SortCompareFunc comparefunc)
+{
+	bucketsort_sort_sampled (arr, from, to, comparefunc, pdqsort_sort);
+}
+
+static void bench_bucketsort_sampled_parallel (void* arr[], const int from, const int to,
+											   SortCompareFunc comparefunc)
+{
+	bucketsort_sort_sampled_parallel (arr, from, to, comparefunc, pdqsort_sort,
+									  bench_nthreads);
+}
+
+static void bench_countingsort_items (void* arr[], const int from, const int to,
+									  SortCompareFunc comparefunc)
+{
+	(void) comparefunc;
+	countingsort_sort_items (arr, from, to, bench_int_key);
+}
+
+static void bench_countingsort_items_parallel (void* arr[], const int from, const int to,
+											   SortCompareFunc comparefunc)
+{
+	(void) comparefunc;
+	countingsort_sort_items_parallel (arr, from, to, bench_int_key, bench_nthreads);
+}
+
+static void bench_radixsortkey_u32 (void* arr[], const int from, const int to,
+									SortCompareFunc comparefunc)
+{
+	(void) comparefunc;
+	radixsortkey_sort_u32 (arr, from, to, bench_int_key32);
+}
+
+static void bench_sort_auto (void* arr[], const int from, const int to,
+							 SortCompareFunc comparefunc)
+{
+	sort_auto (arr, from, to, comparefunc);
+}
+
+static void bench_sort_auto_key32 (void* arr[], const int from, const int to,
+								   SortCompareFunc comparefunc)
+{
+	sort_auto_key32 (arr, from, to, comparefunc, bench_int_key32);
+}
+
+static void bench_radixsortlsd_floats (void* arr[], const int from, const int to,
+									   SortCompareFunc comparefunc)
+{
+	(void) comparefunc;
+	radixsortlsd_sort_floats (arr, from, to, 0);
+}
+
+static void bench_radixsortlsd_doubles (void* arr[], const int from, const int to,
+										SortCompareFunc comparefunc)
+{
+	(void) comparefunc;
+	radixsortlsd_sort_doubles (arr, from, to, 0);
+}
+
+/*
+ * Defines 'static void name (void* arr, const int from, const int to)' calling
+ * 'call' with 'a', the array of 'type'.
+ */
+#define BENCH_TYPED_FUNC(name, type, call) \
+	static void name (void* arr, const int from, const int to) \
+	{ \
+		type* a = arr; \
+		call; \
+	}
+
+BENCH_TYPED_FUNC (bench_countingsort, int,
+				  countingsort_sort_in_place (a, from, to))
+BENCH_TYPED_FUNC (bench_countingsort_parallel, int,
+				  countingsort_sort_in_place_parallel (a, from, to, bench_nthreads))
+BENCH_TYPED_FUNC (bench_countingsort_copy, int,
+				  int* out = countingsort_sort (a + from, to - from + 1, 0, to - from);
+				  memcpy (a + from, out, (size_t)(to - from + 1) * sizeof (int));
+				  free (out))
+BENCH_TYPED_FUNC (bench_countingsort_records, int,
+				  countingsort_sort_records (a + from, (size_t)(to - from + 1),
+											 sizeof (int), bench_int_key))
+BENCH_TYPED_FUNC (bench_radixsortlsd_ints, int, radixsortlsd_sort_ints (a, from, to))
+BENCH_TYPED_FUNC (bench_radixsortlsd_i64, int64_t, radixsortlsd_sort_i64 (a, from, to))
+BENCH_TYPED_FUNC (bench_radixsortlsd_float, float, radixsortlsd_sort_float (a, from, to, 0))
+BENCH_TYPED_FUNC (bench_radixsortlsd_double, double,
+				  radixsortlsd_sort_double (a, from, to, 0))
+BENCH_TYPED_FUNC (bench_radixsortmsd_ints, int, radixsortmsd_sort_ints (a, from, to))
+BENCH_TYPED_FUNC (bench_radixsortmsd_i64, int64_t, radixsortmsd_sort_i64 (a, from, to))
+BENCH_TYPED_FUNC (bench_radixsortstr, char*, radixsortstr_sort (a, from, to))
+BENCH_TYPED_FUNC (bench_radixsortstr_mkqsort, char*, radixsortstr_mkqsort (a, from, to))
+BENCH_TYPED_FUNC (bench_samplesort_i32, int32_t, samplesort_sort_i32 (a, from, to))
+BENCH_TYPED_FUNC (bench_samplesort_i32_parallel, int32_t,
+				  samplesort_sort_i32_parallel (a, from, to, bench_nthreads))
+BENCH_TYPED_FUNC (bench_samplesort_i64, int64_t, samplesort_sort_i64 (a, from, to))
+BENCH_TYPED_FUNC (bench_samplesort_float, float, samplesort_sort_float (a, from, to))
+BENCH_TYPED_FUNC (bench_samplesort_double, double, samplesort_sort_double (a, from, to))
+BENCH_TYPED_FUNC (bench_sort_int_introsort, int,
+				  sort_int_introsort (a + from, (size_t)(to - from + 1)))
+BENCH_TYPED_FUNC (bench_sort_int_mergesort, int,
+				  sort_int_mergesort (a + from, (size_t)(to - from + 1)))
+BENCH_TYPED_FUNC (bench_sort_int_timsort, int,
+				  sort_int_timsort (a + from, (size_t)(to - from + 1)))
+BENCH_TYPED_FUNC (bench_sort_int_heapsort, int,
+				  sort_int_heapsort (a + from, (size_t)(to - from + 1)))
+BENCH_TYPED_FUNC (bench_sort_double_introsort, double,
+				  sort_double_introsort (a + from, (size_t)(to - from + 1)))
+BENCH_TYPED_FUNC (bench_argsort_radix_i32, int32_t,
+				  size_t n = (size_t)(to - from + 1);
+				  int32_t* idx = malloc (n * sizeof (int32_t));
+				  argsort_radix_i32 (a + from, n, idx);
+				  argsort_apply_permutation (a + from, n, sizeof (int32_t), idx);
+				  free (idx))
+BENCH_TYPED_FUNC (bench_argsort_stable, int,
+				  size_t n = (size_t)(to - from + 1);
+				  int32_t* idx = malloc (n * sizeof (int32_t));
+				  argsort_stable_sort (a + from, n, sizeof (int), bench_compare_ints, idx);
+				  argsort_apply_permutation (a + from, n, sizeof (int), idx);
+				  free (idx))
+BENCH_TYPED_FUNC (bench_kvsort_i32, int32_t,
+				  kvsort_sort_i32 (a + from, (size_t)(to - from + 1), NULL, 0, 1))
+
+
+/*
+ * Algorithms of the benchmark.
+ */
+#define BENCH_ARRAY_ALGORITHM(name, func, type, maxn) \
+	{ name, BENCH_ARRAY, type, func, NULL, NULL, NULL, maxn, BENCH_RANGE_UNLIMITED }
+#define BENCH_LIST_ALGORITHM(name, func, maxn) \
+	{ name, BENCH_LIST, BENCH_INT, NULL, func, NULL, NULL, maxn, BENCH_RANGE_UNLIMITED }
+#define BENCH_VALUES_ALGORITHM(name, func, maxn) \
+	{ name, BENCH_VALUES, BENCH_INT, NULL, NULL, func, NULL, maxn, BENCH_RANGE_UNLIMITED }
+#define BENCH_TYPED_ALGORITHM(name, func, type, maxn) \
+	{ name, BENCH_TYPED, type, NULL, NULL, NULL, func, maxn, BENCH_RANGE_UNLIMITED }
+#define BENCH_COUNTING_ARRAY_ALGORITHM(name, func) \
+	{ name, BENCH_ARRAY, BENCH_INT, func, NULL, NULL, NULL, BENCH_MAXN_UNLIMITED, \
+	  BENCH_RANGE_COUNTING }
+#define BENCH_COUNTING_TYPED_ALGORITHM(name, func) \
+	{ name, BENCH_TYPED, BENCH_INT, NULL, NULL, NULL, func, BENCH_MAXN_UNLIMITED, \
+	  BENCH_RANGE_COUNTING }
+
+static const struct BenchAlgorithm bench_ALGORITHMS[] = {
+	BENCH_ARRAY_ALGORITHM ("selectionsort", selectionsort_sort, BENCH_INT, BENCH_MAXN_QUADRATIC),
+	BENCH_ARRAY_ALGORITHM ("selectionsort_min_max", selectionsort_min_max_sort, BENCH_INT,
+						   BENCH_MAXN_QUADRATIC),
+	BENCH_ARRAY_ALGORITHM ("bubblesort", bubblesort_sort, BENCH_INT, BENCH_MAXN_QUADRATIC),
+	BENCH_ARRAY_ALGORITHM ("insertionsort", insertionsort_sort, BENCH_INT, BENCH_MAXN_QUADRATIC),
+	BENCH_ARRAY_ALGORITHM ("combsort", combsort_sort, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("shellsort", shellsort_sort, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("quicksort", quicksort_sort, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("quicksort_parallel", bench_quicksort_parallel, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("twayquicksort", twayquicksort_sort, BENCH_INT, BENCH_MAXN_QUADRATIC),
+	BENCH_ARRAY_ALGORITHM ("mergesort", mergesort_sort, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("mergesort_parallel", bench_mergesort_parallel, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("heapsort", heapsort_sort, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("timsort", timsort_sort, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("introsort", introsort_sort, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("pdqsort", pdqsort_sort, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("sort_auto", bench_sort_auto, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("sort_auto_key32", bench_sort_auto_key32, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("samplesort", samplesort_sort, BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("samplesort_parallel", bench_samplesort_parallel, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("treesort", treesort_sort, BENCH_INT, BENCH_MAXN_QUADRATIC),
+	BENCH_ARRAY_ALGORITHM ("bucketsort_ints", bucketsort_sort_ints, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("bucketsort_ints_parallel", bench_bucketsort_ints_parallel,
+						   BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("bucketsort_floats", bucketsort_sort_floats, BENCH_FLOAT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("bucketsort_floats_parallel", bench_bucketsort_floats_parallel,
+						   BENCH_FLOAT, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("bucketsort_doubles", bucketsort_sort_doubles, BENCH_DOUBLE,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("bucketsort_doubles_parallel", bench_bucketsort_doubles_parallel,
+						   BENCH_DOUBLE, BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("bucketsort_sampled", bench_bucketsort_sampled, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("bucketsort_sampled_parallel", bench_bucketsort_sampled_parallel,
+						   BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_COUNTING_ARRAY_ALGORITHM ("countingsort_items", bench_countingsort_items),
+	BENCH_COUNTING_ARRAY_ALGORITHM ("countingsort_items_parallel",
+									bench_countingsort_items_parallel),
+	BENCH_ARRAY_ALGORITHM ("radixsortkey_u32", bench_radixsortkey_u32, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("radixsortlsd_floats", bench_radixsortlsd_floats, BENCH_FLOAT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_ARRAY_ALGORITHM ("radixsortlsd_doubles", bench_radixsortlsd_doubles, BENCH_DOUBLE,
+						   BENCH_MAXN_UNLIMITED),
+
+	BENCH_LIST_ALGORITHM ("bubblesortll", bubblesortll_sort, BENCH_MAXN_QUADRATIC),
+	BENCH_LIST_ALGORITHM ("insertionsortll", insertionsortll_sort, BENCH_MAXN_QUADRATIC),
+	BENCH_LIST_ALGORITHM ("quicksortll", quicksortll_sort, BENCH_MAXN_QUADRATIC),
+	BENCH_LIST_ALGORITHM ("mergesortll", mergesortll_sort, BENCH_MAXN_UNLIMITED),
+	BENCH_LIST_ALGORITHM ("mergesortll_it_merge", mergesortll_sort_with_it_merge,
+						  BENCH_MAXN_UNLIMITED),
+
+	BENCH_VALUES_ALGORITHM ("insertionsort_values", insertionsort_sort_values,
+							BENCH_MAXN_QUADRATIC),
+	BENCH_VALUES_ALGORITHM ("quicksort_values", quicksort_sort_values, BENCH_MAXN_UNLIMITED),
+	BENCH_VALUES_ALGORITHM ("mergesort_values", mergesort_sort_values, BENCH_MAXN_UNLIMITED),
+	BENCH_VALUES_ALGORITHM ("timsort_values", timsort_sort_values, BENCH_MAXN_UNLIMITED),
+	BENCH_VALUES_ALGORITHM ("heapsort_values", heapsort_sort_values, BENCH_MAXN_UNLIMITED),
+	BENCH_VALUES_ALGORITHM ("introsort_values", introsort_sort_values, BENCH_MAXN_UNLIMITED),
+
+	BENCH_COUNTING_TYPED_ALGORITHM ("countingsort", bench_countingsort),
+	BENCH_COUNTING_TYPED_ALGORITHM ("countingsort_parallel", bench_countingsort_parallel),
+	BENCH_COUNTING_TYPED_ALGORITHM ("countingsort_copy", bench_countingsort_copy),
+	BENCH_COUNTING_TYPED_ALGORITHM ("countingsort_records", bench_countingsort_records),
+	BENCH_TYPED_ALGORITHM ("radixsortlsd_ints", bench_radixsortlsd_ints, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("radixsortlsd_i64", bench_radixsortlsd_i64, BENCH_INT64,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("radixsortlsd_float", bench_radixsortlsd_float, BENCH_FLOAT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("radixsortlsd_double", bench_radixsortlsd_double, BENCH_DOUBLE,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("radixsortmsd_ints", bench_radixsortmsd_ints, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("radixsortmsd_i64", bench_radixsortmsd_i64, BENCH_INT64,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("radixsortstr", bench_radixsortstr, BENCH_STRING,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("radixsortstr_mkqsort", bench_radixsortstr_mkqsort, BENCH_STRING,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("samplesort_i32", bench_samplesort_i32, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("samplesort_i32_parallel", bench_samplesort_i32_parallel,
+						   BENCH_INT, BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("samplesort_i64", bench_samplesort_i64, BENCH_INT64,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("samplesort_float", bench_samplesort_float, BENCH_FLOAT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("samplesort_double", bench_samplesort_double, BENCH_DOUBLE,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("sort_int_introsort", bench_sort_int_introsort, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("sort_int_mergesort", bench_sort_int_mergesort, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("sort_int_timsort", bench_sort_int_timsort, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("sort_int_heapsort", bench_sort_int_heapsort, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("sort_double_introsort", bench_sort_double_introsort, BENCH_DOUBLE,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("argsort_radix_i32", bench_argsort_radix_i32, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("argsort_stable", bench_argsort_stable, BENCH_INT,
+						   BENCH_MAXN_UNLIMITED),
+	BENCH_TYPED_ALGORITHM ("kvsort_i32", bench_kvsort_i32, BENCH_INT, BENCH_MAXN_UNLIMITED)
+};
+
+static const int bench_NALGORITHMS = sizeof (bench_ALGORITHMS) / sizeof (bench_ALGORITHMS[0]);
+
+
+/*
+ * Options of the benchmark.
+ */
+struct BenchOptions {
+	size_t sizes[32];
+	int nsizes;
+	size_t minsize;
+	size_t maxsize;
+	int reps;
+	const char* algos;
+	const char* dists;
+	uint64_t seed;
+	double maxseconds;
+	const char* csvfile;
+	const char* jsonfile;
+	int stats;
+	int perf;
+	int list;
+};
+
+
+/*
+ * Returns the time of the monotonic clock in nanoseconds.
+ */
+static double bench_now (void)
+{
+	struct timespec t;
+	clock_gettime (CLOCK_MONOTONIC, &t);
+	return (double)t.tv_sec * 1e9 + (double)t.tv_nsec;
+}
+
+/*
+ * Returns a buffer of 'n' bytes or aborts if it can't be allocated.
+ */
+static void* bench_alloc (const size_t n)
+{
+	void* buf = malloc ((n > 0) ? n : 1);
+	if (buf == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for benchmark.");
+		abort ();
+	}
+	return buf;
+}
+
+/*
+ * Returns 1 if 'name' contains one of the comma separated strings of 'filter'
+ * (or is equal to one if 'exact'), or if 'filter' is NULL.
+ */
+static int bench_matches (const char* name, const char* filter, const int exact)
+{
+	if (filter == NULL)
+		return 1;
+
+	const char* s = filter;
+	while (*s != '\0') {
+		size_t len = strcspn (s, ",");
+		if (len > 0) {
+			if (exact) {
+				if ((strlen (name) == len) && (strncmp (name, s, len) == 0))
+					return 1;
+			}
+			else {
+				for (const char* p = name; *p != '\0'; p++)
+					if (strncmp (p, s, len) == 0)
+						return 1;
+			}
+		}
+		s += len;
+		if (*s == ',')
+			s++;
+	}
+	return 0;
+}
+
+
+/*
+ * Input of a case: the ints of the distribution converted to the type of the
+ * algorithm ('elems', 'n' elements) and the copies sorted by a repetition
+ * ('copies', 'batch' copies of 'n' elements or pointers).
+ */
+struct BenchInput {
+	const int* ints;
+	size_t n;
+	size_t batch;
+	int type;
+	void* elems;
+	char* strings;
+	void* copies;
+	struct LinkedList** lists;
+	SortCompareFunc cmp;
+};
+
+/*
+ * Converts the ints of the input to its type.
+ */
+static void bench_convert (struct BenchInput* in)
+{
+	const size_t n = in->n;
+	in->elems = bench_alloc (n * bench_type_size (in->type));
+	in->strings = NULL;
+
+	switch (in->type) {
+	case BENCH_INT64:
+		for (size_t i = 0; i < n; i++)
+			((int64_t*)in->elems)[i] = (int64_t)in->ints[i] * 1000003;
+		break;
+	case BENCH_FLOAT:
+		for (size_t i = 0; i < n; i++)
+			((float*)in->elems)[i] = (float)in->ints[i] / 1024.0f;
+		break;
+	case BENCH_DOUBLE:
+		for (size_t i = 0; i < n; i++)
+			((double*)in->elems)[i] = (double)in->ints[i] / 1024.0;
+		break;
+	case BENCH_STRING:
+		in->strings = bench_alloc (n * BENCH_STRING_SIZE);
+		for (size_t i = 0; i < n; i++) {
+			char* s = in->strings + i * BENCH_STRING_SIZE;
+			snprintf (s, BENCH_STRING_SIZE, "%d", in->ints[i]);
+			((char**)in->elems)[i] = s;
+		}
+		break;
+	default:
+		memcpy (in->elems, in->ints, n * sizeof (int));
+		break;
+	}
+}
+
+/*
+ * Prepares the copies of the input sorted by one repetition.
+ */
+static void bench_prepare (struct BenchInput* in, const struct BenchAlgorithm* alg)
+{
+	const size_t n = in->n;
+	const size_t size = bench_type_size (in->type);
+
+	if (alg->layout == BENCH_ARRAY) {
+		void** ptrs = in->copies;
+		char* e = in->elems;
+		for (size_t i = 0; i < n; i++)
+			ptrs[i] = (in->type == BENCH_STRING) ? ((char**)in->elems)[i] : e + i * size;
+		for (size_t b = 1; b < in->batch; b++)
+			memcpy (ptrs + b * n, ptrs, n * sizeof (void*));
+	}
+	else if (alg->layout == BENCH_LIST) {
+		for (size_t b = 0; b < in->batch; b++) {
+			in->lists[b] = linkedlist_create (NULL, NULL);
+			for (size_t i = 0; i < n; i++)
+				linkedlist_append (in->lists[b], (void*)&((int*)in->elems)[i]);
+		}
+	}
+	else {
+		for (size_t b = 0; b < in->batch; b++)
+			memcpy ((char*)in->copies + b * n * size, in->elems, n * size);
+	}
+}
+
+/*
+ * Runs the sort of all the copies of a repetition.
+ */
+static void bench_run (struct BenchInput* in, const struct BenchAlgorithm* alg)
+{
+	const size_t n = in->n;
+	const int to = (int)n - 1;
+	SortCompareFunc cmp = in->cmp;
+
+	for (size_t b = 0; b < in->batch; b++) {
+		switch (alg->layout) {
+		case BENCH_ARRAY:
+			alg->arrayfunc ((void**)in->copies + b * n, 0, to, cmp);
+			break;
+		case BENCH_LIST:
+			alg->listfunc (in->lists[b], cmp);
+			break;
+		case BENCH_VALUES:
+			alg->valuesfunc ((int*)in->copies + b * n, n, sizeof (int), cmp);
+			break;
+		default:
+			alg->typedfunc ((char*)in->copies + b * n * bench_type_size (in->type), 0, to);
+			break;
+		}
+	}
+}
+
+/*
+ * Checks that all the copies are sorted and releases the linked lists.
+ * Returns 1 if they are.
+ */
+static int bench_check (struct BenchInput* in, const struct BenchAlgorithm* alg)
+{
+	const size_t n = in->n;
+	const size_t size = bench_type_size (in->type);
+	SortCompareFunc cmp = bench_comparefunc (in->type);
+	int ok = 1;
+
+	for (size_t b = 0; b < in->batch; b++) {
+		if (alg->layout == BENCH_ARRAY) {
+			void** ptrs = (void**)in->copies + b * n;
+			for (size_t i = 1; ok && (i < n); i++)
+				ok = cmp (ptrs[i - 1], ptrs[i]) <= 0;
+		}
+		else if (alg->layout == BENCH_LIST) {
+			struct LinkedListNode* node = linkedlist_getfirst (in->lists[b]);
+			ok = ok && (in->lists[b]->size == n);
+			while (ok && (node != NULL) && (node->next != NULL)) {
+				ok = cmp (node->data, node->next->data) <= 0;
+				node = node->next;
+			}
+			linkedlist_destroy (in->lists[b]);
+		}
+		else {
+			char* e = (char*)in->copies + b * n * size;
+			for (size_t i = 1; ok && (i < n); i++) {
+				if (in->type == BENCH_STRING)
+					ok = strcmp (((char**)e)[i - 1], ((char**)e)[i]) <= 0;
+				else
+					ok = cmp (e + (i - 1) * size, e + i * size) <= 0;
+			}
+		}
+	}
+
+	return ok;
+}
+
+/*
+ * Returns the percentile 'p' (0..1) of sorted samples[0..k-1], interpolated.
+ */
+static double bench_percentile (const double samples[], const int k, const double p)
+{
+	double pos = p * (double)(k - 1);
+	int i = (int)pos;
+	if (i >= k - 1)
+		return samples[k - 1];
+	return samples[i] + (samples[i + 1] - samples[i]) * (pos - (double)i);
+}
+
+/*
+ * Compares doubles for 'qsort ()'.
+ */
+static int bench_compare_samples (const void* a, const void* b)
+{
+	return bench_compare_doubles (a, b);
+}
+
+/*
+ * Runs 'reps' repetitions of algorithm 'alg' on the ints[0..n-1] of a distribution.
+ * The counters 'perf' (if not NULL) count the timed sorts.
+ */
+static struct BenchResult bench_case (const struct BenchAlgorithm* alg, const int ints[],
+									  const size_t n, const int reps, const int stats,
+									  struct BenchPerf* perf)
+{
+	struct BenchResult r;
+	struct BenchInput in;
+	double* samples = bench_alloc ((size_t)reps * sizeof (double));
+	double counts[BENCHPERF_COUNT] = { 0 };
+
+	in.ints = ints;
+	in.n = n;
+	in.type = alg->type;
+	in.batch = (n >= bench_BATCH_ELEMENTS) ? 1 : bench_BATCH_ELEMENTS / n;
+	in.cmp = bench_comparefunc (in.type);
+	bench_convert (&in);
+
+	const size_t elemsize = (alg->layout == BENCH_ARRAY) ? sizeof (void*)
+														 : bench_type_size (in.type);
+	in.copies = bench_alloc (in.batch * n * elemsize);
+	in.lists = bench_alloc (in.batch * sizeof (struct LinkedList*));
+
+	r.algorithm = alg->name;
+	r.n = n;
+	r.reps = reps;
+	r.batch = in.batch;
+	r.ok = 1;
+	memset (&r.stats, 0, sizeof (r.stats));
+
+	for (int rep = 0; rep < reps; rep++) {
+		bench_prepare (&in, alg);
+		if (perf != NULL)
+			benchperf_start (perf);
+		double start = bench_now ();
+		bench_run (&in, alg);
+		samples[rep] = (bench_now () - start) / (double)in.batch;
+		if (perf != NULL)
+			benchperf_stop (perf, counts);
+		if (!bench_check (&in, alg))
+			r.ok = 0;
+	}
+
+	qsort (samples, (size_t)reps, sizeof (double), bench_compare_samples);
+
+	double sum = 0;
+	for (int rep = 0; rep < reps; rep++)
+		sum += samples[rep];
+
+	r.min = samples[0];
+	r.p10 = bench_percentile (samples, reps, 0.10);
+	r.median = bench_percentile (samples, reps, 0.50);
+	r.p90 = bench_percentile (samples, reps, 0.90);
+	r.p99 = bench_percentile (samples, reps, 0.99);
+	r.max = samples[reps - 1];
+	r.mean = sum / (double)reps;
+
+	for (int c = 0; c < BENCHPERF_COUNT; c++)
+		r.perf[c] = ((perf != NULL) && benchperf_available (perf, c))
+						? counts[c] / ((double)reps * (double)in.batch) : NAN;
+
+	// Counts of a single untimed sort
+	if (stats) {
+		const size_t batch = in.batch;
+		in.batch = 1;
+		in.cmp = sortstats_counting_compare (in.cmp);
+		bench_prepare (&in, alg);
+		sortstats_reset ();
+		bench_run (&in, alg);
+		sortstats_get (&r.stats);
+		if (!bench_check (&in, alg))
+			r.ok = 0;
+		in.batch = batch;
+	}
+
+	free (in.lists);
+	free (in.copies);
+	free (in.strings);
+	free (in.elems);
+	free (samples);
+	return r;
+}
+
+
+/*
+ * Writes the results as CSV, one line per case.
+ */
+static void bench_write_csv (const char* filename, const struct BenchResult results[],
+							 const int nresults, const int stats, const int perf)
+{
+	FILE* f = fopen (filename, "w");
+	if (f == NULL) {
+		fprintf (stderr, "Error: can't open '%s' for writing.\n", filename);
+		return;
+	}
+
+	fprintf (f, "algorithm,distribution,n,reps,batch,min_ns,p10_ns,median_ns,p90_ns,"
+				"p99_ns,max_ns,mean_ns,ns_per_elem,ok%s",
+			 stats ? ",comparisons,swaps,moves,allocations,peak_aux_bytes" : "");
+	if (perf)
+		for (int c = 0; c < BENCHPERF_COUNT; c++)
+			fprintf (f, ",%s", benchperf_name (c));
+	fprintf (f, "\n");
+	for (int i = 0; i < nresults; i++) {
+		const struct BenchResult* r = &results[i];
+		fprintf (f, "%s,%s,%zu,%d,%zu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.3f,%d",
+				 r->algorithm, r->distribution, r->n, r->reps, r->batch, r->min, r->p10,
+				 r->median, r->p90, r->p99, r->max, r->mean, r->median / (double)r->n,
+				 r->ok);
+		if (stats)
+			fprintf (f, ",%llu,%llu,%llu,%llu,%zu", (unsigned long long)r->stats.comparisons,
+					 (unsigned long long)r->stats.swaps, (unsigned long long)r->stats.moves,
+					 (unsigned long long)r->stats.allocations, r->stats.peak_aux_bytes);
+		if (perf)
+			for (int c = 0; c < BENCHPERF_COUNT; c++) {
+				if (isnan (r->perf[c]))
+					fprintf (f, ",");
+				else
+					fprintf (f, ",%.0f", r->perf[c]);
+			}
+		fprintf (f, "\n");
+	}
+
+	fclose (f);
+}
+
+/*
+ * Writes the results as JSON, an object with the options and an array of cases.
+ */
+static void bench_write_json (const char* filename, const struct BenchResult results[],
+							  const int nresults, const struct BenchOptions* opts)
+{
+	FILE* f = fopen (filename, "w");
+	if (f == NULL) {
+		fprintf (stderr, "Error: can't open '%s' for writing.\n", filename);
+		return;
+	}
+
+	fprintf (f, "{\n  \"seed\": %llu,\n  \"reps\": %d,\n  \"threads\": %d,\n"
+				"  \"results\": [\n", (unsigned long long)opts->seed, opts->reps,
+				bench_nthreads);
+	for (int i = 0; i < nresults; i++) {
+		const struct BenchResult* r = &results[i];
+		fprintf (f, "    {\"algorithm\": \"%s\", \"distribution\": \"%s\", \"n\": %zu, "
+					"\"reps\": %d, \"batch\": %zu, \"min_ns\": %.1f, \"p10_ns\": %.1f, "
+					"\"median_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, "
+					"\"max_ns\": %.1f, \"mean_ns\": %.1f, \"ns_per_elem\": %.3f, ",
+				 r->algorithm, r->distribution, r->n, r->reps, r->batch, r->min, r->p10,
+				 r->median, r->p90, r->p99, r->max, r->mean, r->median / (double)r->n);
+		if (opts->stats)
+			fprintf (f, "\"comparisons\": %llu, \"swaps\": %llu, \"moves\": %llu, "
+						"\"allocations\": %llu, \"peak_aux_bytes\": %zu, ",
+					 (unsigned long long)r->stats.comparisons,
+					 (unsigned long long)r->stats.swaps, (unsigned long long)r->stats.moves,
+					 (unsigned long long)r->stats.allocations, r->stats.peak_aux_bytes);
+		if (opts->perf)
+			for (int c = 0; c < BENCHPERF_COUNT; c++) {
+				if (isnan (r->perf[c]))
+					fprintf (f, "\"%s\": null, ", benchperf_name (c));
+				else
+					fprintf (f, "\"%s\": %.0f, ", benchperf_name (c), r->perf[c]);
+			}
+		fprintf (f, "\"ok\": %s}%s\n", r->ok ? "true" : "false",
+				 (i < nresults - 1) ? "," : "");
+	}
+	fprintf (f, "  ]\n}\n");
+
+	fclose (f);
+}
+
+
+/*
+ * Prints the usage of the benchmark.
+ */
+static void bench_usage (void)
+{
+	printf ("Usage: libcsorting-bench [options]\n\n"
+			"  --sizes=n1,n2,...  sizes to run (default: powers of 10 from min to max size)\n"
+			"  --min-size=n       smallest size (default 10)\n"
+			"  --max-size=n       biggest size (default 1000000, up to 100000000)\n"
+			"  --reps=n           repetitions of each case (default 5)\n"
+			"  --algo=a1,a2,...   only algorithms whose name contains one of the strings\n"
+			"  --dist=d1,d2,...   only these distributions\n"
+			"  --threads=n        threads of the parallel sorts (default 0: processors)\n"
+			"  --seed=n           seed of the random inputs (default 1)\n"
+			"  --max-seconds=s    time of a sort before bigger sizes are skipped (default 1)\n"
+			"  --csv=file         write the results as CSV\n"
+			"  --json=file        write the results as JSON\n"
+			"  --stats            count comparisons, swaps, moves and memory of a sort\n"
+			"  --perf             count cycles, instructions, cache and branch misses\n"
+			"  --list             list the algorithms and distributions\n");
+}
+
+/*
+ * Parses the command line options. Returns 0 on error.
+ */
+static int bench_parse (const int argc, char* argv[], struct BenchOptions* opts)
+{
+	memset (opts, 0, sizeof (*opts));
+	opts->minsize = 10;
+	opts->maxsize = 1000000;
+	opts->reps = 5;
+	opts->seed = 1;
+	opts->maxseconds = 1.0;
+
+	for (int i = 1; i < argc; i++) {
+		const char* a = argv[i];
+		const char* v = strchr (a, '=');
+		v = (v != NULL) ? v + 1 : "";
+
+		if (strncmp (a, "--sizes=", 8) == 0) {
+			char* end = (char*)v;
+			while ((*end != '\0') && (opts->nsizes < 32)) {
+				opts->sizes[opts->nsizes++] = (size_t)strtod (end, &end);
+				if (*end == ',')
+					end++;
+				else if (*end != '\0')
+					return 0;
+			}
+		}
+		else if (strncmp (a, "--min-size=", 11) == 0)
+			opts->minsize = (size_t)strtod (v, NULL);
+		else if (strncmp (a, "--max-size=", 11) == 0)
+			opts->maxsize = (size_t)strtod (v, NULL);
+		else if (strncmp (a, "--reps=", 7) == 0)
+			opts->reps = atoi (v);
+		else if (strncmp (a, "--algo=", 7) == 0)
+			opts->algos = v;
+		else if (strncmp (a, "--dist=", 7) == 0)
+			opts->dists = v;
+		else if (strncmp (a, "--threads=", 10) == 0)
+			bench_nthreads = atoi (v);
+		else if (strncmp (a, "--seed=", 7) == 0)
+			opts->seed = strtoull (v, NULL, 10);
+		else if (strncmp (a, "--max-seconds=", 14) == 0)
+			opts->maxseconds = strtod (v, NULL);
+		else if (strncmp (a, "--csv=", 6) == 0)
+			opts->csvfile = v;
+		else if (strncmp (a, "--json=", 7) == 0)
+			opts->jsonfile = v;
+		else if (strcmp (a, "--stats") == 0)
+			opts->stats = 1;
+		else if (strcmp (a, "--perf") == 0)
+			opts->perf = 1;
+		else if (strcmp (a, "--list") == 0)
+			opts->list = 1;
+		else
+			return 0;
+	}
+
+	if (opts->nsizes == 0)
+		for (size_t n = opts->minsize; (n > 0) && (n <= opts->maxsize) && (opts->nsizes < 32);
+			 n *= 10)
+			opts->sizes[opts->nsizes++] = n;
+
+	for (int s = 0; s < opts->nsizes; s++)
+		if ((opts->sizes[s] < 1) || (opts->sizes[s] > BENCH_MAXN_UNLIMITED))
+			return 0;
+
+	return opts->reps > 0;
+}
+
+/*
+ * Prints the counters of a case as columns of the table: cycles, L1 data and last
+ * level cache misses per element, instructions per cycle and branch misses per
+ * branch.
+ */
+static void bench_print_perf (const struct BenchResult* r)
+{
+	const double n = (double)r->n;
+	const double values[5] = {
+		r->perf[BENCHPERF_CYCLES] / n,
+		r->perf[BENCHPERF_INSTRUCTIONS] / r->perf[BENCHPERF_CYCLES],
+		r->perf[BENCHPERF_L1D_MISSES] / n,
+		r->perf[BENCHPERF_LLC_MISSES] / n,
+		100.0 * r->perf[BENCHPERF_BRANCH_MISSES] / r->perf[BENCHPERF_BRANCHES]
+	};
+	const int widths[5] = { 10, 6, 10, 10, 8 };
+
+	for (int i = 0; i < 5; i++) {
+		if (isnan (values[i]) || isinf (values[i]))
+			printf (" %*s", widths[i], "n/a");
+		else
+			printf (" %*.2f", widths[i], values[i]);
+	}
+}
+
+/*
+ * Lists the algorithms and the distributions.
+ */
+static void bench_list (void)
+{
+	printf ("Algorithms:\n");
+	for (int a = 0; a < bench_NALGORITHMS; a++)
+		printf ("  %s\n", bench_ALGORITHMS[a].name);
+	printf ("\nDistributions:\n");
+	for (int d = 0; d < BENCHINPUT_COUNT; d++)
+		printf ("  %s\n", benchinput_name (d));
+}
+
+int main (int argc, char* argv[])
+{
+	struct BenchOptions opts;
+
+	if (!bench_parse (argc, argv, &opts)) {
+		bench_usage ();
+		return 2;
+	}
+	if (opts.list) {
+		bench_list ();
+		return 0;
+	}
+
+	// An algorithm is skipped on a distribution once a sort took too long
+	char skip[sizeof (bench_ALGORITHMS) / sizeof (bench_ALGORITHMS[0])][BENCHINPUT_COUNT];
+	memset (skip, 0, sizeof (skip));
+
+	int capacity = 256;
+	int nresults = 0;
+	int failures = 0;
+	struct BenchResult* results = bench_alloc ((size_t)capacity * sizeof (*results));
+
+	// Counters of the calling thread and of the threads it creates
+	struct BenchPerf perf;
+	struct BenchPerf* perfp = NULL;
+	if (opts.perf) {
+		perfp = &perf;
+		if (benchperf_open (&perf) == 0)
+			fprintf (stderr, "Warning: no hardware performance counter is available (%s), "
+							 "they are reported as n/a. Check "
+							 "/proc/sys/kernel/perf_event_paranoid.\n",
+					 strerror (perf.error[0]));
+		else
+			for (int c = 0; c < BENCHPERF_COUNT; c++)
+				if (!benchperf_available (&perf, c))
+					fprintf (stderr, "Warning: counter %s is not available (%s).\n",
+							 benchperf_name (c), strerror (perf.error[c]));
+	}
+
+	printf ("%-30s %-10s %10s %5s %14s %10s %14s %14s %4s", "algorithm", "dist", "n",
+			"reps", "median_ns", "ns/elem", "p10_ns", "p90_ns", "ok");
+	if (opts.stats)
+		printf (" %14s %12s %14s %6s %14s", "comparisons", "swaps", "moves", "allocs",
+				"peak_aux");
+	if (opts.perf)
+		printf (" %10s %6s %10s %10s %8s", "cyc/elem", "ipc", "l1d/elem", "llc/elem",
+				"brmiss%");
+	printf ("\n");
+
+	for (int s = 0; s < opts.nsizes; s++) {
+		const size_t n = opts.sizes[s];
+		int* ints = bench_alloc (n * sizeof (int));
+
+		for (int d = 0; d < BENCHINPUT_COUNT; d++) {
+			if (!bench_matches (benchinput_name (d), opts.dists, 1))
+				continue;
+
+			benchinput_fill (ints, n, d, opts.seed);
+
+			int minkey = ints[0];
+			int maxkey = ints[0];
+			for (size_t i = 1; i < n; i++) {
+				if (ints[i] < minkey)
+					minkey = ints[i];
+				if (ints[i] > maxkey)
+					maxkey = ints[i];
+			}
+			const uint64_t range = (uint64_t)((int64_t)maxkey - (int64_t)minkey);
+
+			for (int a = 0; a < bench_NALGORITHMS; a++) {
+				const struct BenchAlgorithm* alg = &bench_ALGORITHMS[a];
+				if (!bench_matches (alg->name, opts.algos, 0) || (n > alg->maxn) ||
+					(range > alg->maxrange) || skip[a][d])
+					continue;
+
+				struct BenchResult r = bench_case (alg, ints, n, opts.reps, opts.stats,
+													 perfp);
+				r.distribution = benchinput_name (d);
+
+				if (r.median > opts.maxseconds * 1e9)
+					skip[a][d] = 1;
+				if (!r.ok) {
+					failures++;
+					fprintf (stderr, "Error: %s did not sort %s input of %zu elements.\n",
+							 alg->name, r.distribution, n);
+				}
+
+				printf ("%-30s %-10s %10zu %5d %14.1f %10.3f %14.1f %14.1f %4s",
+						r.algorithm, r.distribution, r.n, r.reps, r.median,
+						r.median / (double)r.n, r.p10, r.p90, r.ok ? "yes" : "NO");
+				if (opts.stats)
+					printf (" %14llu %12llu %14llu %6llu %14zu",
+							(unsigned long long)r.stats.comparisons,
+							(unsigned long long)r.stats.swaps,
+							(unsigned long long)r.stats.moves,
+							(unsigned long long)r.stats.allocations, r.stats.peak_aux_bytes);
+				if (opts.perf)
+					bench_print_perf (&r);
+				printf ("\n");
+				fflush (stdout);
+
+				if (nresults == capacity) {
+					capacity *= 2;
+					results = realloc (results, (size_t)capacity * sizeof (*results));
+					if (results == NULL) {
+						fprintf (stderr, "Error: failed to allocate memory for benchmark.");
+						abort ();
+					}
+				}
+				results[nresults++] = r;
+			}
+		}
+
+		free (ints);
+	}
+
+	if (opts.csvfile != NULL)
+		bench_write_csv (opts.csvfile, results, nresults, opts.stats, opts.perf);
+	if (opts.jsonfile != NULL)
+		bench_write_json (opts.jsonfile, results, nresults, &opts);
+
+	if (perfp != NULL)
+		benchperf_close (perfp);
+	free (results);
+	return (failures > 0) ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * benchinput.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements the input distributions of the benchmark.
+ *
+ * 	Random numbers come from a xorshift64* generator seeded by the caller, so the
+ * 	inputs don't depend on the C library 'rand ()'.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "benchinput.h"
+
+/*
+ * Names of the distributions.
+ */
+static const char* const benchinput_NAMES[BENCHINPUT_COUNT] = {
+	"random", "sorted", "reversed", "organpipe",
+	"fewunique", "zipf", "sawtooth", "perturbed"
+};
+
+/*
+ * Returns the next random number of the xorshift64* generator 'state'.
+ */
+static uint64_t benchinput_next (uint64_t* state)
+{
+	uint64_t x = *state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * UINT64_C (2685821657736338717);
+}
+
+/*
+ * Returns a random double in [0, 1).
+ */
+static double benchinput_uniform (uint64_t* state)
+{
+	return (double)(benchinput_next (state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*
+ * Returns the name of the distribution 'dist'.
+ */
+const char* benchinput_name (const int dist)
+{
+	if ((dist < 0) || (dist >= BENCHINPUT_COUNT))
+		return "unknown";
+	return benchinput_NAMES[dist];
+}
+
+/*
+ * Returns the number of the distribution named 'name' or -1 if there is none.
+ */
+int benchinput_find (const char* name)
+{
+	for (int d = 0; d < BENCHINPUT_COUNT; d++)
+		if (strcmp (name, benchinput_NAMES[d]) == 0)
+			return d;
+	return -1;
+}
+
+/*
+ * Fills arr[0..n-1] with the distribution 'dist'.
+ */
+void benchinput_fill (int arr[], const size_t n, const int dist, const uint64_t seed)
+{
+	// The generator state must not be 0
+	uint64_t state = seed * UINT64_C (0x9E3779B97F4A7C15) + 1;
+	const size_t run = (n + 15) / 16;
+
+	switch (dist) {
+	case 0:		// random
+		for (size_t i = 0; i < n; i++)
+			arr[i] = (int)(uint32_t)benchinput_next (&state);
+		break;
+
+	case 1:		// sorted
+		for (size_t i = 0; i < n; i++)
+			arr[i] = (int)i;
+		break;
+
+	case 2:		// reversed
+		for (size_t i = 0; i < n; i++)
+			arr[i] = (int)(n - 1 - i);
+		break;
+
+	case 3:		// organpipe
+		for (size_t i = 0; i < n; i++)
+			arr[i] = (int)((i < n / 2) ? i : n - 1 - i);
+		break;
+
+	case 4:		// fewunique
+		for (size_t i = 0; i < n; i++)
+			arr[i] = (int)(benchinput_next (&state) & 15);
+		break;
+
+	case 5:		// zipf, (n + 1)^u has density proportional to 1/x
+		for (size_t i = 0; i < n; i++)
+			arr[i] = (int)floor (pow ((double)n + 1.0, benchinput_uniform (&state)));
+		break;
+
+	case 6:		// sawtooth
+		for (size_t i = 0; i < n; i++)
+			arr[i] = (int)(i % run);
+		break;
+
+	case 7:		// perturbed
+		for (size_t i = 0; i < n; i++)
+			arr[i] = (int)i;
+		for (size_t k = 0; (n > 1) && (k < (n + 99) / 100); k++) {
+			size_t a = (size_t)(benchinput_next (&state) % n);
+			size_t b = (size_t)(benchinput_next (&state) % n);
+			int t = arr[a];
+			arr[a] = arr[b];
+			arr[b] = t;
+		}
+		break;
+
+	default:
+		memset (arr, 0, n * sizeof (int));
+		break;
+	}
+}
@@ -0,0 +1,47 @@
+/*
+ * benchinput.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the input distributions of the benchmark.
+ *
+ * 	Each distribution fills an array of ints, the same seed always gives the same
+ * 	array so runs can be compared.
+ */
+
+#ifndef BENCHINPUT_H_
+	#define BENCHINPUT_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+
+	/*
+	 * Number of input distributions, numbered 0..BENCHINPUT_COUNT-1.
+	 */
+	#define BENCHINPUT_COUNT 8
+
+	/*
+	 * Returns the name of the distribution 'dist'.
+	 */
+	const char* benchinput_name (const int dist);
+
+	/*
+	 * Returns the number of the distribution named 'name' or -1 if there is none.
+	 */
+	int benchinput_find (const char* name);
+
+	/*
+	 * Fills arr[0..n-1] with the distribution 'dist':
+	 *
+	 * 	random		uniform ints over the whole int range
+	 * 	sorted		0, 1, 2, ..., n-1
+	 * 	reversed	n-1, n-2, ..., 0
+	 * 	organpipe	ascending up to the middle, then descending
+	 * 	fewunique	uniform ints in 0..15
+	 * 	zipf		Zipf distribution (s = 1) of 1..n, small values are frequent
+	 * 	sawtooth	16 ascending runs of 0, 1, 2, ...
+	 * 	perturbed	sorted with 1% of the elements swapped with random positions
+	 */
+	void benchinput_fill (int arr[], const size_t n, const int dist, const uint64_t seed);
+
+#endif /* BENCHINPUT_H_ */
@@ -0,0 +1,172 @@
+/*
+ * benchperf.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements the hardware performance counters of the benchmark.
+ *
+ * 	The counters are opened with 'inherit', so the threads of the parallel sorts
+ * 	add to them. Counters inherited by threads can't be read as a group, so each one
+ * 	is read on its own, with the time it was enabled and running: when there are
+ * 	more counters than hardware registers the kernel multiplexes them and the value
+ * 	is scaled by enabled / running.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include "benchperf.h"
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+/*
+ * Names of the counters.
+ */
+static const char* const benchperf_NAMES[BENCHPERF_COUNT] = {
+	"cycles", "instructions", "l1d_misses", "llc_misses", "branches", "branch_misses"
+};
+
+/*
+ * Returns the name of counter 'counter'.
+ */
+const char* benchperf_name (const int counter)
+{
+	if ((counter < 0) || (counter >= BENCHPERF_COUNT))
+		return "unknown";
+	return benchperf_NAMES[counter];
+}
+
+#ifdef __linux__
+
+/*
+ * Type and configuration of each counter.
+ */
+static const struct {
+	uint32_t type;
+	uint64_t config;
+} benchperf_EVENTS[BENCHPERF_COUNT] = {
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+						  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+};
+
+/*
+ * Opens the counters of the calling thread. Returns the number of counters
+ * available.
+ */
+int benchperf_open (struct BenchPerf* perf)
+{
+	int count = 0;
+
+	for (int c = 0; c < BENCHPERF_COUNT; c++) {
+		struct perf_event_attr attr;
+		memset (&attr, 0, sizeof (attr));
+		attr.size = sizeof (attr);
+		attr.type = benchperf_EVENTS[c].type;
+		attr.config = benchperf_EVENTS[c].config;
+		attr.disabled = 1;
+		attr.inherit = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		perf->fd[c] = (int)syscall (SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		perf->error[c] = (perf->fd[c] < 0) ? errno : 0;
+		if (perf->fd[c] >= 0)
+			count++;
+	}
+
+	return count;
+}
+
+/*
+ * Closes the counters.
+ */
+void benchperf_close (struct BenchPerf* perf)
+{
+	for (int c = 0; c < BENCHPERF_COUNT; c++) {
+		if (perf->fd[c] >= 0)
+			close (perf->fd[c]);
+		perf->fd[c] = -1;
+	}
+}
+
+/*
+ * Clears and starts the counters.
+ */
+void benchperf_start (struct BenchPerf* perf)
+{
+	for (int c = 0; c < BENCHPERF_COUNT; c++) {
+		if (perf->fd[c] >= 0) {
+			ioctl (perf->fd[c], PERF_EVENT_IOC_RESET, 0);
+			ioctl (perf->fd[c], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+}
+
+/*
+ * Stops the counters and adds their values to values[0..BENCHPERF_COUNT-1].
+ */
+void benchperf_stop (struct BenchPerf* perf, double values[])
+{
+	for (int c = 0; c < BENCHPERF_COUNT; c++)
+		if (perf->fd[c] >= 0)
+			ioctl (perf->fd[c], PERF_EVENT_IOC_DISABLE, 0);
+
+	for (int c = 0; c < BENCHPERF_COUNT; c++) {
+		uint64_t data[3];	// value, time enabled, time running
+		if ((perf->fd[c] < 0) || (read (perf->fd[c], data, sizeof (data)) != sizeof (data)))
+			continue;
+		if (data[2] == 0)
+			continue;
+		values[c] += (double)data[0] * ((double)data[1] / (double)data[2]);
+	}
+}
+
+#else
+
+/*
+ * No counters on other systems.
+ */
+int benchperf_open (struct BenchPerf* perf)
+{
+	for (int c = 0; c < BENCHPERF_COUNT; c++) {
+		perf->fd[c] = -1;
+		perf->error[c] = ENOSYS;
+	}
+	return 0;
+}
+
+void benchperf_close (struct BenchPerf* perf)
+{
+	(void) perf;
+}
+
+void benchperf_start (struct BenchPerf* perf)
+{
+	(void) perf;
+}
+
+void benchperf_stop (struct BenchPerf* perf, double values[])
+{
+	(void) perf;
+	(void) values;
+}
+
+#endif
+
+/*
+ * Returns 1 if counter 'counter' is available.
+ */
+int benchperf_available (const struct BenchPerf* perf, const int counter)
+{
+	return perf->fd[counter] >= 0;
+}
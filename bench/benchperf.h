@@ -0,0 +1,71 @@
+/*
+ * benchperf.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the hardware performance counters of the benchmark
+ * 				(Linux perf_event_open).
+ *
+ * 	Each counter is opened on its own, so the counters the CPU, the kernel or the
+ * 	permissions (/proc/sys/kernel/perf_event_paranoid) don't allow are just missing.
+ * 	Only user space is counted, including the threads created by the parallel sorts
+ * 	while the counters are open. On other systems no counter is available.
+ */
+
+#ifndef BENCHPERF_H_
+	#define BENCHPERF_H_
+
+	#include <stdint.h>
+
+	/*
+	 * Counters, numbered 0..BENCHPERF_COUNT-1.
+	 */
+	#define BENCHPERF_CYCLES 0
+	#define BENCHPERF_INSTRUCTIONS 1
+	#define BENCHPERF_L1D_MISSES 2
+	#define BENCHPERF_LLC_MISSES 3
+	#define BENCHPERF_BRANCHES 4
+	#define BENCHPERF_BRANCH_MISSES 5
+	#define BENCHPERF_COUNT 6
+
+	/*
+	 * Open counters, -1 for the ones not available.
+	 */
+	struct BenchPerf {
+		int fd[BENCHPERF_COUNT];
+		int error[BENCHPERF_COUNT];		// errno of the counters not available
+	};
+
+	/*
+	 * Returns the name of counter 'counter'.
+	 */
+	const char* benchperf_name (const int counter);
+
+	/*
+	 * Opens the counters of the calling thread. Returns the number of counters
+	 * available.
+	 */
+	int benchperf_open (struct BenchPerf* perf);
+
+	/*
+	 * Returns 1 if counter 'counter' is available.
+	 */
+	int benchperf_available (const struct BenchPerf* perf, const int counter);
+
+	/*
+	 * Closes the counters.
+	 */
+	void benchperf_close (struct BenchPerf* perf);
+
+	/*
+	 * Clears and starts the counters.
+	 */
+	void benchperf_start (struct BenchPerf* perf);
+
+	/*
+	 * Stops the counters and adds their values to values[0..BENCHPERF_COUNT-1].
+	 * Values are scaled up when the kernel multiplexed the counters.
+	 */
+	void benchperf_stop (struct BenchPerf* perf, double values[]);
+
+#endif /* BENCHPERF_H_ */
@@ -0,0 +1,345 @@
+/*
+ * argsort.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements argsort, the sort of the indexes of an array, and the
+ * 				in place application of a permutation.
+ *
+ * About:
+ *
+ * 	Sorting a table by one of its columns needs the sort order of the column, so
+ * 	that the same order is applied to the other columns. Argsort computes that order
+ * 	as an array of indexes instead of moving the elements.
+ *
+ *
+ * Comparison argsort:
+ *
+ * 	An array of pointers to the elements is sorted with pattern-defeating quicksort
+ * 	(or timsort for the stable version), so the comparison function receives
+ * 	pointers to the elements as with 'qsort ()'. The index of each element is then
+ * 	computed from its address.
+ *
+ *
+ * Radix argsort:
+ *
+ * 	The order-preserving unsigned key of each element (see 'radixsortkey.h' and
+ * 	'radixsortlsd.h') is gathered with its index into an array of (key, index)
+ * 	pairs, that is sorted by the LSD radix sort (radix 256) of 'radixsortdef.h':
+ * 	histograms of all bytes in a single pass, passes where all keys have the same
+ * 	byte skipped and insertion sort for small arrays. The sort is stable.
+ *
+ *
+ * Applying a permutation:
+ *
+ * 	The permutation is a set of disjoint cycles. Each cycle is followed from its
+ * 	first index i: the element at i is saved, the element at idx[i] is moved to i,
+ * 	the element at idx[idx[i]] to idx[i], and so on until the cycle returns to i and
+ * 	the saved element is stored. Visited indexes are marked by flipping their bits
+ * 	(the indexes are never negative), and restored by a final pass.
+ *
+ *
+ * Time Complexity: O(n log n) comparisons, O(n * w) for the radix versions where w
+ * 					is the number of bytes of the key
+ *
+ * Auxiliary Space: O(n)
+ *
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argsort.h"
+#include "pdqsort.h"
+#include "timsort.h"
+#include "radixsortkey.h"
+#include "radixsortlsd.h"
+#include "radixsortdef.h"
+#include "sortstats.h"
+
+/*
+ * Returns a buffer of 'n' elements of 'size' bytes or aborts if it can't be allocated.
+ */
+static void* argsort_alloc (const size_t n, const size_t size)
+{
+	void* buf = sortstats_malloc (n * size);
+	if (buf == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for argsort buffer.");
+		abort ();
+	}
+	return buf;
+}
+
+/*
+ * Returns an array of pointers to the 'n' elements of 'size' bytes starting at
+ * 'base' sorted by 'comparefunc', stable if 'stable' is not 0.
+ */
+static void** argsort_sorted_pointers (const void* base, const size_t n,
+									   const size_t size, SortCompareFunc comparefunc,
+									   const int stable)
+{
+	if (n > (size_t)INT_MAX) {
+		fprintf (stderr, "Error: too many elements for comparison argsort.");
+		abort ();
+	}
+
+	void** ptrs = argsort_alloc (n, sizeof (void*));
+	const char* p = base;
+
+	for (size_t i = 0; i < n; i++)
+		ptrs[i] = (void*)(p + i * size);
+
+	if (stable)
+		timsort_sort (ptrs, 0, (int)n - 1, comparefunc);
+	else
+		pdqsort_sort (ptrs, 0, (int)n - 1, comparefunc);
+
+	return ptrs;
+}
+
+/*
+ * Defines the functions of index type 'itype':
+ *
+ * 	static void argsort_pointers_##suffix (base, n, size, comparefunc, stable, idx)
+ * 	static void argsort_apply_##suffix (base, n, size, idx)
+ */
+#define ARGSORT_DEFINE_INDEX_(suffix, itype) \
+	static void argsort_pointers_##suffix (const void* base, const size_t n, \
+										   const size_t size, SortCompareFunc comparefunc, \
+										   const int stable, itype idx[]) \
+	{ \
+		if (n == 0) \
+			return; \
+	\
+		void** ptrs = argsort_sorted_pointers (base, n, size, comparefunc, stable); \
+		const char* p = base; \
+	\
+		for (size_t i = 0; i < n; i++) \
+			idx[i] = (itype)((size_t)((const char*)ptrs[i] - p) / size); \
+	\
+		sortstats_free (ptrs); \
+	} \
+	\
+	static void argsort_apply_##suffix (void* base, const size_t n, const size_t size, \
+										itype idx[]) \
+	{ \
+		if ((n < 2) || (size == 0)) \
+			return; \
+	\
+		char* p = base; \
+		char* saved = argsort_alloc (1, size); \
+	\
+		for (size_t i = 0; i < n; i++) { \
+			/* Visited or fixed point */ \
+			if (idx[i] < 0) \
+				continue; \
+			if ((size_t)idx[i] == i) { \
+				idx[i] = ~idx[i]; \
+				continue; \
+			} \
+	\
+			memcpy (saved, p + i * size, size); \
+			SORTSTATS_MOVES (1); \
+			size_t j = i; \
+			for (;;) { \
+				size_t k = (size_t)idx[j]; \
+				idx[j] = ~idx[j]; \
+				if (k == i) { \
+					memcpy (p + j * size, saved, size); \
+					SORTSTATS_MOVES (1); \
+					break; \
+				} \
+				memcpy (p + j * size, p + k * size, size); \
+				SORTSTATS_MOVES (1); \
+				j = k; \
+			} \
+		} \
+	\
+		for (size_t i = 0; i < n; i++) \
+			idx[i] = ~idx[i]; \
+	\
+		sortstats_free (saved); \
+	}
+
+ARGSORT_DEFINE_INDEX_ (32, int32_t)
+ARGSORT_DEFINE_INDEX_ (64, int64_t)
+
+/*
+ * Defines 'static void name (const type keys[], n, itype idx[], flags)', the LSD
+ * radix argsort of 'keys' by the unsigned key 'key_expr' of 'ktype', an expression
+ * on the key 'x' and 'flags'.
+ */
+#define ARGSORT_DEFINE_RADIX_(name, type, ktype, itype, key_expr) \
+	struct name##_Pair { \
+		ktype key; \
+		itype index; \
+	}; \
+	\
+	RADIXSORT_DEFINE_LSD_KEY (name##_lsd, struct name##_Pair, ktype, e->key) \
+	\
+	static void name (const type keys[], const size_t n, itype idx[], const int flags) \
+	{ \
+		(void) flags; \
+		if (n < 2) { \
+			if (n == 1) \
+				idx[0] = 0; \
+			return; \
+		} \
+	\
+		struct name##_Pair* pairs = argsort_alloc (2 * n, sizeof (*pairs)); \
+	\
+		for (size_t i = 0; i < n; i++) { \
+			type x = keys[i]; \
+			pairs[i].key = (key_expr); \
+			pairs[i].index = (itype)i; \
+		} \
+	\
+		struct name##_Pair* src = name##_lsd (pairs, pairs + n, n); \
+	\
+		for (size_t i = 0; i < n; i++) \
+			idx[i] = src[i].index; \
+		SORTSTATS_MOVES (2 * n);		/* to the pairs and the indexes */ \
+	\
+		sortstats_free (pairs); \
+	}
+
+/*
+ * Defines the radix argsorts of 'type' with 32 and 64 bits indexes.
+ */
+#define ARGSORT_DEFINE_RADIX_KEYS_(suffix, type, ktype, key_expr) \
+	ARGSORT_DEFINE_RADIX_ (argsort_radix_##suffix##_idx32, type, ktype, int32_t, key_expr) \
+	ARGSORT_DEFINE_RADIX_ (argsort_radix_##suffix##_idx64, type, ktype, int64_t, key_expr)
+
+ARGSORT_DEFINE_RADIX_KEYS_ (i32, int32_t, uint32_t, radixsortkey_key_i32 (x))
+ARGSORT_DEFINE_RADIX_KEYS_ (u32, uint32_t, uint32_t, x)
+ARGSORT_DEFINE_RADIX_KEYS_ (i64, int64_t, uint64_t, radixsortkey_key_i64 (x))
+ARGSORT_DEFINE_RADIX_KEYS_ (u64, uint64_t, uint64_t, x)
+ARGSORT_DEFINE_RADIX_KEYS_ (float, float, uint32_t, radixsortlsd_key_float (x, flags))
+ARGSORT_DEFINE_RADIX_KEYS_ (double, double, uint64_t, radixsortlsd_key_double (x, flags))
+
+/*
+ * Fills idx[0..n-1] with the indexes of the 'n' contiguous elements of 'size'
+ * bytes each starting at 'base' in sorted order, using pattern-defeating
+ * quicksort (not stable).
+ * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+ */
+void argsort_sort (const void* base, const size_t n, const size_t size,
+				   SortCompareFunc comparefunc, int32_t idx[])
+{
+	argsort_pointers_32 (base, n, size, comparefunc, 0, idx);
+}
+
+void argsort_sort_64 (const void* base, const size_t n, const size_t size,
+					  SortCompareFunc comparefunc, int64_t idx[])
+{
+	argsort_pointers_64 (base, n, size, comparefunc, 0, idx);
+}
+
+/*
+ * Fills idx[0..n-1] with the indexes of the elements in sorted order, using
+ * timsort (stable: indexes of equal elements are in ascending order).
+ */
+void argsort_stable_sort (const void* base, const size_t n, const size_t size,
+						  SortCompareFunc comparefunc, int32_t idx[])
+{
+	argsort_pointers_32 (base, n, size, comparefunc, 1, idx);
+}
+
+void argsort_stable_sort_64 (const void* base, const size_t n, const size_t size,
+							 SortCompareFunc comparefunc, int64_t idx[])
+{
+	argsort_pointers_64 (base, n, size, comparefunc, 1, idx);
+}
+
+/*
+ * Fills idx[0..n-1] with the indexes of the keys in ascending order, using LSD
+ * radix sort of (key, index) pairs (stable).
+ * Uses a buffer of 2 * n pairs.
+ */
+void argsort_radix_i32 (const int32_t keys[], const size_t n, int32_t idx[])
+{
+	argsort_radix_i32_idx32 (keys, n, idx, 0);
+}
+
+void argsort_radix_i32_64 (const int32_t keys[], const size_t n, int64_t idx[])
+{
+	argsort_radix_i32_idx64 (keys, n, idx, 0);
+}
+
+void argsort_radix_u32 (const uint32_t keys[], const size_t n, int32_t idx[])
+{
+	argsort_radix_u32_idx32 (keys, n, idx, 0);
+}
+
+void argsort_radix_u32_64 (const uint32_t keys[], const size_t n, int64_t idx[])
+{
+	argsort_radix_u32_idx64 (keys, n, idx, 0);
+}
+
+void argsort_radix_i64 (const int64_t keys[], const size_t n, int32_t idx[])
+{
+	argsort_radix_i64_idx32 (keys, n, idx, 0);
+}
+
+void argsort_radix_i64_64 (const int64_t keys[], const size_t n, int64_t idx[])
+{
+	argsort_radix_i64_idx64 (keys, n, idx, 0);
+}
+
+void argsort_radix_u64 (const uint64_t keys[], const size_t n, int32_t idx[])
+{
+	argsort_radix_u64_idx32 (keys, n, idx, 0);
+}
+
+void argsort_radix_u64_64 (const uint64_t keys[], const size_t n, int64_t idx[])
+{
+	argsort_radix_u64_idx64 (keys, n, idx, 0);
+}
+
+/*
+ * Fills idx[0..n-1] with the indexes of the floats or doubles in ascending order,
+ * using LSD radix sort (stable). 'flags' are the flags of 'radixsortlsd_sort_float ()'
+ * (RADIXSORTLSD_NANS_FIRST, RADIXSORTLSD_ZEROS_EQUAL).
+ */
+void argsort_radix_float (const float keys[], const size_t n, int32_t idx[],
+						  const int flags)
+{
+	argsort_radix_float_idx32 (keys, n, idx, flags);
+}
+
+void argsort_radix_float_64 (const float keys[], const size_t n, int64_t idx[],
+							 const int flags)
+{
+	argsort_radix_float_idx64 (keys, n, idx, flags);
+}
+
+void argsort_radix_double (const double keys[], const size_t n, int32_t idx[],
+						   const int flags)
+{
+	argsort_radix_double_idx32 (keys, n, idx, flags);
+}
+
+void argsort_radix_double_64 (const double keys[], const size_t n, int64_t idx[],
+							  const int flags)
+{
+	argsort_radix_double_idx64 (keys, n, idx, flags);
+}
+
+/*
+ * Permutes in place the 'n' contiguous elements of 'size' bytes each starting at
+ * 'base' so that the element at i is the one that was at idx[i], following the
+ * cycles of the permutation. Each element is moved once.
+ * 'idx' is used to mark the visited indexes and is restored before returning.
+ */
+void argsort_apply_permutation (void* base, const size_t n, const size_t size,
+								int32_t idx[])
+{
+	argsort_apply_32 (base, n, size, idx);
+}
+
+void argsort_apply_permutation_64 (void* base, const size_t n, const size_t size,
+								   int64_t idx[])
+{
+	argsort_apply_64 (base, n, size, idx);
+}
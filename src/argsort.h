@@ -0,0 +1,85 @@
+/*
+ * argsort.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for argsort, the sort of the indexes of an array.
+ *
+ * 	Argsort fills idx[0..n-1] with the permutation of the indexes 0..n-1 that sorts
+ * 	the array, that is arr[idx[0]] <= arr[idx[1]] <= ... <= arr[idx[n-1]], and leaves
+ * 	the array untouched. The same permutation can then be applied to the array and to
+ * 	any number of parallel arrays with 'argsort_apply_permutation ()'.
+ *
+ * 	Every function has a version with 32 bits indexes and a version with 64 bits
+ * 	indexes (suffix _64). The radix versions of numeric keys are stable and sort
+ * 	arrays of any size, the comparison versions are limited to INT_MAX elements.
+ */
+
+#ifndef ARGSORT_H_
+	#define ARGSORT_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+	#include "sort.h"
+	#include "sortapi.h"
+
+	/*
+	 * Fills idx[0..n-1] with the indexes of the 'n' contiguous elements of 'size'
+	 * bytes each starting at 'base' in sorted order, using pattern-defeating
+	 * quicksort (not stable).
+	 * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+	 */
+	SORT_API void argsort_sort (const void* base, const size_t n, const size_t size,
+								SortCompareFunc comparefunc, int32_t idx[]);
+	SORT_API void argsort_sort_64 (const void* base, const size_t n, const size_t size,
+								   SortCompareFunc comparefunc, int64_t idx[]);
+
+	/*
+	 * Fills idx[0..n-1] with the indexes of the elements in sorted order, using
+	 * timsort (stable: indexes of equal elements are in ascending order).
+	 */
+	SORT_API void argsort_stable_sort (const void* base, const size_t n, const size_t size,
+									   SortCompareFunc comparefunc, int32_t idx[]);
+	SORT_API void argsort_stable_sort_64 (const void* base, const size_t n, const size_t size,
+										  SortCompareFunc comparefunc, int64_t idx[]);
+
+	/*
+	 * Fills idx[0..n-1] with the indexes of the keys in ascending order, using LSD
+	 * radix sort of (key, index) pairs (stable).
+	 * Uses a buffer of 2 * n pairs.
+	 */
+	SORT_API void argsort_radix_i32 (const int32_t keys[], const size_t n, int32_t idx[]);
+	SORT_API void argsort_radix_i32_64 (const int32_t keys[], const size_t n, int64_t idx[]);
+	SORT_API void argsort_radix_u32 (const uint32_t keys[], const size_t n, int32_t idx[]);
+	SORT_API void argsort_radix_u32_64 (const uint32_t keys[], const size_t n, int64_t idx[]);
+	SORT_API void argsort_radix_i64 (const int64_t keys[], const size_t n, int32_t idx[]);
+	SORT_API void argsort_radix_i64_64 (const int64_t keys[], const size_t n, int64_t idx[]);
+	SORT_API void argsort_radix_u64 (const uint64_t keys[], const size_t n, int32_t idx[]);
+	SORT_API void argsort_radix_u64_64 (const uint64_t keys[], const size_t n, int64_t idx[]);
+
+	/*
+	 * Fills idx[0..n-1] with the indexes of the floats or doubles in ascending order,
+	 * using LSD radix sort (stable). 'flags' are the flags of 'radixsortlsd_sort_float ()'
+	 * (RADIXSORTLSD_NANS_FIRST, RADIXSORTLSD_ZEROS_EQUAL).
+	 */
+	SORT_API void argsort_radix_float (const float keys[], const size_t n, int32_t idx[],
+									   const int flags);
+	SORT_API void argsort_radix_float_64 (const float keys[], const size_t n, int64_t idx[],
+										  const int flags);
+	SORT_API void argsort_radix_double (const double keys[], const size_t n, int32_t idx[],
+										const int flags);
+	SORT_API void argsort_radix_double_64 (const double keys[], const size_t n, int64_t idx[],
+										   const int flags);
+
+	/*
+	 * Permutes in place the 'n' contiguous elements of 'size' bytes each starting at
+	 * 'base' so that the element at i is the one that was at idx[i], following the
+	 * cycles of the permutation. Each element is moved once.
+	 * 'idx' is used to mark the visited indexes and is restored before returning.
+	 */
+	SORT_API void argsort_apply_permutation (void* base, const size_t n, const size_t size,
+											 int32_t idx[]);
+	SORT_API void argsort_apply_permutation_64 (void* base, const size_t n, const size_t size,
+												int64_t idx[]);
+
+#endif /* ARGSORT_H_ */
@@ -78,6 +78,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "sort.h"
+#include "bubblesort.h"
 
 /*
  * Sorts an array or part of an array items [from..to] using an optimized version
@@ -10,13 +10,14 @@
 	#define BUBBLESORT_H_
 
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
 	 * Sorts an array or part of an array items [from..to] using an optimized version
 	 * of the bubble sort algorithm.
 	 * Note: from (inclusive) .. to (inclusive)
 	 */
-	void bubblesort_sort (void* arr[], const int from, const int to,
-						  SortCompareFunc comparefunc);
+	SORT_API void bubblesort_sort (void* arr[], const int from, const int to,
+								   SortCompareFunc comparefunc);
 
 #endif /* BUBBLESORT_H_ */
@@ -21,6 +21,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "sort.h"
+#include "bubblesortll.h"
 #include "llsort.h"
 #include "linkedlist.h"
 
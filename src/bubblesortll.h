@@ -12,11 +12,12 @@
 	#include <stdlib.h>
 	#include "linkedlist.h"
 	#include "sort.h"
+	#include "sortapi.h"
 
 /*
  * Function to sort a linked list using bubblesort algorithm.
  *  */
-void bubblesortll_sort (struct LinkedList* list,
-					    SortCompareFunc comparefunc);
+SORT_API void bubblesortll_sort (struct LinkedList* list,
+								 SortCompareFunc comparefunc);
 
 #endif /* BUBBLESORTLL_H_ */
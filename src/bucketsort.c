@@ -129,6 +129,18 @@
  *
  *
  *
+ * Array backed implementation (bucketsort_sort_array):
+ *
+ *    Buckets are slices of one contiguous array instead of linked lists. A first
+ *    pass computes the bucket index of every element (kept for the next pass) and
+ *    counts the elements of each bucket, prefix sums of the counts give where each
+ *    bucket starts, and a second pass scatters the elements to their buckets. Each
+ *    bucket is then sorted in place by an array sorting algorithm (pdqsort by
+ *    default). The number of buckets grows with n (n/8), so buckets stay small
+ *    for uniformly distributed keys. Only 3 allocations are made for the whole
+ *    sort, no matter the number of elements.
+ *
+ *
  * Sources:
  * 		https://www.geeksforgeeks.org/bucket-sort-2/
  * 		https://www.geeksforgeeks.org/radix-sort-vs-bucket-sort/?ref=lbp
@@ -140,13 +152,27 @@
 #include "sort.h"
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 #include "llsort.h"
 #include "bucketsort.h"
-#include "insertionsortll.h"	// By default Insertion sort for linked lists is used
+#include "pdqsort.h"			// By default pdqsort is used for array buckets
+#include "sortstats.h"
 
 // Number of buckets
 static const int NUM_BUCKETS = 10;
 
+// Average number of elements per bucket of the array backed bucket sort
+static const int bucketsort_ELEMENTS_PER_BUCKET = 8;
+
+// Maximum number of buckets of the sampled bucket sort (a power of 2)
+static const int bucketsort_SAMPLED_MAX_BUCKETS = 4096;
+
+// Sampled elements per bucket of the sampled bucket sort
+static const int bucketsort_OVERSAMPLING = 8;
+
+// Ranges up to this size are sorted directly by the sampled bucket sort
+static const int bucketsort_SAMPLED_CUTOFF = 256;
+
 static void bucketsort_get_min_max (void* arr[], const int from, const int to,
 									void** min, void** max, SortCompareFunc comparefunc)
 {
@@ -163,60 +189,73 @@ static void bucketsort_get_min_max (void* arr[], const int from, const int to,
 
 /*
  * Compute bucket index for a given int value.
- * Common fórmula is: floor((array[i] - min) / range).
+ * Common fórmula is: floor(numBucks * (array[i] - min) / (max - min + 1)).
  */
 static int bucketsort_int_compute_index (void* value, void* min, void* max,
 									     const int n, const int numBucks)
 {
-	int iValue = *((int*)value);
-	int iMin = *((int*)min);
+	(void)n;
+	long long iValue = *((int*)value);
+	long long iMin = *((int*)min);
 
-	int iRange = ((*((int*)max)) - (*((int*)min))) / n;
+	// Range + 1 is never zero, even if all elements are equal
+	long long iRange = (long long)(*((int*)max)) - iMin + 1;
 
-	int res = ((iValue - iMin) / iRange);
+	int res = (int)(((iValue - iMin) * numBucks) / iRange);
 	if (res > numBucks-1) res = numBucks-1;
 	return res;
 }
 
 /*
  * Compute bucket index for a given float value.
- * Common fórmula is: floor((array[i] - min) / range).
+ * Common fórmula is: floor(numBucks * (array[i] - min) / (max - min)).
  */
 static int bucketsort_float_compute_index (void* value, void* min, void* max,
 										   const int n, const int numBucks)
 {
+	(void)n;
 	float fValue = *((float*)value);
 	float fMin = *((float*)min);
+	float fRange = (*((float*)max)) - fMin;
 
-	float fRange = ((*((float*)max)) - (*((float*)min))) / n;
-	int res = ((fValue - fMin) / fRange);
-	if (res > numBucks-1) res = numBucks-1;
-	return res;
+	// All elements are equal
+	if (!(fRange > 0))
+		return 0;
 
-//	float fValue = *((float*)value);
-//	float fMax = *((float*)max);
-//	return ((numBuckets * fValue) / (fMax * 1.1));
+	// Clamp before the cast, converting NaN or an out of range value to int is
+	// undefined
+	float q = ((fValue - fMin) / fRange) * numBucks;
+	if (!(q >= 0))
+		return 0;
+	if (q >= numBucks)
+		return numBucks - 1;
+	return (int)q;
 }
 
 /*
  * Compute bucket index for a given double value.
- * Common fórmula is: floor((array[i] - min) / range).
+ * Common fórmula is: floor(numBucks * (array[i] - min) / (max - min)).
  */
 static int bucketsort_double_compute_index (void* value, void* min, void* max,
 											const int n, const int numBucks)
 {
+	(void)n;
 	double dValue = *((double*)value);
 	double dMin = *((double*)min);
+	double dRange = (*((double*)max)) - dMin;
 
-	double dRange = ((*((double*)max)) - (*((double*)min))) / n;
-	int res = ((dValue - dMin) / dRange);
-	if (res > numBucks-1) res = numBucks-1;
-	return res;
-
+	// All elements are equal
+	if (!(dRange > 0))
+		return 0;
 
-//	double dValue = *((double*)value);
-//	double dMax = *((double*)max);
-//	return ((numBuckets * dValue) / (dMax * 1.1));
+	// Clamp before the cast, converting NaN or an out of range value to int is
+	// undefined
+	double q = ((dValue - dMin) / dRange) * numBucks;
+	if (!(q >= 0))
+		return 0;
+	if (q >= numBucks)
+		return numBucks - 1;
+	return (int)q;
 }
 
 /*
@@ -313,47 +352,604 @@ void bucketsort_sort_impl (void* arr[], const int from, const int to,
 			linkedlist_destroy (list);
 		}
 	}
+	SORTSTATS_MOVES (2 * (to - from + 1));		// to the buckets and back
+}
+
+// Finds the bucket of an element, from its position in [min..max] computed by
+// 'calcindexfunc', or by a search over splitters sampled from the input when 'tree'
+// is not NULL
+struct BucketsortClassifier {
+	int numBucks;
+	int n;
+	BucketsortCalcIndexFunc calcindexfunc;
+	void* min;
+	void* max;
+	void** tree;						// numBucks-1 splitters, tree[1] is the root
+	int levels;							// log2(numBucks)
+	SortCompareFunc comparefunc;
+};
+
+/*
+ * Returns the bucket index of 'value'.
+ */
+static inline int bucketsort_classify (const struct BucketsortClassifier* c, void* value)
+{
+	if (c->tree == NULL)
+		return c->calcindexfunc (value, c->min, c->max, c->n, c->numBucks);
+
+	// Branchless descent of the splitters tree: right child when splitter < value.
+	// The leaf reached, numBucks..2*numBucks-1, is the bucket.
+	int b = 1;
+	for (int l = 0; l < c->levels; ++l)
+		b = 2 * b + (c->comparefunc (c->tree[b], value) < 0);
+	return b - c->numBucks;
+}
+
+/*
+ * Fills the splitters tree in Eytzinger order (children of node k are 2k and 2k+1)
+ * with the sorted splitters sample[step], sample[2*step], ... taken in order.
+ */
+static void bucketsort_fill_tree (void* tree[], const int node, const int numBucks,
+								  void* sample[], const int nsample, int* next)
+{
+	if (node >= numBucks)
+		return;
+
+	bucketsort_fill_tree (tree, 2 * node, numBucks, sample, nsample, next);
+	tree[node] = sample[(int)((long long)(*next)++ * nsample / numBucks)];
+	bucketsort_fill_tree (tree, 2 * node + 1, numBucks, sample, nsample, next);
+}
+
+/*
+ * Sets up classifier 'c' with splitters at the quantiles of a random sample of
+ * arr[from..from+n-1]. The number of buckets is a power of 2 up to
+ * 'bucketsort_SAMPLED_MAX_BUCKETS'. 'c->tree' must be freed by the caller.
+ */
+static void bucketsort_sample_splitters (void* arr[], const int from, const int n,
+										 SortCompareFunc comparefunc,
+										 struct BucketsortClassifier* c)
+{
+	c->numBucks = 2;
+	c->levels = 1;
+	while (2 * c->numBucks <= n / bucketsort_ELEMENTS_PER_BUCKET &&
+		   2 * c->numBucks <= bucketsort_SAMPLED_MAX_BUCKETS) {
+		c->numBucks *= 2;
+		c->levels++;
+	}
+	c->n = n;
+	c->calcindexfunc = NULL;
+	c->min = NULL;
+	c->max = NULL;
+	c->comparefunc = comparefunc;
+
+	int nsample = c->numBucks * bucketsort_OVERSAMPLING;
+	if (nsample > n)
+		nsample = n;
+
+	void** sample = sortstats_malloc (nsample * sizeof (void*));
+	c->tree = sortstats_malloc (c->numBucks * sizeof (void*));
+	if (sample == NULL || c->tree == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for bucket sort splitters.");
+		abort ();
+	}
+
+	// Random positions (xorshift), the same for the same n
+	unsigned int seed = 2463534242u ^ (unsigned int)n;
+	for (int i = 0; i < nsample; ++i) {
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		sample[i] = arr[from + (int)(seed % (unsigned int)n)];
+	}
+
+	pdqsort_sort (sample, 0, nsample - 1, comparefunc);
+
+	int next = 1;
+	bucketsort_fill_tree (c->tree, 1, c->numBucks, sample, nsample, &next);
+	sortstats_free (sample);
+}
+
+/*
+ * Sorts array or part of an array[from..to] with the buckets given by classifier 'c'
+ * stored in a single contiguous array.
+ */
+static void bucketsort_sort_classified (void* arr[], const int from, const int to,
+										SortCompareFunc comparefunc,
+										const struct BucketsortClassifier* c,
+										SortArrayFunc sortfunc)
+{
+	const int n = (to - from + 1);
+	const int numBucks = c->numBucks;
+
+	int* index = sortstats_malloc (n * sizeof (int));				// bucket of each element
+	int* start = sortstats_calloc (numBucks + 1, sizeof (int));	// first element of each bucket
+	void** buf = sortstats_malloc (n * sizeof (void*));
+	if (index == NULL || start == NULL || buf == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for bucket sort.");
+		abort ();
+	}
+
+	// Count elements of each bucket
+	for (int i = 0; i < n; ++i) {
+		index[i] = bucketsort_classify (c, arr[from + i]);
+		assert (index[i] >= 0 && index[i] < numBucks);
+		start[index[i] + 1]++;
+	}
+
+	// Counts to start positions
+	for (int b = 0; b < numBucks; ++b)
+		start[b + 1] += start[b];
+
+	// Scatter elements to their buckets, 'start[b]' ends as the start of bucket b+1
+	for (int i = 0; i < n; ++i)
+		buf[start[index[i]]++] = arr[from + i];
+
+	// Sort each bucket and copy it back
+	int first = 0;
+	for (int b = 0; b < numBucks; ++b) {
+		if (start[b] - first > 1)
+			sortfunc (buf, first, start[b] - 1, comparefunc);
+		first = start[b];
+	}
+
+	memcpy (&arr[from], buf, n * sizeof (void*));
+	SORTSTATS_MOVES (2 * n);		// to the buckets and back
+
+	sortstats_free (buf);
+	sortstats_free (start);
+	sortstats_free (index);
+}
+
+/*
+ * Function to sort an array or part of an array[from..to] using the bucket sort sorting
+ * algorithm, with buckets stored in a single contiguous array.
+ * A counting pass sizes the buckets exactly, the elements are scattered to their
+ * buckets and each bucket is sorted with the array sorting function 'sortfunc'.
+ * The number of buckets is n/8.
+ */
+void bucketsort_sort_array (void* arr[], const int from, const int to,
+							SortCompareFunc comparefunc,
+							BucketsortCalcIndexFunc calcindexfunc,
+							SortArrayFunc sortfunc)
+{
+	const int n = (to - from + 1);
+	if (n < 2)
+		return;
+
+	struct BucketsortClassifier c;
+	c.numBucks = n / bucketsort_ELEMENTS_PER_BUCKET;
+	if (c.numBucks < 1)
+		c.numBucks = 1;
+	c.n = n;
+	c.calcindexfunc = calcindexfunc;
+	c.tree = NULL;
+	c.levels = 0;
+	c.comparefunc = comparefunc;
+
+	// Get min/max input value
+	bucketsort_get_min_max (arr, from, to, &c.min, &c.max, comparefunc);
+
+	bucketsort_sort_classified (arr, from, to, comparefunc, &c, sortfunc);
+}
+
+/*
+ * Function to sort an array or part of an array[from..to] using the bucket sort sorting
+ * algorithm, with bucket boundaries taken from a sample of the input.
+ * Splitters are picked at the quantiles of a sorted random sample (as in samplesort),
+ * so buckets hold about the same number of elements whatever the distribution of the
+ * input, and the bucket of each element is found by a binary search over the
+ * splitters. Each bucket is sorted with the array sorting function 'sortfunc'.
+ */
+void bucketsort_sort_sampled (void* arr[], const int from, const int to,
+							  SortCompareFunc comparefunc, SortArrayFunc sortfunc)
+{
+	const int n = (to - from + 1);
+	if (n <= bucketsort_SAMPLED_CUTOFF) {
+		if (n > 1)
+			sortfunc (arr, from, to, comparefunc);
+		return;
+	}
+
+	struct BucketsortClassifier c;
+	bucketsort_sample_splitters (arr, from, n, comparefunc, &c);
+	bucketsort_sort_classified (arr, from, to, comparefunc, &c, sortfunc);
+	sortstats_free (c.tree);
 }
 
 /*
  * Function to sort an array or part of an array[from..to] of ints using the bucket sort
  * sorting algorithm.
- * On each bucket input data will be stored in a linked list.
- * The linked lists will be sorted with Insertion sort sorting algorithm.
- * To specifie another sorting algorithm use function 'bucketsort_sort_impl ()'.
+ * Buckets are stored in a single contiguous array and sorted with pdqsort.
+ * To specifie another sorting algorithm use function 'bucketsort_sort_array ()'.
  */
 void bucketsort_sort_ints (void* arr[], const int from, const int to,
 						   SortCompareFunc comparefunc)
 {
-	bucketsort_sort_impl (arr, from, to, comparefunc,
-						  bucketsort_int_compute_index, insertionsortll_sort);
+	bucketsort_sort_array (arr, from, to, comparefunc,
+						   bucketsort_int_compute_index, pdqsort_sort);
 }
 
 /*
  * Function to sort an array or part of an array[from..to] of floats using the bucket sort
  * sorting algorithm.
- * On each bucket input data will be stored in a linked list.
- * The linked lists will be sorted with Insertion sort sorting algorithm.
- * To specifie another sorting algorithm use function 'bucketsort_sort_impl ()'.
+ * Buckets are stored in a single contiguous array and sorted with pdqsort.
+ * To specifie another sorting algorithm use function 'bucketsort_sort_array ()'.
  */
 void bucketsort_sort_floats (void* arr[], const int from, const int to,
 						     SortCompareFunc comparefunc)
 {
-	bucketsort_sort_impl (arr, from, to, comparefunc,
-						  bucketsort_float_compute_index, insertionsortll_sort);
+	bucketsort_sort_array (arr, from, to, comparefunc,
+						   bucketsort_float_compute_index, pdqsort_sort);
 }
 
 /*
  * Function to sort an array or part of an array[from..to] of doubles using the bucket sort
  * sorting algorithm.
- * On each bucket input data will be stored in a linked list.
- * The linked lists will be sorted with Insertion sort sorting algorithm.
- * To specifie another sorting algorithm use function 'bucketsort_sort_impl ()'.
+ * Buckets are stored in a single contiguous array and sorted with pdqsort.
+ * To specifie another sorting algorithm use function 'bucketsort_sort_array ()'.
  */
 void bucketsort_sort_doubles (void* arr[], const int from, const int to,
 						     SortCompareFunc comparefunc)
 {
-	bucketsort_sort_impl (arr, from, to, comparefunc,
-						  bucketsort_double_compute_index, insertionsortll_sort);
+	bucketsort_sort_array (arr, from, to, comparefunc,
+						   bucketsort_double_compute_index, pdqsort_sort);
+}
+
+
+/*
+ * Parallel bucket sort section.
+ *
+ * About:
+ *
+ *    The range is split in one block per thread, and every phase of
+ *    'bucketsort_sort_array ()' is run by one task per block:
+ *
+ *      1. Each task finds the min/max of its block, then they are combined.
+ *      2. Each task computes the bucket index of the elements of its block and
+ *         counts them in its own histogram, so no counter is shared.
+ *      3. The histograms are turned into exclusive offsets: the elements of block t
+ *         in bucket b go after those of all buckets before b and after those of
+ *         blocks before t in bucket b. Each (block, bucket) pair owns a distinct
+ *         slice of the buffer, so the scatter needs no locks and keeps the input
+ *         order of equal elements.
+ *      4. The buckets are split in groups of about the same number of elements,
+ *         each group is sorted and copied back by its own task.
+ *
+ *    One histogram per block costs nblocks * numBucks counters, so the number of
+ *    buckets is lowered to n / (2 * nblocks) when that is less than n/8.
+ *
+ *    The sampled bucket sort skips step 1, its splitters are sampled by the calling
+ *    thread.
+ */
+
+// Ranges up to this size are sorted by 'bucketsort_sort_array ()'
+static const int bucketsort_PARALLEL_CUTOFF = 65536;
+
+// Minimum number of elements of each group of buckets sorted by a task
+static const int bucketsort_SORT_BLOCK = 8192;
+
+// A parallel bucket sort, shared by its tasks
+struct BucketsortJob {
+	void** arr;							// first element to sort
+	void** buf;							// buckets
+	int* index;							// bucket of each element
+	int* hist;							// counts, then offsets, of each block bucket
+	int* start;							// first element of each bucket (numBucks+1)
+	int n;
+	int numBucks;
+	struct BucketsortClassifier cls;	// bucket of an element
+	SortCompareFunc comparefunc;
+	SortArrayFunc sortfunc;
+};
+
+// A block of elements, or a group of buckets, processed by a task
+struct BucketsortTask {
+	struct BucketsortJob* job;
+	int block;							// block number (histogram row)
+	int first;							// first element, or bucket
+	int end;							// element, or bucket, after the last one
+	void* min;
+	void* max;
+};
+
+/*
+ * Runs 'func' for every task, the first one on the calling thread, and waits for
+ * them all.
+ * */
+static void bucketsort_run_tasks (struct ThreadPool* pool, ThreadPoolTaskFunc func,
+								  struct BucketsortTask tasks[], const int ntasks) {
+	struct ThreadPoolGroup group;
+	threadpool_group_init (&group);
+
+	for (int t = 1; t < ntasks; ++t)
+		threadpool_submit (pool, &group, func, &tasks[t]);
+
+	func (&tasks[0]);
+	threadpool_wait (pool, &group);
+}
+
+/*
+ * Task finding the min/max of a block.
+ * */
+static void bucketsort_min_max_task (void* arg) {
+	struct BucketsortTask* t = arg;
+	bucketsort_get_min_max (t->job->arr, t->first, t->end - 1, &t->min, &t->max,
+							t->job->comparefunc);
+}
+
+/*
+ * Task computing the bucket of the elements of a block and counting them in the
+ * block histogram.
+ * */
+static void bucketsort_count_task (void* arg) {
+	struct BucketsortTask* t = arg;
+	struct BucketsortJob* job = t->job;
+	int* hist = job->hist + (size_t)t->block * job->numBucks;
+
+	for (int i = t->first; i < t->end; ++i) {
+		int b = bucketsort_classify (&job->cls, job->arr[i]);
+		assert (b >= 0 && b < job->numBucks);
+		job->index[i] = b;
+		hist[b]++;
+	}
+}
+
+/*
+ * Task scattering the elements of a block to their buckets.
+ * */
+static void bucketsort_scatter_task (void* arg) {
+	struct BucketsortTask* t = arg;
+	struct BucketsortJob* job = t->job;
+	int* offset = job->hist + (size_t)t->block * job->numBucks;
+
+	for (int i = t->first; i < t->end; ++i)
+		job->buf[offset[job->index[i]]++] = job->arr[i];
+}
+
+/*
+ * Task sorting a group of buckets and copying them back to the array.
+ * */
+static void bucketsort_sort_buckets_task (void* arg) {
+	struct BucketsortTask* t = arg;
+	struct BucketsortJob* job = t->job;
+
+	for (int b = t->first; b < t->end; ++b) {
+		if (job->start[b + 1] - job->start[b] > 1)
+			job->sortfunc (job->buf, job->start[b], job->start[b + 1] - 1, job->comparefunc);
+	}
+
+	int first = job->start[t->first];
+	int end = job->start[t->end];
+	memcpy (&job->arr[first], &job->buf[first], (end - first) * sizeof (void*));
+}
+
+/*
+ * Sorts array or part of an array[from..to] with the buckets given by classifier 'c'
+ * on the threads of the given pool. When 'c' has no splitters tree, its min and max
+ * are found first.
+ */
+static void bucketsort_sort_classified_pool (void* arr[], const int from, const int to,
+											 SortCompareFunc comparefunc,
+											 const struct BucketsortClassifier* c,
+											 SortArrayFunc sortfunc,
+											 struct ThreadPool* pool)
+{
+	const int n = (to - from + 1);
+	const int nblocks = threadpool_num_threads (pool);
+	const int numBucks = c->numBucks;
+
+	struct BucketsortJob job;
+	job.arr = &arr[from];
+	job.n = n;
+	job.numBucks = numBucks;
+	job.cls = *c;
+	job.comparefunc = comparefunc;
+	job.sortfunc = sortfunc;
+	job.index = sortstats_malloc (n * sizeof (int));
+	job.buf = sortstats_malloc (n * sizeof (void*));
+	job.hist = sortstats_calloc ((size_t)nblocks * numBucks, sizeof (int));
+	job.start = sortstats_malloc ((numBucks + 1) * sizeof (int));
+
+	// Element blocks first, then groups of buckets (at most 4 per thread)
+	const int maxtasks = 4 * nblocks + 1;
+	struct BucketsortTask* tasks = sortstats_malloc (maxtasks * sizeof (struct BucketsortTask));
+
+	if (job.index == NULL || job.buf == NULL || job.hist == NULL ||
+		job.start == NULL || tasks == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for parallel bucket sort.");
+		abort ();
+	}
+
+	for (int t = 0; t < nblocks; ++t) {
+		tasks[t].job = &job;
+		tasks[t].block = t;
+		tasks[t].first = (int)((long long)n * t / nblocks);
+		tasks[t].end = (int)((long long)n * (t + 1) / nblocks);
+	}
+
+	// 1. Min/max of each block, then of the whole range
+	if (job.cls.tree == NULL) {
+		bucketsort_run_tasks (pool, bucketsort_min_max_task, tasks, nblocks);
+		job.cls.min = tasks[0].min;
+		job.cls.max = tasks[0].max;
+		for (int t = 1; t < nblocks; ++t) {
+			if (comparefunc (tasks[t].max, job.cls.max) > 0)
+				job.cls.max = tasks[t].max;
+			if (comparefunc (job.cls.min, tasks[t].min) > 0)
+				job.cls.min = tasks[t].min;
+		}
+	}
+
+	// 2. Histogram of each block
+	bucketsort_run_tasks (pool, bucketsort_count_task, tasks, nblocks);
+
+	// 3. Histograms to offsets, bucket by bucket then block by block
+	int sum = 0;
+	for (int b = 0; b < numBucks; ++b) {
+		job.start[b] = sum;
+		for (int t = 0; t < nblocks; ++t) {
+			int* h = &job.hist[(size_t)t * numBucks + b];
+			int count = *h;
+			*h = sum;
+			sum += count;
+		}
+	}
+	job.start[numBucks] = sum;
+
+	bucketsort_run_tasks (pool, bucketsort_scatter_task, tasks, nblocks);
+
+	// 4. Sort groups of buckets of about the same size
+	int groupsize = n / (maxtasks - 1);
+	if (groupsize < bucketsort_SORT_BLOCK)
+		groupsize = bucketsort_SORT_BLOCK;
+
+	int ntasks = 0;
+	int firstbuck = 0;
+	for (int b = 1; b <= numBucks; ++b) {
+		if (b == numBucks || job.start[b] - job.start[firstbuck] >= groupsize) {
+			tasks[ntasks].job = &job;
+			tasks[ntasks].first = firstbuck;
+			tasks[ntasks].end = b;
+			ntasks++;
+			firstbuck = b;
+		}
+	}
+
+	bucketsort_run_tasks (pool, bucketsort_sort_buckets_task, tasks, ntasks);
+	SORTSTATS_MOVES (2 * n);		// to the buckets and back
+
+	sortstats_free (tasks);
+	sortstats_free (job.start);
+	sortstats_free (job.hist);
+	sortstats_free (job.buf);
+	sortstats_free (job.index);
 }
 
+/*
+ * Parallel bucket sort of array or part of an array[from..to] running on the threads
+ * of the given pool. Same as 'bucketsort_sort_array ()' otherwise.
+ */
+void bucketsort_sort_array_pool (void* arr[], const int from, const int to,
+								 SortCompareFunc comparefunc,
+								 BucketsortCalcIndexFunc calcindexfunc,
+								 SortArrayFunc sortfunc, struct ThreadPool* pool)
+{
+	const int n = (to - from + 1);
+	const int nblocks = threadpool_num_threads (pool);
+
+	if (n <= bucketsort_PARALLEL_CUTOFF || nblocks < 2) {
+		bucketsort_sort_array (arr, from, to, comparefunc, calcindexfunc, sortfunc);
+		return;
+	}
+
+	struct BucketsortClassifier c;
+	c.numBucks = n / bucketsort_ELEMENTS_PER_BUCKET;
+	if (c.numBucks > n / (2 * nblocks))
+		c.numBucks = n / (2 * nblocks);
+	c.n = n;
+	c.calcindexfunc = calcindexfunc;
+	c.min = NULL;
+	c.max = NULL;
+	c.tree = NULL;
+	c.levels = 0;
+	c.comparefunc = comparefunc;
+
+	bucketsort_sort_classified_pool (arr, from, to, comparefunc, &c, sortfunc, pool);
+}
+
+/*
+ * Parallel sampled bucket sort of array or part of an array[from..to] running on
+ * the threads of the given pool. Same as 'bucketsort_sort_sampled ()' otherwise.
+ */
+void bucketsort_sort_sampled_pool (void* arr[], const int from, const int to,
+								   SortCompareFunc comparefunc, SortArrayFunc sortfunc,
+								   struct ThreadPool* pool)
+{
+	const int n = (to - from + 1);
+
+	if (n <= bucketsort_PARALLEL_CUTOFF || threadpool_num_threads (pool) < 2) {
+		bucketsort_sort_sampled (arr, from, to, comparefunc, sortfunc);
+		return;
+	}
+
+	struct BucketsortClassifier c;
+	bucketsort_sample_splitters (arr, from, n, comparefunc, &c);
+	bucketsort_sort_classified_pool (arr, from, to, comparefunc, &c, sortfunc, pool);
+	sortstats_free (c.tree);
+}
+
+/*
+ * Parallel bucket sort of array or part of an array[from..to] with 'nthreads'
+ * threads (the number of online processors if 'nthreads' <= 0).
+ */
+void bucketsort_sort_array_parallel (void* arr[], const int from, const int to,
+									 SortCompareFunc comparefunc,
+									 BucketsortCalcIndexFunc calcindexfunc,
+									 SortArrayFunc sortfunc, const int nthreads)
+{
+	struct ThreadPool* pool = NULL;
+	if ((to - from + 1 > bucketsort_PARALLEL_CUTOFF) && (nthreads != 1))
+		pool = threadpool_create (nthreads);
+
+	if (pool == NULL) {
+		bucketsort_sort_array (arr, from, to, comparefunc, calcindexfunc, sortfunc);
+		return;
+	}
+
+	bucketsort_sort_array_pool (arr, from, to, comparefunc, calcindexfunc, sortfunc, pool);
+	threadpool_destroy (pool);
+}
+
+/*
+ * Parallel sampled bucket sort of array or part of an array[from..to] with
+ * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
+ */
+void bucketsort_sort_sampled_parallel (void* arr[], const int from, const int to,
+									   SortCompareFunc comparefunc, SortArrayFunc sortfunc,
+									   const int nthreads)
+{
+	struct ThreadPool* pool = NULL;
+	if ((to - from + 1 > bucketsort_PARALLEL_CUTOFF) && (nthreads != 1))
+		pool = threadpool_create (nthreads);
+
+	if (pool == NULL) {
+		bucketsort_sort_sampled (arr, from, to, comparefunc, sortfunc);
+		return;
+	}
+
+	bucketsort_sort_sampled_pool (arr, from, to, comparefunc, sortfunc, pool);
+	threadpool_destroy (pool);
+}
+
+/*
+ * Parallel bucket sort of an array or part of an array[from..to] of ints with
+ * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
+ */
+void bucketsort_sort_ints_parallel (void* arr[], const int from, const int to,
+									SortCompareFunc comparefunc, const int nthreads)
+{
+	bucketsort_sort_array_parallel (arr, from, to, comparefunc,
+									bucketsort_int_compute_index, pdqsort_sort, nthreads);
+}
+
+/*
+ * Parallel bucket sort of an array or part of an array[from..to] of floats with
+ * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
+ */
+void bucketsort_sort_floats_parallel (void* arr[], const int from, const int to,
+									  SortCompareFunc comparefunc, const int nthreads)
+{
+	bucketsort_sort_array_parallel (arr, from, to, comparefunc,
+									bucketsort_float_compute_index, pdqsort_sort, nthreads);
+}
+
+/*
+ * Parallel bucket sort of an array or part of an array[from..to] of doubles with
+ * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
+ */
+void bucketsort_sort_doubles_parallel (void* arr[], const int from, const int to,
+									   SortCompareFunc comparefunc, const int nthreads)
+{
+	bucketsort_sort_array_parallel (arr, from, to, comparefunc,
+									bucketsort_double_compute_index, pdqsort_sort, nthreads);
+}
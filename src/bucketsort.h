@@ -11,6 +11,8 @@
 
 	#include "sort.h"
 	#include "llsort.h"
+	#include "threadpool.h"
+	#include "sortapi.h"
 
 	typedef int (*BucketsortCalcIndexFunc)(void* value, void* min, void* max,
 										   const int n, const int numBucks);
@@ -24,39 +26,121 @@
 	 * Any sort algorithm for linked lists can be used to sort the buckets, like
 	 * insertionsort, quicksort or mergesort for linked lists.
 	 */
-	void bucketsort_sort_impl (void* arr[], const int from, const int to,
-							   SortCompareFunc comparefunc,
-							   BucketsortCalcIndexFunc calcindexfunc,
-							   SortLinkedListFunc sortfunc);
+	SORT_API void bucketsort_sort_impl (void* arr[], const int from, const int to,
+										SortCompareFunc comparefunc,
+										BucketsortCalcIndexFunc calcindexfunc,
+										SortLinkedListFunc sortfunc);
+
+	/*
+	 * Function to sort an array or part of an array[from..to] using the bucket sort
+	 * sorting algorithm, with buckets stored in a single contiguous array.
+	 * A counting pass sizes the buckets exactly, the elements are scattered to their
+	 * buckets and each bucket is sorted with the array sorting function 'sortfunc'
+	 * (like 'pdqsort_sort ()' or 'insertionsort_sort ()').
+	 * The number of buckets is n/8.
+	 */
+	SORT_API void bucketsort_sort_array (void* arr[], const int from, const int to,
+										 SortCompareFunc comparefunc,
+										 BucketsortCalcIndexFunc calcindexfunc,
+										 SortArrayFunc sortfunc);
 
 	/*
 	 * Function to sort an array or part of an array[from..to] of ints using the bucket sort
 	 * sorting algorithm.
-	 * On each bucket input data will be stored in a linked list.
-	 * The linked lists will be sorted with Insertion sort sorting algorithm.
-	 * To specifie another sorting algorithm use function 'bucketsort_sort_impl ()'.
+	 * Buckets are stored in a single contiguous array and sorted with pdqsort.
+	 * To specifie another sorting algorithm use function 'bucketsort_sort_array ()'.
 	 */
-	void bucketsort_sort_ints (void* arr[], const int from, const int to,
-							   SortCompareFunc comparefunc);
+	SORT_API void bucketsort_sort_ints (void* arr[], const int from, const int to,
+										SortCompareFunc comparefunc);
 
 	/*
 	 * Function to sort an array or part of an array[from..to] of floats using the bucket sort
 	 * sorting algorithm.
-	 * On each bucket input data will be stored in a linked list.
-	 * The linked lists will be sorted with Insertion sort sorting algorithm.
-	 * To specifie another sorting algorithm use function 'bucketsort_sort_impl ()'.
+	 * Buckets are stored in a single contiguous array and sorted with pdqsort.
+	 * To specifie another sorting algorithm use function 'bucketsort_sort_array ()'.
 	 */
-	void bucketsort_sort_floats (void* arr[], const int from, const int to,
-							     SortCompareFunc comparefunc);
+	SORT_API void bucketsort_sort_floats (void* arr[], const int from, const int to,
+										  SortCompareFunc comparefunc);
 
 	/*
 	 * Function to sort an array or part of an array[from..to] of doubles using the bucket sort
 	 * sorting algorithm.
-	 * On each bucket input data will be stored in a linked list.
-	 * The linked lists will be sorted with Insertion sort sorting algorithm.
-	 * To specifie another sorting algorithm use function 'bucketsort_sort_impl ()'.
+	 * Buckets are stored in a single contiguous array and sorted with pdqsort.
+	 * To specifie another sorting algorithm use function 'bucketsort_sort_array ()'.
+	 */
+	SORT_API void bucketsort_sort_doubles (void* arr[], const int from, const int to,
+										   SortCompareFunc comparefunc);
+
+	/*
+	 * Function to sort an array or part of an array[from..to] using the bucket sort
+	 * sorting algorithm, with bucket boundaries taken from a sample of the input.
+	 * Splitters are picked at the quantiles of a sorted random sample (as in
+	 * samplesort), so buckets hold about the same number of elements whatever the
+	 * distribution of the input (skewed, Zipf-like, clustered), and the bucket of
+	 * each element is found by a branchless binary search over the splitters.
+	 * Each bucket is sorted with the array sorting function 'sortfunc'.
+	 */
+	SORT_API void bucketsort_sort_sampled (void* arr[], const int from, const int to,
+										   SortCompareFunc comparefunc, SortArrayFunc sortfunc);
+
+	/*
+	 * Parallel bucket sort of array or part of an array[from..to] running on the
+	 * threads of the given pool. Same as 'bucketsort_sort_array ()' otherwise.
+	 */
+	SORT_API void bucketsort_sort_array_pool (void* arr[], const int from, const int to,
+											  SortCompareFunc comparefunc,
+											  BucketsortCalcIndexFunc calcindexfunc,
+											  SortArrayFunc sortfunc, struct ThreadPool* pool);
+
+	/*
+	 * Parallel bucket sort of array or part of an array[from..to] with 'nthreads'
+	 * threads (the number of online processors if 'nthreads' <= 0).
+	 * Each thread computes the bucket indexes and a histogram of its own block of
+	 * elements, the histograms are combined in offsets so every thread scatters its
+	 * elements without locks, and groups of buckets are sorted by tasks of a
+	 * work-stealing thread pool.
+	 * 'calcindexfunc' must be safe to call from several threads at once.
+	 */
+	SORT_API void bucketsort_sort_array_parallel (void* arr[], const int from, const int to,
+												  SortCompareFunc comparefunc,
+												  BucketsortCalcIndexFunc calcindexfunc,
+												  SortArrayFunc sortfunc, const int nthreads);
+
+	/*
+	 * Parallel sampled bucket sort of array or part of an array[from..to] running on
+	 * the threads of the given pool. Same as 'bucketsort_sort_sampled ()' otherwise.
+	 */
+	SORT_API void bucketsort_sort_sampled_pool (void* arr[], const int from, const int to,
+												SortCompareFunc comparefunc, SortArrayFunc sortfunc,
+												struct ThreadPool* pool);
+
+	/*
+	 * Parallel sampled bucket sort of array or part of an array[from..to] with
+	 * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
+	 */
+	SORT_API void bucketsort_sort_sampled_parallel (void* arr[], const int from, const int to,
+													SortCompareFunc comparefunc,
+													SortArrayFunc sortfunc, const int nthreads);
+
+	/*
+	 * Parallel bucket sort of an array or part of an array[from..to] of ints with
+	 * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
+	 */
+	SORT_API void bucketsort_sort_ints_parallel (void* arr[], const int from, const int to,
+												 SortCompareFunc comparefunc, const int nthreads);
+
+	/*
+	 * Parallel bucket sort of an array or part of an array[from..to] of floats with
+	 * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
+	 */
+	SORT_API void bucketsort_sort_floats_parallel (void* arr[], const int from, const int to,
+												   SortCompareFunc comparefunc, const int nthreads);
+
+	/*
+	 * Parallel bucket sort of an array or part of an array[from..to] of doubles with
+	 * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
 	 */
-	void bucketsort_sort_doubles (void* arr[], const int from, const int to,
-							      SortCompareFunc comparefunc);
+	SORT_API void bucketsort_sort_doubles_parallel (void* arr[], const int from, const int to,
+													SortCompareFunc comparefunc, const int nthreads);
 
 #endif /* BUCKETSORT_H_ */
@@ -28,6 +28,7 @@
  */
 
 #include "sort.h"
+#include "combsort.h"
 #include <stdbool.h>
 
 /*
@@ -10,11 +10,12 @@
 	#define COMBSORT_H_
 
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
 	 * Function to sort a[from..to] using Comb Sort.
 	 */
-	void combsort_sort (void* arr[], const int from, const int to,
-						SortCompareFunc comparefunc);
+	SORT_API void combsort_sort (void* arr[], const int from, const int to,
+								 SortCompareFunc comparefunc);
 
 #endif /* COMBSORT_H_ */
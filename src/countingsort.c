@@ -79,7 +79,35 @@
  * 		https://www.codingeek.com/algorithms/counting-sort-explanation-pseudocode-and-implementation/
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include "sort.h"
+#include "countingsort.h"
+#include "radixsortlsd.h"		// For ranges too wide for counting
+#include "radixsortkey.h"
+#include "sortstats.h"
+
+// Ranges of values wider than this many times the number of elements are sorted by
+// radix sort, the histogram would cost more than the elements
+static const int countingsort_MAX_RANGE_FACTOR = 1;
+
+/*
+ * Gets the number of values in [min..max], without overflowing.
+ */
+static inline size_t countingsort_range (const int min, const int max)
+{
+	return (size_t)((long long)max - min + 1);
+}
+
+/*
+ * Gets the histogram index of 'value', without overflowing.
+ */
+static inline size_t countingsort_index (const int value, const int min)
+{
+	return (size_t)((unsigned int)value - (unsigned int)min);
+}
 
 /*
  * Finds min and max values from input array[from..to].
@@ -98,6 +126,29 @@ static void countingsort_min_max (int arr[], const int from, const int to,
 	}
 }
 
+/*
+ * Function to sort array[from..to] with Counting sort algorithm with given min and
+ * max values, counting in the caller provided histogram 'count' of max-min+1 ints.
+ * Note: This is a in place counting sort version.
+ */
+void countingsort_sort_in_place_with_buffer (int arr[], const int from, const int to,
+											 const int min, const int max, int count[])
+{
+	const size_t range = countingsort_range (min, max);
+
+	memset (count, 0, range * sizeof (int));
+	for (int i = from; i <= to; i++)
+		count[countingsort_index (arr[i], min)]++;
+
+	int z = from;
+	for (size_t v = 0; v < range; v++) {
+		const int value = (int)(min + (long long)v);
+		for (int j = 0; j < count[v]; j++)
+			arr[z++] = value;
+	}
+	SORTSTATS_MOVES (to - from + 1);
+}
+
 /*
  * Function to sort array[from..to] with Counting sort algorithm with
  * given min and max values.
@@ -106,32 +157,36 @@ static void countingsort_min_max (int arr[], const int from, const int to,
 void countingsort_sort_in_place_mm (int arr[], const int from, const int to,
 						const int min, const int max)
 {
-	int i, j, z;
-
-	int range = max - min + 1;
-	int count[range];// = malloc (range * sizeof(*arr));
-
-	for(i = 0; i < range; i++) count[i] = 0;
-	for(i = from; i < (to + 1); i++)
-		count[arr[i] - min]++;
-
-	for(i = min, z = from; i <= max; i++) {
-		for(j = 0; j < count[i - min]; j++) {
-			arr[z++] = i;
-		}
+	int* count = sortstats_malloc (countingsort_range (min, max) * sizeof (int));
+	if (count == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for counting sort histogram.");
+		abort ();
 	}
 
-//	free (count);
+	countingsort_sort_in_place_with_buffer (arr, from, to, min, max, count);
+
+	sortstats_free (count);
 }
 
 /*
  * Function to sort array[from..to] with Counting sort algorithm.
+ * When the range of values is much wider than the number of elements the array is
+ * sorted by LSD radix sort instead.
  * Note: In place version.
  */
 void countingsort_sort_in_place (int arr[], const int from, const int to)
 {
 	int min, max;
+	if (to <= from)
+		return;
+
 	countingsort_min_max (arr, from, to, &min, &max);
+	if (countingsort_range (min, max) >
+		(size_t)countingsort_MAX_RANGE_FACTOR * (size_t)(to - from + 1)) {
+		radixsortlsd_sort_i32 ((int32_t*)arr, from, to);
+		return;
+	}
+
 	countingsort_sort_in_place_mm (arr, from, to,
 						  min, max);
 }
@@ -143,17 +198,18 @@ void countingsort_sort_in_place (int arr[], const int from, const int to)
 int* countingsort_sort_mm (int arr[], const int n, const int from, const int to,
 						   const int min, const int max)
 {
-    int i, j;
+    int j;
     int* out = malloc (n * sizeof (int));
-    int range = max-min+1;
-	int count[range];
-
-    // Initializing counting array count[i] to 0
-    for (i=0; i<range; i++) count[i] = 0;
+    size_t i, range = countingsort_range (min, max);
+	int* count = sortstats_calloc (range, sizeof (int));
+	if (out == NULL || count == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for counting sort.");
+		abort ();
+	}
 
     // Store count of each element in array count
     for (j=from; j<(to+1); j++)
-        count[arr[j-min]]++;
+        count[countingsort_index (arr[j], min)]++;
 
     /* Change count[i] such that it contains actual
     position of these elements in output array*/
@@ -164,21 +220,611 @@ int* countingsort_sort_mm (int arr[], const int n, const int from, const int to,
     // and decrementing value of count[i].
     for (j=to; j>=from; j--)
     {
-        out[count[arr[j]-min]-1] = arr[j];
-        count[arr[j]-min]--;
+        out[count[countingsort_index (arr[j], min)]-1] = arr[j];
+        count[countingsort_index (arr[j], min)]--;
     }
+    SORTSTATS_MOVES (to - from + 1);
 
+    sortstats_free (count);
     return out;
 }
 
 /*
  * Function to sort array[from..to] with Counting sort algorithm.
+ * When the range of values is much wider than the number of elements the copy is
+ * sorted by LSD radix sort instead.
  * Note: Not in place version.
  */
 int* countingsort_sort (int arr[], const int n, const int from, const int to)
 {
 	int min, max;
 	countingsort_min_max (arr, from, to, &min, &max);
+	if (countingsort_range (min, max) >
+		(size_t)countingsort_MAX_RANGE_FACTOR * (size_t)(to - from + 1)) {
+		int* out = malloc (n * sizeof (int));
+		if (out == NULL) {
+			fprintf (stderr, "Error: failed to allocate memory for counting sort.");
+			abort ();
+		}
+		memcpy (out, &arr[from], (to - from + 1) * sizeof (int));
+		radixsortlsd_sort_i32 ((int32_t*)out, 0, to - from);
+		return out;
+	}
+
 	return countingsort_sort_mm (arr, n, from, to,
 						         min, max);
 }
+
+
+/*
+ * Parallel counting sort section.
+ *
+ * About:
+ *
+ *    1. The range is split in one block of elements per thread. Each task finds the
+ *       min/max of its block, then they are combined.
+ *    2. Each task counts the elements of its block in its own histogram, so no
+ *       counter is shared. One histogram per block costs nblocks * range counters,
+ *       so fewer blocks are counted when that is more than 4 counters per element.
+ *    3. The range of values is split in one slice per thread. Each task adds up the
+ *       histograms of all blocks for the values of its slice.
+ *    4. Each slice starts after the elements of the slices before it, and every
+ *       task writes the values of its slice to the array.
+ *
+ *    Ranges of values wider than the number of elements are sorted by LSD radix
+ *    sort, like in 'countingsort_sort_in_place ()'.
+ */
+
+// Ranges up to this size are sorted by 'countingsort_sort_in_place ()'
+static const int countingsort_PARALLEL_CUTOFF = 65536;
+
+// Maximum number of counters of all blocks histograms per element
+static const int countingsort_HIST_FACTOR = 4;
+
+// A parallel counting sort, shared by its tasks
+struct CountingsortJob {
+	int* arr;							// first element to sort
+	int min;
+	size_t range;
+	int nblocks;						// blocks counted in their own histogram
+	int* hist;							// histogram of each block, totals in the first
+};
+
+// A block of elements, or a slice of values, processed by a task
+struct CountingsortTask {
+	struct CountingsortJob* job;
+	int block;							// block number (histogram row)
+	size_t first;						// first element, or value
+	size_t end;							// element, or value, after the last one
+	int min;
+	int max;
+	size_t pos;							// elements of the slice, then its first position
+};
+
+/*
+ * Runs 'func' for every task, the first one on the calling thread, and waits for
+ * them all.
+ * */
+static void countingsort_run_tasks (struct ThreadPool* pool, ThreadPoolTaskFunc func,
+									struct CountingsortTask tasks[], const int ntasks) {
+	struct ThreadPoolGroup group;
+	threadpool_group_init (&group);
+
+	for (int t = 1; t < ntasks; ++t)
+		threadpool_submit (pool, &group, func, &tasks[t]);
+
+	func (&tasks[0]);
+	threadpool_wait (pool, &group);
+}
+
+/*
+ * Task finding the min/max of a block.
+ * */
+static void countingsort_min_max_task (void* arg) {
+	struct CountingsortTask* t = arg;
+	countingsort_min_max (t->job->arr, (int)t->first, (int)t->end - 1, &t->min, &t->max);
+}
+
+/*
+ * Task counting the elements of a block in the block histogram.
+ * */
+static void countingsort_count_task (void* arg) {
+	struct CountingsortTask* t = arg;
+	struct CountingsortJob* job = t->job;
+	int* count = job->hist + (size_t)t->block * job->range;
+
+	for (size_t i = t->first; i < t->end; ++i)
+		count[countingsort_index (job->arr[i], job->min)]++;
+}
+
+/*
+ * Task adding up the histograms of all blocks for a slice of values.
+ * */
+static void countingsort_merge_task (void* arg) {
+	struct CountingsortTask* t = arg;
+	struct CountingsortJob* job = t->job;
+	size_t total = 0;
+
+	for (size_t v = t->first; v < t->end; ++v) {
+		int c = job->hist[v];
+		for (int b = 1; b < job->nblocks; ++b)
+			c += job->hist[(size_t)b * job->range + v];
+		job->hist[v] = c;
+		total += c;
+	}
+	t->pos = total;
+}
+
+/*
+ * Task writing the elements of a slice of values.
+ * */
+static void countingsort_write_task (void* arg) {
+	struct CountingsortTask* t = arg;
+	struct CountingsortJob* job = t->job;
+	int* out = job->arr + t->pos;
+
+	for (size_t v = t->first; v < t->end; ++v) {
+		const int value = (int)(job->min + (long long)v);
+		for (int j = 0; j < job->hist[v]; j++)
+			*out++ = value;
+	}
+}
+
+/*
+ * Parallel counting sort of array[from..to] running on the threads of the given
+ * pool. Same as 'countingsort_sort_in_place ()' otherwise.
+ */
+void countingsort_sort_in_place_pool (int arr[], const int from, const int to,
+									  struct ThreadPool* pool)
+{
+	const int n = (to - from + 1);
+	const int nthreads = threadpool_num_threads (pool);
+
+	if (n <= countingsort_PARALLEL_CUTOFF || nthreads < 2) {
+		countingsort_sort_in_place (arr, from, to);
+		return;
+	}
+
+	struct CountingsortJob job;
+	job.arr = &arr[from];
+	struct CountingsortTask* tasks = sortstats_malloc (nthreads * sizeof (struct CountingsortTask));
+	if (tasks == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for parallel counting sort.");
+		abort ();
+	}
+
+	for (int t = 0; t < nthreads; ++t) {
+		tasks[t].job = &job;
+		tasks[t].block = t;
+		tasks[t].first = (size_t)n * t / nthreads;
+		tasks[t].end = (size_t)n * (t + 1) / nthreads;
+	}
+
+	// 1. Min/max of each block, then of the whole range
+	countingsort_run_tasks (pool, countingsort_min_max_task, tasks, nthreads);
+	int min = tasks[0].min;
+	int max = tasks[0].max;
+	for (int t = 1; t < nthreads; ++t) {
+		if (tasks[t].min < min)
+			min = tasks[t].min;
+		if (tasks[t].max > max)
+			max = tasks[t].max;
+	}
+
+	job.min = min;
+	job.range = countingsort_range (min, max);
+	if (job.range > (size_t)countingsort_MAX_RANGE_FACTOR * n) {
+		sortstats_free (tasks);
+		radixsortlsd_sort_i32 ((int32_t*)arr, from, to);
+		return;
+	}
+
+	// 2. Histogram of each block, with as many blocks as the memory budget allows
+	job.nblocks = nthreads;
+	while (job.nblocks > 1 &&
+		   (size_t)job.nblocks * job.range > (size_t)countingsort_HIST_FACTOR * n)
+		job.nblocks--;
+	job.hist = sortstats_calloc ((size_t)job.nblocks * job.range, sizeof (int));
+	if (job.hist == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for parallel counting sort.");
+		abort ();
+	}
+
+	for (int t = 0; t < job.nblocks; ++t) {
+		tasks[t].first = (size_t)n * t / job.nblocks;
+		tasks[t].end = (size_t)n * (t + 1) / job.nblocks;
+	}
+	countingsort_run_tasks (pool, countingsort_count_task, tasks, job.nblocks);
+
+	// 3. Totals of each slice of values
+	for (int t = 0; t < nthreads; ++t) {
+		tasks[t].first = job.range * t / nthreads;
+		tasks[t].end = job.range * (t + 1) / nthreads;
+	}
+	countingsort_run_tasks (pool, countingsort_merge_task, tasks, nthreads);
+
+	// 4. Slices totals to first positions, then write the values
+	size_t sum = 0;
+	for (int t = 0; t < nthreads; ++t) {
+		size_t count = tasks[t].pos;
+		tasks[t].pos = sum;
+		sum += count;
+	}
+	countingsort_run_tasks (pool, countingsort_write_task, tasks, nthreads);
+	SORTSTATS_MOVES (n);
+
+	sortstats_free (job.hist);
+	sortstats_free (tasks);
+}
+
+/*
+ * Parallel counting sort of array[from..to] with 'nthreads' threads (the number of
+ * online processors if 'nthreads' <= 0).
+ */
+void countingsort_sort_in_place_parallel (int arr[], const int from, const int to,
+										  const int nthreads)
+{
+	struct ThreadPool* pool = NULL;
+	if ((to - from + 1 > countingsort_PARALLEL_CUTOFF) && (nthreads != 1))
+		pool = threadpool_create (nthreads);
+
+	if (pool == NULL) {
+		countingsort_sort_in_place (arr, from, to);
+		return;
+	}
+
+	countingsort_sort_in_place_pool (arr, from, to, pool);
+	threadpool_destroy (pool);
+}
+
+
+/*
+ * Counting sort of items and records by key section.
+ *
+ * About:
+ *
+ *    The counting sorts above rebuild the values from the counts, so they can only
+ *    sort bare ints. To sort items (or records) by an integer key, the elements
+ *    themselves are moved:
+ *
+ *      1. The key of every element is computed once and kept, with the min/max keys.
+ *      2. The keys are counted in a histogram.
+ *      3. An exclusive prefix sum turns the counts into the first position of each
+ *         key.
+ *      4. The elements are scattered to a buffer in input order, so the sort is
+ *         stable, and the buffer is copied back.
+ *
+ *    The parallel version counts each block of elements in its own histogram, and
+ *    the prefix sum goes key by key, then block by block, so each block scatters
+ *    its elements to its own slots with no locks, keeping the sort stable.
+ *
+ *    Time is O(n + range) and the extra memory n elements, n keys and the
+ *    histograms, so it is meant for small keys ranges (status codes, days,
+ *    categories, ...). Ranges of keys wider than 'countingsort_HIST_FACTOR' times
+ *    the number of elements are sorted by a stable LSD radix sort of the computed
+ *    keys instead (sequential).
+ */
+
+// A stable counting sort of items or records by key, shared by its tasks
+struct CountingsortKeysJob {
+	char* base;							// first element
+	size_t size;						// bytes of each element
+	int items;							// 1 if elements are pointers to the items
+	CountingSortKeyFunc keyfunc;
+	int* keys;							// key of each element
+	char* buf;
+	int min;
+	size_t range;
+	size_t* hist;						// counts, then offsets, of each block key
+};
+
+// A block of elements processed by a task
+struct CountingsortKeysTask {
+	struct CountingsortKeysJob* job;
+	int block;							// block number (histogram row)
+	size_t first;						// first element
+	size_t end;							// element after the last one
+	int min;
+	int max;
+};
+
+/*
+ * Runs 'func' for every task, in parallel if a pool is given, and waits for them all.
+ * */
+static void countingsort_run_keys_tasks (struct ThreadPool* pool, ThreadPoolTaskFunc func,
+										 struct CountingsortKeysTask tasks[],
+										 const int ntasks) {
+	if (pool == NULL) {
+		for (int t = 0; t < ntasks; ++t)
+			func (&tasks[t]);
+		return;
+	}
+
+	struct ThreadPoolGroup group;
+	threadpool_group_init (&group);
+
+	for (int t = 1; t < ntasks; ++t)
+		threadpool_submit (pool, &group, func, &tasks[t]);
+
+	func (&tasks[0]);
+	threadpool_wait (pool, &group);
+}
+
+/*
+ * Task computing the keys of a block and their min/max.
+ * */
+static void countingsort_keys_task (void* arg) {
+	struct CountingsortKeysTask* t = arg;
+	struct CountingsortKeysJob* job = t->job;
+
+	for (size_t i = t->first; i < t->end; ++i) {
+		const void* e = job->base + i * job->size;
+		int key = job->keyfunc (job->items ? *(void* const*)e : e);
+		job->keys[i] = key;
+		if (i == t->first || key < t->min)
+			t->min = key;
+		if (i == t->first || key > t->max)
+			t->max = key;
+	}
+}
+
+/*
+ * Task counting the keys of a block in the block histogram.
+ * */
+static void countingsort_count_keys_task (void* arg) {
+	struct CountingsortKeysTask* t = arg;
+	struct CountingsortKeysJob* job = t->job;
+	size_t* count = job->hist + (size_t)t->block * job->range;
+
+	for (size_t i = t->first; i < t->end; ++i)
+		count[countingsort_index (job->keys[i], job->min)]++;
+}
+
+/*
+ * Task scattering the elements of a block to their slots in the buffer.
+ * */
+static void countingsort_scatter_task (void* arg) {
+	struct CountingsortKeysTask* t = arg;
+	struct CountingsortKeysJob* job = t->job;
+	size_t* offset = job->hist + (size_t)t->block * job->range;
+
+	if (job->items) {
+		void** src = (void**)job->base;
+		void** dst = (void**)job->buf;
+		for (size_t i = t->first; i < t->end; ++i)
+			dst[offset[countingsort_index (job->keys[i], job->min)]++] = src[i];
+		return;
+	}
+
+	for (size_t i = t->first; i < t->end; ++i) {
+		size_t pos = offset[countingsort_index (job->keys[i], job->min)]++;
+		memcpy (job->buf + pos * job->size, job->base + i * job->size, job->size);
+	}
+}
+
+/*
+ * Task copying a block of the buffer back to the array.
+ * */
+static void countingsort_copy_back_task (void* arg) {
+	struct CountingsortKeysTask* t = arg;
+	struct CountingsortKeysJob* job = t->job;
+
+	memcpy (job->base + t->first * job->size, job->buf + t->first * job->size,
+			(t->end - t->first) * job->size);
+}
+
+/*
+ * Returns the order-preserving unsigned key of a computed key.
+ * */
+static uint32_t countingsort_key_u32 (const void* item) {
+	return radixsortkey_key_i32 (*(const int*)item);
+}
+
+/*
+ * Stable LSD radix sort of the elements by the computed keys, for ranges too wide
+ * to count: the (key, index) pairs are sorted, and the elements are gathered to
+ * the buffer in their order.
+ * */
+static void countingsort_radix_keys (struct CountingsortKeysJob* job, const size_t n) {
+	int** order = sortstats_malloc (n * sizeof (int*));
+	if (order == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for counting sort.");
+		abort ();
+	}
+
+	for (size_t i = 0; i < n; ++i)
+		order[i] = &job->keys[i];
+	radixsortkey_sort_u32 ((void**)order, 0, (int)n - 1, countingsort_key_u32);
+
+	for (size_t i = 0; i < n; ++i) {
+		size_t src = (size_t)(order[i] - job->keys);
+		memcpy (job->buf + i * job->size, job->base + src * job->size, job->size);
+	}
+
+	sortstats_free (order);
+}
+
+/*
+ * Stable counting sort of 'n' elements of 'size' bytes at 'base' by the keys given
+ * by 'keyfunc', in parallel if a pool is given.
+ */
+static void countingsort_sort_keys (char* base, const size_t n, const size_t size,
+									const int items, CountingSortKeyFunc keyfunc,
+									struct ThreadPool* pool)
+{
+	if (n < 2)
+		return;
+
+	int nblocks = 1;
+	if (pool != NULL && n > (size_t)countingsort_PARALLEL_CUTOFF)
+		nblocks = threadpool_num_threads (pool);
+	if (nblocks < 2)
+		pool = NULL;
+
+	struct CountingsortKeysJob job;
+	job.base = base;
+	job.size = size;
+	job.items = items;
+	job.keyfunc = keyfunc;
+	job.keys = sortstats_malloc (n * sizeof (int));
+	job.buf = sortstats_malloc (n * size);
+	struct CountingsortKeysTask* tasks = sortstats_malloc (nblocks * sizeof (struct CountingsortKeysTask));
+	if (job.keys == NULL || job.buf == NULL || tasks == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for counting sort.");
+		abort ();
+	}
+
+	for (int t = 0; t < nblocks; ++t) {
+		tasks[t].job = &job;
+		tasks[t].block = t;
+		tasks[t].first = n * t / nblocks;
+		tasks[t].end = n * (t + 1) / nblocks;
+	}
+
+	// 1. Keys of each block, then min/max of all keys
+	countingsort_run_keys_tasks (pool, countingsort_keys_task, tasks, nblocks);
+	int min = tasks[0].min;
+	int max = tasks[0].max;
+	for (int t = 1; t < nblocks; ++t) {
+		if (tasks[t].min < min)
+			min = tasks[t].min;
+		if (tasks[t].max > max)
+			max = tasks[t].max;
+	}
+	job.min = min;
+	job.range = countingsort_range (min, max);
+
+	// Too wide a range: the histogram would cost more than the elements
+	if (job.range > (size_t)countingsort_HIST_FACTOR * n) {
+		countingsort_radix_keys (&job, n);
+		job.hist = NULL;
+	}
+	else {
+		// 2. Histogram of each block, with as many blocks as the memory budget allows
+		int ncount = nblocks;
+		while (ncount > 1 && (size_t)ncount * job.range > (size_t)countingsort_HIST_FACTOR * n)
+			ncount--;
+		job.hist = sortstats_calloc ((size_t)ncount * job.range, sizeof (size_t));
+		if (job.hist == NULL) {
+			fprintf (stderr, "Error: failed to allocate memory for counting sort histogram.");
+			abort ();
+		}
+
+		for (int t = 0; t < ncount; ++t) {
+			tasks[t].first = n * t / ncount;
+			tasks[t].end = n * (t + 1) / ncount;
+		}
+		countingsort_run_keys_tasks (pool, countingsort_count_keys_task, tasks, ncount);
+
+		// 3. Histograms to exclusive offsets, key by key then block by block
+		size_t sum = 0;
+		for (size_t v = 0; v < job.range; ++v) {
+			for (int t = 0; t < ncount; ++t) {
+				size_t* h = &job.hist[(size_t)t * job.range + v];
+				size_t count = *h;
+				*h = sum;
+				sum += count;
+			}
+		}
+
+		// 4. Scatter each block to its slots
+		countingsort_run_keys_tasks (pool, countingsort_scatter_task, tasks, ncount);
+	}
+
+	// 5. Copy the buffer back
+	for (int t = 0; t < nblocks; ++t) {
+		tasks[t].first = n * t / nblocks;
+		tasks[t].end = n * (t + 1) / nblocks;
+	}
+	countingsort_run_keys_tasks (pool, countingsort_copy_back_task, tasks, nblocks);
+	SORTSTATS_MOVES (2 * n);		// to the buffer and back
+
+	sortstats_free (job.hist);
+	sortstats_free (tasks);
+	sortstats_free (job.buf);
+	sortstats_free (job.keys);
+}
+
+/*
+ * Stable counting sort of the items pointed by arr[from..to] by the integer keys
+ * given by 'keyfunc' (called with the item pointers).
+ */
+void countingsort_sort_items (void* arr[], const int from, const int to,
+							  CountingSortKeyFunc keyfunc)
+{
+	if (to > from)
+		countingsort_sort_keys ((char*)&arr[from], (size_t)(to - from + 1), sizeof (void*),
+								1, keyfunc, NULL);
+}
+
+/*
+ * Parallel stable counting sort of the items pointed by arr[from..to] running on the
+ * threads of the given pool.
+ */
+void countingsort_sort_items_pool (void* arr[], const int from, const int to,
+								   CountingSortKeyFunc keyfunc, struct ThreadPool* pool)
+{
+	if (to > from)
+		countingsort_sort_keys ((char*)&arr[from], (size_t)(to - from + 1), sizeof (void*),
+								1, keyfunc, pool);
+}
+
+/*
+ * Parallel stable counting sort of the items pointed by arr[from..to] with
+ * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
+ */
+void countingsort_sort_items_parallel (void* arr[], const int from, const int to,
+									   CountingSortKeyFunc keyfunc, const int nthreads)
+{
+	struct ThreadPool* pool = NULL;
+	if ((to - from + 1 > countingsort_PARALLEL_CUTOFF) && (nthreads != 1))
+		pool = threadpool_create (nthreads);
+
+	if (pool == NULL) {
+		countingsort_sort_items (arr, from, to, keyfunc);
+		return;
+	}
+
+	countingsort_sort_items_pool (arr, from, to, keyfunc, pool);
+	threadpool_destroy (pool);
+}
+
+/*
+ * Stable counting sort of an array of 'n' records of 'size' bytes each, starting at
+ * 'base', by the integer keys given by 'keyfunc' (called with the records pointers).
+ */
+void countingsort_sort_records (void* base, const size_t n, const size_t size,
+								CountingSortKeyFunc keyfunc)
+{
+	countingsort_sort_keys (base, n, size, 0, keyfunc, NULL);
+}
+
+/*
+ * Parallel stable counting sort of an array of records running on the threads of
+ * the given pool.
+ */
+void countingsort_sort_records_pool (void* base, const size_t n, const size_t size,
+									 CountingSortKeyFunc keyfunc, struct ThreadPool* pool)
+{
+	countingsort_sort_keys (base, n, size, 0, keyfunc, pool);
+}
+
+/*
+ * Parallel stable counting sort of an array of records with 'nthreads' threads (the
+ * number of online processors if 'nthreads' <= 0).
+ */
+void countingsort_sort_records_parallel (void* base, const size_t n, const size_t size,
+										 CountingSortKeyFunc keyfunc, const int nthreads)
+{
+	struct ThreadPool* pool = NULL;
+	if ((n > (size_t)countingsort_PARALLEL_CUTOFF) && (nthreads != 1))
+		pool = threadpool_create (nthreads);
+
+	if (pool == NULL) {
+		countingsort_sort_records (base, n, size, keyfunc);
+		return;
+	}
+
+	countingsort_sort_records_pool (base, n, size, keyfunc, pool);
+	threadpool_destroy (pool);
+}
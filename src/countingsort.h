@@ -9,30 +9,116 @@
 #ifndef COUNTINGSORT_H_
 	#define COUNTINGSORT_H_
 
+	#include <stddef.h>
+	#include "sort.h"
+	#include "threadpool.h"
+	#include "sortapi.h"
+
 	/*
 	 * Function to sort array[from..to] with Counting sort algorithm with
 	 * given min and max values.
+	 * The histogram of max-min+1 counters is allocated on the heap.
 	 */
-	void countingsort_sort_in_place_mm (int arr[], const int from, const int to,
-							   const int min, const int max);
+	SORT_API void countingsort_sort_in_place_mm (int arr[], const int from, const int to,
+										const int min, const int max);
+
+	/*
+	 * Function to sort array[from..to] with Counting sort algorithm with
+	 * given min and max values, counting in the caller provided histogram 'count'
+	 * of max-min+1 ints (it doesn't have to be zeroed, so it can be reused).
+	 */
+	SORT_API void countingsort_sort_in_place_with_buffer (int arr[], const int from, const int to,
+														  const int min, const int max, int count[]);
 
 	/*
 	 * Function to sort array[from..to] with Counting sort algorithm.
+	 * When the range of values is wider than the number of elements, the histogram
+	 * would cost more than the elements and the array is sorted by LSD radix sort
+	 * instead.
+	 */
+	SORT_API void countingsort_sort_in_place (int arr[], const int from, const int to);
+
+	/*
+	 * Parallel counting sort of array[from..to] running on the threads of the given
+	 * pool. Same as 'countingsort_sort_in_place ()' otherwise.
+	 */
+	SORT_API void countingsort_sort_in_place_pool (int arr[], const int from, const int to,
+												   struct ThreadPool* pool);
+
+	/*
+	 * Parallel counting sort of array[from..to] with 'nthreads' threads (the number
+	 * of online processors if 'nthreads' <= 0).
+	 * Each thread counts a block of elements in its own histogram, the histograms
+	 * are merged by slices of values and each thread writes the values of a slice.
+	 * Falls back to LSD radix sort like 'countingsort_sort_in_place ()'.
 	 */
-	void countingsort_sort_in_place (int arr[], const int from, const int to);
+	SORT_API void countingsort_sort_in_place_parallel (int arr[], const int from, const int to,
+													   const int nthreads);
 
 	/*
 	 * Counting sort function (not in place version)
 	 * Sorts array elements at indexes [from..to].
 	 * */
-	int* countingsort_sort_mm (int arr[], const int n, const int from, const int to,
-							   const int min, const int max);
+	SORT_API int* countingsort_sort_mm (int arr[], const int n, const int from, const int to,
+										const int min, const int max);
 
 	/*
 	 * Counting sort function (not in place version)
 	 * Sorts array elements at indexes [from..to].
+	 * Falls back to LSD radix sort like 'countingsort_sort_in_place ()'.
 	 * */
-	int* countingsort_sort (int arr[], const int n, const int from, const int to);
+	SORT_API int* countingsort_sort (int arr[], const int n, const int from, const int to);
+
+	/*
+	 * Stable counting sort of the items pointed by arr[from..to] by the integer keys
+	 * given by 'keyfunc' (called with the item pointers).
+	 * Elements with equal keys keep their order. Time is O(n + range of keys) and
+	 * the extra memory n pointers, n keys and range counters, so it is meant for
+	 * small ranges of keys (status codes, days of the week, categories, ...).
+	 * Ranges of keys wider than 4 times the number of elements are sorted by a
+	 * stable LSD radix sort of the keys instead.
+	 */
+	SORT_API void countingsort_sort_items (void* arr[], const int from, const int to,
+										   CountingSortKeyFunc keyfunc);
 
+	/*
+	 * Parallel stable counting sort of the items pointed by arr[from..to] running on
+	 * the threads of the given pool.
+	 */
+	SORT_API void countingsort_sort_items_pool (void* arr[], const int from, const int to,
+												CountingSortKeyFunc keyfunc, struct ThreadPool* pool);
+
+	/*
+	 * Parallel stable counting sort of the items pointed by arr[from..to] with
+	 * 'nthreads' threads (the number of online processors if 'nthreads' <= 0).
+	 * Each thread counts the keys of a block of elements in its own histogram and
+	 * scatters its block to its own slots, so the sort stays stable.
+	 */
+	SORT_API void countingsort_sort_items_parallel (void* arr[], const int from, const int to,
+													CountingSortKeyFunc keyfunc, const int nthreads);
+
+	/*
+	 * Stable counting sort of an array of 'n' records of 'size' bytes each, starting
+	 * at 'base', by the integer keys given by 'keyfunc' (called with the records
+	 * pointers). Records are moved with memcpy, the extra memory is n records.
+	 */
+	SORT_API void countingsort_sort_records (void* base, const size_t n, const size_t size,
+											 CountingSortKeyFunc keyfunc);
+
+	/*
+	 * Parallel stable counting sort of an array of records running on the threads
+	 * of the given pool.
+	 */
+	SORT_API void countingsort_sort_records_pool (void* base, const size_t n, const size_t size,
+												  CountingSortKeyFunc keyfunc,
+												  struct ThreadPool* pool);
+
+	/*
+	 * Parallel stable counting sort of an array of records with 'nthreads' threads
+	 * (the number of online processors if 'nthreads' <= 0).
+	 */
+	SORT_API void countingsort_sort_records_parallel (void* base, const size_t n, const size_t size,
+													  CountingSortKeyFunc keyfunc,
+													  const int nthreads);
 
 #endif /* COUNTINGSORT_H_ */
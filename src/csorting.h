@@ -0,0 +1,59 @@
+/*
+ * csorting.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Umbrella header of the library: includes all the public headers.
+ *
+ * 	Programs linked with libcsorting.a or libcsorting.so include this header only:
+ *
+ * 		#include <csorting/csorting.h>
+ *
+ * 		gcc -O2 prog.c -lcsorting -lpthread -lm
+ */
+
+#ifndef CSORTING_H_
+	#define CSORTING_H_
+
+	#include "sortapi.h"
+	#include "sort.h"
+	#include "sortauto.h"
+	#include "threadpool.h"
+	#include "sortstats.h"
+
+	// Arrays of pointers and arrays of values
+	#include "selectionsort.h"
+	#include "bubblesort.h"
+	#include "insertionsort.h"
+	#include "combsort.h"
+	#include "shellsort.h"
+	#include "quicksort.h"
+	#include "twayquicksort.h"
+	#include "mergesort.h"
+	#include "heapsort.h"
+	#include "timsort.h"
+	#include "introsort.h"
+	#include "pdqsort.h"
+	#include "samplesort.h"
+	#include "treesort.h"
+	#include "bucketsort.h"
+
+	// Integer, floating point and string keys
+	#include "countingsort.h"
+	#include "radixsortlsd.h"
+	#include "radixsortmsd.h"
+	#include "radixsortstr.h"
+	#include "radixsortkey.h"
+	#include "sorttyped.h"
+	#include "argsort.h"
+	#include "kvsort.h"
+
+	// Linked lists
+	#include "linkedlist.h"
+	#include "llsort.h"
+	#include "bubblesortll.h"
+	#include "insertionsortll.h"
+	#include "quicksortll.h"
+	#include "mergesortll.h"
+
+#endif /* CSORTING_H_ */
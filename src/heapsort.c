@@ -69,6 +69,7 @@
 
 #include <stdlib.h>
 #include "sort.h"
+#include "heapsort.h"
 
 /*
  * Function build Max Heap where value of each child is always smaller
@@ -141,3 +142,52 @@ void heapsort_sort (void* arr[], int from, int to, SortCompareFunc comparefunc)
 }
 
 
+
+/*
+ * Moves the element at index i of the max heap base[0..n[ down until both of its
+ * children are smaller (contiguous values version).
+ */
+static void heapsort_values_sift_down (char* base, size_t i, const size_t n,
+									   const size_t size, SortCompareFunc comparefunc)
+{
+	size_t child;
+
+	// Note: left child of i is 2 * i + 1
+	while ((child = 2 * i + 1) < n) {
+		// point to the bigger child
+		if ((child + 1 < n) &&
+				(comparefunc (base + child * size, base + (child + 1) * size) < 0))
+			child++;
+
+		if (!(comparefunc (base + i * size, base + child * size) < 0))
+			break;
+
+		sort_swap_values (base + i * size, base + child * size, size);
+		i = child;
+	}
+}
+
+/*
+ * Sorts 'n' contiguous elements of 'size' bytes each starting at 'base' using the
+ * heap sort algorithm.
+ * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+ * Time:  O(N log(N))
+ * Space: O(1)
+ */
+void heapsort_sort_values (void* base, const size_t n, const size_t size,
+						   SortCompareFunc comparefunc)
+{
+	char* arr = base;
+	if (n < 2)
+		return;
+
+	// Build max heap, sifting down every parent node
+	for (size_t i = n / 2; i-- > 0; )
+		heapsort_values_sift_down (arr, i, n, size, comparefunc);
+
+	// Move the root (biggest element) after the heap and restore heap property
+	for (size_t i = n - 1; i > 0; i--) {
+		sort_swap_values (arr, arr + i * size, size);
+		heapsort_values_sift_down (arr, 0, i, size, comparefunc);
+	}
+}
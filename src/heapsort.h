@@ -11,12 +11,21 @@
 
 	#include <stdlib.h>
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
 	 * Sorts an array or part of an array using heap sort algorithm (iteractiva version).
 	 * 'from' and 'to' are inclusive array bounds to sort.
 	 */
-	void heapsort_sort (void* arr[], const int from, const int to,
-						SortCompareFunc comparefunc);
+	SORT_API void heapsort_sort (void* arr[], const int from, const int to,
+								 SortCompareFunc comparefunc);
+
+	/*
+	 * Sorts 'n' contiguous elements of 'size' bytes each starting at 'base' using the
+	 * heap sort algorithm.
+	 * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+	 */
+	SORT_API void heapsort_sort_values (void* base, const size_t n, const size_t size,
+										SortCompareFunc comparefunc);
 
 #endif /* HEAPSORT_H_ */
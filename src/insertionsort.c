@@ -64,7 +64,11 @@
  * Source: https://www.geeksforgeeks.org/insertion-sort/?ref=lbp
  */
 
+#include <stdio.h>
+#include <string.h>
 #include "sort.h"
+#include "insertionsort.h"
+#include "sortstats.h"
 
 /*
  * Sorts an array or part of an array items [from..to] using the insertion sort algorithm.
@@ -79,14 +83,60 @@ void insertionsort_sort (void* arr[], const int from, const int to,
 		key = arr[i];
 		j = i - 1;
 
-		// Move elements of arr[0..i-1], that are
+		// Move elements of arr[from..i-1], that are
 		// greater than key, to one position ahead
 		// of their current position
-		while ((j >= 0) && (comparefunc (arr[j], key) > 0)) {
+		while ((j >= from) && (comparefunc (arr[j], key) > 0)) {
 			arr[j + 1] = arr[j];
 			j = j - 1;
 		}
 
 		arr[j + 1] = key;
+		SORTSTATS_MOVES (i - j);
 	}
 }
+
+/*
+ * Sorts 'n' contiguous elements of 'size' bytes each starting at 'base' using the
+ * insertion sort algorithm.
+ * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+ */
+void insertionsort_sort_values (void* base, const size_t n, const size_t size,
+								SortCompareFunc comparefunc)
+{
+	char* arr = base;
+	unsigned char keybuf[128];
+	void* key = keybuf;
+
+	if (n < 2)
+		return;
+
+	// Elements bigger than the local buffer need a heap allocated key
+	if (size > sizeof (keybuf)) {
+		key = sortstats_malloc (size);
+		if (key == NULL) {
+			fprintf (stderr, "Error: failed to allocate memory for insertion sort.");
+			abort ();
+		}
+	}
+
+	for (size_t i = 1; i < n; ++i) {
+		char* cur = arr + i * size;
+		if (!(comparefunc (cur - size, cur) > 0))
+			continue;
+
+		// Find where the key goes, then shift greater elements one position ahead
+		// with a single move
+		size_t j = i - 1;
+		while ((j > 0) && (comparefunc (arr + (j - 1) * size, cur) > 0))
+			j--;
+
+		memcpy (key, cur, size);
+		memmove (arr + (j + 1) * size, arr + j * size, (i - j) * size);
+		memcpy (arr + j * size, key, size);
+		SORTSTATS_MOVES (i - j + 1);
+	}
+
+	if (key != keybuf)
+		sortstats_free (key);
+}
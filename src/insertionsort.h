@@ -10,12 +10,21 @@
 	#define INSERTIONSORT_H_
 
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
 	 * Sorts an array or part of an array items [from..to] using the insertion sort algorithm.
 	 * Note: from (inclusive) .. to (inclusive)
 	 */
-	void insertionsort_sort (void* arr[], const int from, const int to,
-							 SortCompareFunc comparefunc);
+	SORT_API void insertionsort_sort (void* arr[], const int from, const int to,
+									  SortCompareFunc comparefunc);
+
+	/*
+	 * Sorts 'n' contiguous elements of 'size' bytes each starting at 'base' using the
+	 * insertion sort algorithm.
+	 * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+	 */
+	SORT_API void insertionsort_sort_values (void* base, const size_t n, const size_t size,
+											 SortCompareFunc comparefunc);
 
 #endif /* INSERTIONSORT_H_ */
@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include "llsort.h"
 #include "sort.h"
+#include "insertionsortll.h"
 #include <assert.h>
 #include "linkedlist.h"
 
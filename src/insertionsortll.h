@@ -11,10 +11,11 @@
 
 	#include "sort.h"
 	#include "linkedlist.h"
+	#include "sortapi.h"
 
 	/*
 	 * Function to sort a singly linked list using insertion sort.
 	 */
-	void insertionsortll_sort (struct LinkedList* list, SortCompareFunc comparefunc);
+	SORT_API void insertionsortll_sort (struct LinkedList* list, SortCompareFunc comparefunc);
 
 #endif /* INSERTIONSORTLL_H_ */
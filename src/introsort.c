@@ -91,6 +91,10 @@
 
 #include <math.h>
 #include "sort.h"
+#include "introsort.h"
+#include "heapsort.h"
+#include "insertionsort.h"
+#include "sortstats.h"
 
 /*
  * To maxHeap a subtree rooted with node i which is an index
@@ -116,10 +120,12 @@ static void introsort_max_heap (void* arr[],
 			break;
 
 		arr[begin + i - 1] = arr[begin + child - 1];
+		SORTSTATS_MOVES (1);
 		i = child;
 	}
 
 	arr[begin + i - 1] = temp;
+	SORTSTATS_MOVES (1);
 }
 
 /*
@@ -141,21 +147,22 @@ static void introsort_heapify (void* arr[],
 static void introsort_heapsort (void* arr[], int begin,
                       	  	  	int end, SortCompareFunc comparefunc)
 {
-	int heapN = end - begin;
+	// Note: 'end' is inclusive
+	int heapN = end - begin + 1;
 
 	// Build heap (rearrange array)
 	introsort_heapify (arr, begin, end, heapN, comparefunc);
 
 	// One by one extract an element
 	// from heap
-	for (int i = heapN; i >= 1; i--)
+	for (int i = heapN; i > 1; i--)
 	{
 		// Move current root to end
-		sort_swap (&arr[begin], &arr[begin + i]);
+		sort_swap (&arr[begin], &arr[begin + i - 1]);
 
 		// call maxHeap() on the
 		// reduced heap
-		introsort_max_heap (arr, 1, i, begin, comparefunc);
+		introsort_max_heap (arr, 1, i - 1, begin, comparefunc);
 	}
 }
 
@@ -177,15 +184,16 @@ static void introsort_insertionsort (void* arr[], int from, int to,
             j = j - 1;
         }
         arr[j + 1] = key;
+        SORTSTATS_MOVES (i - j);
     }
 
     return;
 }
 
 /*
- * Function for finding the median of the three elements.
+ * Function for finding the index of the median of the three elements.
  */
-static void* introsort_find_pivot (void* arr[], int a1,
+static int introsort_find_pivot (void* arr[], int a1,
                       	  	  	   int b1, int c1, SortCompareFunc comparefunc)
 {
 	void* a = arr[a1];
@@ -193,24 +201,24 @@ static void* introsort_find_pivot (void* arr[], int a1,
 	void* c = arr[c1];
 
 	if ((comparefunc (a, b) < 0) && (comparefunc (b, c) < 0))
-		return (b);
+		return (b1);
 
 	if ((comparefunc (a, c) < 0) && (!(comparefunc (c, b) > 0)))
-		return (c);
+		return (c1);
 
 	if ((!(comparefunc (b, a) > 0)) && (comparefunc (a, c) < 0))
-		return (a);
+		return (a1);
 
 	if ((comparefunc (b, c) < 0) && (!(comparefunc (c, a) > 0)))
-		return (c);
+		return (c1);
 
 	if ((!(comparefunc (c, a) > 0)) && (comparefunc (a, b) < 0))
-		return (a);
+		return (a1);
 
 	if ((!(comparefunc (c, b) > 0)) && (!(comparefunc (b, a) > 0)))
-		return (b);
+		return (b1);
 
-	return NULL;	// Sould never happen!
+	return b1;	// Sould never happen!
 }
 
 /*
@@ -266,9 +274,9 @@ static void introsort_sort_rec (void* arr[],
 		introsort_heapsort (arr, from, to, comparefunc);
 	}
 	else {
-		void* pivot = introsort_find_pivot (arr, from, from + ((to - from) / 2) + 1, to,
-										    comparefunc);
-		sort_swap (&pivot, &arr[to]);
+		int pivot = introsort_find_pivot (arr, from, from + ((to - from) / 2) + 1, to,
+										  comparefunc);
+		sort_swap (&arr[pivot], &arr[to]);
 
 		// p is partitioning index,
 		// arr[p] is now at right place
@@ -294,3 +302,66 @@ void introsort_sort (void* arr[], int from, int to, SortCompareFunc comparefunc)
 	return;
 }
 
+
+
+/*
+ * Contiguous values section.
+ *
+ * Same algorithm for arrays of fixed size elements stored one after the other
+ * (like 'qsort ()'). Partitioning uses Hoare's scheme around the median of three,
+ * that swaps less elements than Lomuto's since each swap moves a whole element.
+ */
+
+// Partitions up to this size are sorted with insertion sort
+static const size_t introsort_VALUES_INSERTION_SORT = 16;
+
+/*
+ * Introsort main loop for contiguous values.
+ */
+static void introsort_values_rec (char* base, size_t n, const size_t size,
+								  int depthLimit, SortCompareFunc comparefunc)
+{
+	while (n > introsort_VALUES_INSERTION_SORT) {
+		if (depthLimit == 0) {
+			// if the recursion limit is
+			// occurred call heap sort
+			heapsort_sort_values (base, n, size, comparefunc);
+			return;
+		}
+		depthLimit--;
+
+		size_t p = sort_partition_values (base, n, size, comparefunc);
+
+		// Recurse on the smaller side, loop on the bigger one
+		if (p < n - p - 1) {
+			introsort_values_rec (base, p, size, depthLimit, comparefunc);
+			base += (p + 1) * size;
+			n -= p + 1;
+		}
+		else {
+			introsort_values_rec (base + (p + 1) * size, n - p - 1, size, depthLimit,
+								  comparefunc);
+			n = p;
+		}
+	}
+
+	// if the data set is small,
+	// call insertion sort
+	insertionsort_sort_values (base, n, size, comparefunc);
+}
+
+/*
+ *  Implementation of introsort for 'n' contiguous elements of 'size' bytes each
+ *  starting at 'base'.
+ *  Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+ **/
+void introsort_sort_values (void* base, const size_t n, const size_t size,
+							SortCompareFunc comparefunc)
+{
+	// depthLimit = 2 * floor(log2(n))
+	int depthLimit = 0;
+	for (size_t m = n; m > 1; m >>= 1)
+		depthLimit += 2;
+
+	introsort_values_rec (base, n, size, depthLimit, comparefunc);
+}
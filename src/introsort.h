@@ -10,11 +10,22 @@
 	#define INTROSORT_H_
 
     #include "sort.h"
+    #include "sortapi.h"
 
 	/*
 	 *  Implementation of introsort
+	 *  Note: 'pdqsort_sort ()' (pdqsort.h) is a drop-in replacement that handles
+	 *  	  sorted, reversed and many repeated keys inputs much better.
 	 **/
-	void introsort_sort (void* arr[], int from, int to,
-						 SortCompareFunc comparefunc);
+	SORT_API void introsort_sort (void* arr[], int from, int to,
+								  SortCompareFunc comparefunc);
+
+	/*
+	 *  Implementation of introsort for 'n' contiguous elements of 'size' bytes each
+	 *  starting at 'base'.
+	 *  Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+	 **/
+	SORT_API void introsort_sort_values (void* base, const size_t n, const size_t size,
+										 SortCompareFunc comparefunc);
 
 #endif /* INTROSORT_H_ */
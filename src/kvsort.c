@@ -0,0 +1,223 @@
+/*
+ * kvsort.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements the key/value sort of structure of arrays (columnar) data.
+ *
+ * About:
+ *
+ * 	Columnar data keeps the keys in one array and each field of the payload in its
+ * 	own array. Sorting it with the generic sorts needs an array of pointers to
+ * 	structs built just for the sort, and a comparison through two pointers and a
+ * 	function call.
+ *
+ *
+ * Algorithm:
+ *
+ * 	1. The sorted order of the keys is computed as an array of indexes:
+ *
+ * 		- Arrays up to a cutoff: (key, index) pairs are sorted by introsort, or by
+ * 		  mergesort if stable, generated by sortdef.h with the comparison inlined.
+ *
+ * 		- Bigger arrays: radix argsort of the keys (see argsort.c), which is stable.
+ *
+ * 	2. The keys and each payload array are permuted by gathering their elements in
+ * 	   the sorted order into a buffer, that is copied back to the array. The buffer
+ * 	   is allocated once for the biggest element size and reused for all arrays.
+ * 	   Gathering reads the elements in random order but writes the buffer in
+ * 	   sequence, and is faster than following the cycles of the permutation in place.
+ *
+ *
+ * Time Complexity: O(n * w) for big arrays where w is the number of bytes of the key,
+ * 					O(n log n) for small arrays
+ *
+ * Auxiliary Space: O(n)
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "kvsort.h"
+#include "argsort.h"
+#include "radixsortlsd.h"
+#include "sortdef.h"
+#include "sortstats.h"
+
+/*
+ * Arrays smaller than this are sorted with the comparison sorts, bigger ones with
+ * radix argsort.
+ */
+static const int kvsort_RADIX_CUTOFF = 64;
+
+/*
+ * Returns a buffer of 'n' elements of 'size' bytes or aborts if it can't be allocated.
+ */
+static void* kvsort_alloc (const size_t n, const size_t size)
+{
+	void* buf = sortstats_malloc (n * size);
+	if (buf == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for key/value sort buffer.");
+		abort ();
+	}
+	return buf;
+}
+
+/*
+ * Defines the functions of index type 'itype':
+ *
+ * 	static void kvsort_gather_##bits (data, n, size, idx, tmp)
+ * 		Moves the element idx[i] of data[0..n-1] to position i, through 'tmp'.
+ *
+ * 	static void kvsort_permute_##bits (keys, keysize, n, payloads, npayloads, idx)
+ * 		Gathers the keys (if not NULL) and all payload arrays.
+ */
+#define KVSORT_DEFINE_INDEX_(bits, itype) \
+	static void kvsort_gather_##bits (void* data, const size_t n, const size_t size, \
+									  const itype idx[], void* tmp) \
+	{ \
+		char* d = data; \
+		char* t = tmp; \
+	\
+		/* Constant sizes are copied by a single load and store */ \
+		switch (size) { \
+		case 1: \
+			for (size_t i = 0; i < n; i++) \
+				memcpy (t + i, d + (size_t)idx[i], 1); \
+			break; \
+		case 2: \
+			for (size_t i = 0; i < n; i++) \
+				memcpy (t + i * 2, d + (size_t)idx[i] * 2, 2); \
+			break; \
+		case 4: \
+			for (size_t i = 0; i < n; i++) \
+				memcpy (t + i * 4, d + (size_t)idx[i] * 4, 4); \
+			break; \
+		case 8: \
+			for (size_t i = 0; i < n; i++) \
+				memcpy (t + i * 8, d + (size_t)idx[i] * 8, 8); \
+			break; \
+		default: \
+			for (size_t i = 0; i < n; i++) \
+				memcpy (t + i * size, d + (size_t)idx[i] * size, size); \
+			break; \
+		} \
+	\
+		memcpy (data, tmp, n * size); \
+		SORTSTATS_MOVES (2 * n);		/* to the buffer and back */ \
+	} \
+	\
+	static void kvsort_permute_##bits (void* keys, const size_t keysize, const size_t n, \
+									   struct KvsortPayload payloads[], \
+									   const int npayloads, const itype idx[]) \
+	{ \
+		size_t maxsize = (keys != NULL) ? keysize : 0; \
+		for (int p = 0; p < npayloads; p++) \
+			if (payloads[p].size > maxsize) \
+				maxsize = payloads[p].size; \
+		if (maxsize == 0) \
+			return; \
+	\
+		void* tmp = kvsort_alloc (n, maxsize); \
+	\
+		if (keys != NULL) \
+			kvsort_gather_##bits (keys, n, keysize, idx, tmp); \
+		for (int p = 0; p < npayloads; p++) \
+			kvsort_gather_##bits (payloads[p].data, n, payloads[p].size, idx, tmp); \
+	\
+		sortstats_free (tmp); \
+	}
+
+KVSORT_DEFINE_INDEX_ (32, int32_t)
+KVSORT_DEFINE_INDEX_ (64, int64_t)
+
+/*
+ * Radix argsorts of floats and doubles with -0.0 equal to +0.0, as the comparison.
+ */
+static void kvsort_argsort_float (const float keys[], const size_t n, int32_t idx[])
+{
+	argsort_radix_float (keys, n, idx, RADIXSORTLSD_ZEROS_EQUAL);
+}
+
+static void kvsort_argsort_float_64 (const float keys[], const size_t n, int64_t idx[])
+{
+	argsort_radix_float_64 (keys, n, idx, RADIXSORTLSD_ZEROS_EQUAL);
+}
+
+static void kvsort_argsort_double (const double keys[], const size_t n, int32_t idx[])
+{
+	argsort_radix_double (keys, n, idx, RADIXSORTLSD_ZEROS_EQUAL);
+}
+
+static void kvsort_argsort_double_64 (const double keys[], const size_t n, int64_t idx[])
+{
+	argsort_radix_double_64 (keys, n, idx, RADIXSORTLSD_ZEROS_EQUAL);
+}
+
+/*
+ * Defines 'void kvsort_sort_##suffix (keys, n, payloads, npayloads, stable)' for keys
+ * of 'type', compared by 'less_expr' on 'a' and 'b' and radix argsorted by
+ * 'argsort32' and 'argsort64' (32 and 64 bits indexes).
+ */
+#define KVSORT_DEFINE_(suffix, type, less_expr, argsort32, argsort64) \
+	struct kvsort_##suffix##_Pair { \
+		type key; \
+		int32_t index; \
+	}; \
+	\
+	SORT_DEFINE (kvsort_##suffix##_pairs, struct kvsort_##suffix##_Pair, less_expr) \
+	\
+	void kvsort_sort_##suffix (type keys[], const size_t n, struct KvsortPayload payloads[], \
+							   const int npayloads, const int stable) \
+	{ \
+		if (n < 2) \
+			return; \
+	\
+		if (n < (size_t)kvsort_RADIX_CUTOFF) { \
+			struct kvsort_##suffix##_Pair* pairs = kvsort_alloc (n, sizeof (*pairs)); \
+			int32_t* idx = kvsort_alloc (n, sizeof (int32_t)); \
+	\
+			for (size_t i = 0; i < n; i++) { \
+				pairs[i].key = keys[i]; \
+				pairs[i].index = (int32_t)i; \
+			} \
+	\
+			if (stable) \
+				kvsort_##suffix##_pairs_mergesort (pairs, n); \
+			else \
+				kvsort_##suffix##_pairs_introsort (pairs, n); \
+	\
+			for (size_t i = 0; i < n; i++) { \
+				keys[i] = pairs[i].key; \
+				idx[i] = pairs[i].index; \
+			} \
+			SORTSTATS_MOVES (2 * n);		/* to the pairs and back */ \
+	\
+			sortstats_free (pairs); \
+			kvsort_permute_32 (NULL, 0, n, payloads, npayloads, idx); \
+			sortstats_free (idx); \
+		} \
+		else if (n <= (size_t)INT32_MAX) { \
+			int32_t* idx = kvsort_alloc (n, sizeof (int32_t)); \
+			argsort32 (keys, n, idx); \
+			kvsort_permute_32 (keys, sizeof (type), n, payloads, npayloads, idx); \
+			sortstats_free (idx); \
+		} \
+		else { \
+			int64_t* idx = kvsort_alloc (n, sizeof (int64_t)); \
+			argsort64 (keys, n, idx); \
+			kvsort_permute_64 (keys, sizeof (type), n, payloads, npayloads, idx); \
+			sortstats_free (idx); \
+		} \
+	}
+
+KVSORT_DEFINE_ (i32, int32_t, a.key < b.key, argsort_radix_i32, argsort_radix_i32_64)
+KVSORT_DEFINE_ (u32, uint32_t, a.key < b.key, argsort_radix_u32, argsort_radix_u32_64)
+KVSORT_DEFINE_ (i64, int64_t, a.key < b.key, argsort_radix_i64, argsort_radix_i64_64)
+KVSORT_DEFINE_ (u64, uint64_t, a.key < b.key, argsort_radix_u64, argsort_radix_u64_64)
+KVSORT_DEFINE_ (float, float, SORT_LESS_NAN_LAST (a.key, b.key),
+				kvsort_argsort_float, kvsort_argsort_float_64)
+KVSORT_DEFINE_ (double, double, SORT_LESS_NAN_LAST (a.key, b.key),
+				kvsort_argsort_double, kvsort_argsort_double_64)
@@ -0,0 +1,74 @@
+/*
+ * kvsort.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the key/value sort of structure of arrays (columnar)
+ * 				data: an array of keys is sorted and any number of payload arrays are
+ * 				permuted in step with it.
+ *
+ * 	For each key type suffix (i32, u32, i64, u64, float, double) the function
+ *
+ * 		kvsort_sort_suffix (keys, n, payloads, npayloads, stable)
+ *
+ * 	sorts keys[0..n-1] in ascending order and moves the element i of each payload
+ * 	array to the position of key i. If 'stable' is not 0, equal keys keep their
+ * 	relative order (big arrays are always sorted by a stable radix sort).
+ *
+ * 	Floats and doubles NaNs are sorted to the end of the array, -0.0 and +0.0 are
+ * 	equal.
+ */
+
+#ifndef KVSORT_H_
+	#define KVSORT_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+	#include "sortapi.h"
+
+	/*
+	 * Payload array of n elements of 'size' bytes each.
+	 */
+	struct KvsortPayload {
+		void* data;
+		size_t size;
+	};
+
+	/*
+	 * Sorts signed 32 bits integer keys[0..n-1] and permutes the payload arrays in step.
+	 * Uses a buffer of n indexes and n elements of the biggest payload.
+	 */
+	SORT_API void kvsort_sort_i32 (int32_t keys[], const size_t n, struct KvsortPayload payloads[],
+								   const int npayloads, const int stable);
+
+	/*
+	 * Sorts unsigned 32 bits integer keys[0..n-1] and permutes the payload arrays in step.
+	 */
+	SORT_API void kvsort_sort_u32 (uint32_t keys[], const size_t n, struct KvsortPayload payloads[],
+								   const int npayloads, const int stable);
+
+	/*
+	 * Sorts signed 64 bits integer keys[0..n-1] and permutes the payload arrays in step.
+	 */
+	SORT_API void kvsort_sort_i64 (int64_t keys[], const size_t n, struct KvsortPayload payloads[],
+								   const int npayloads, const int stable);
+
+	/*
+	 * Sorts unsigned 64 bits integer keys[0..n-1] and permutes the payload arrays in step.
+	 */
+	SORT_API void kvsort_sort_u64 (uint64_t keys[], const size_t n, struct KvsortPayload payloads[],
+								   const int npayloads, const int stable);
+
+	/*
+	 * Sorts float keys[0..n-1] and permutes the payload arrays in step.
+	 */
+	SORT_API void kvsort_sort_float (float keys[], const size_t n, struct KvsortPayload payloads[],
+									 const int npayloads, const int stable);
+
+	/*
+	 * Sorts double keys[0..n-1] and permutes the payload arrays in step.
+	 */
+	SORT_API void kvsort_sort_double (double keys[], const size_t n, struct KvsortPayload payloads[],
+									  const int npayloads, const int stable);
+
+#endif /* KVSORT_H_ */
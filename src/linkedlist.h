@@ -41,6 +41,7 @@
 	#define LINKEDLIST_H_
 
 	#include <stdlib.h>
+	#include "sortapi.h"
 
 	// Represents a node in list
 	struct LinkedListNode {
@@ -63,67 +64,67 @@
 	/*
 	 * Creates a new linked list.
 	 * */
-	struct LinkedList* linkedlist_create (LinkedListIsequalFunc isequalfunc,
-										  LinkedListFreeDataFunc freedatafunc);
+	SORT_API struct LinkedList* linkedlist_create (LinkedListIsequalFunc isequalfunc,
+												   LinkedListFreeDataFunc freedatafunc);
 
 	/*
 	 * Checks if list is empty.
 	 * Returns 1 if is empty, 0 otherwise.
 	 * */
-	int linkedlist_isempty (const struct LinkedList* list);
+	SORT_API int linkedlist_isempty (const struct LinkedList* list);
 
 	/*
 	 * Adds a new node at begin of linked list.
 	 * Returns 1 if succeeded, 0 otherwise.
 	 * */
-	int linkedlist_push_node (struct LinkedList* list, struct LinkedListNode* new_node);
+	SORT_API int linkedlist_push_node (struct LinkedList* list, struct LinkedListNode* new_node);
 
 	/*
 	 * Adds a new node after given node in linked list.
 	 * Returns 1 if succeeded, 0 otherwise.
 	 * */
-	int linkedlist_insert_node_after (struct LinkedList* list, struct LinkedListNode* afterThisNode,
-									  struct LinkedListNode* newNode);
+	SORT_API int linkedlist_insert_node_after (struct LinkedList* list, struct LinkedListNode* afterThisNode,
+											   struct LinkedListNode* newNode);
 
 	/*
 	 * Adds a new element at begin of linked list.
 	 * Returns 1 if succeeded, 0 otherwise.
 	 * */
-	int linkedlist_push (struct LinkedList* list, void* new_data);
+	SORT_API int linkedlist_push (struct LinkedList* list, void* new_data);
 
 	/*
 	 * Adds a new element at end of linked list.
 	 * Returns 1 if succeeded, 0 otherwise.
 	 * */
-	int linkedlist_append (struct LinkedList* list, void* new_data);
+	SORT_API int linkedlist_append (struct LinkedList* list, void* new_data);
 
 	/*
 	 * Gets the first node.
 	 * */
-	struct LinkedListNode* linkedlist_getfirst (const struct LinkedList* list);
+	SORT_API struct LinkedListNode* linkedlist_getfirst (const struct LinkedList* list);
 
 	/*
 	 * Gets the last node.
 	 * */
-	struct LinkedListNode* linkedlist_getlast (const struct LinkedList* list);
+	SORT_API struct LinkedListNode* linkedlist_getlast (const struct LinkedList* list);
 
 	/*
 	 * Gets data from a node at given position (zero based) in list.
 	 * Returns reference to founded data if succeeded, NULL otherwise.
 	 * */
-	void* linkedlist_getdata_at (const struct LinkedList* list, uint position);
+	SORT_API void* linkedlist_getdata_at (const struct LinkedList* list, uint position);
 
 	/*
 	 * Gets list node that matches given data.
 	 */
-	struct LinkedListNode* linkedlist_getnode (const struct LinkedList* list,
-											   const void* data);
+	SORT_API struct LinkedListNode* linkedlist_getnode (const struct LinkedList* list,
+														const void* data);
 
 	/*
 	 * Gets data from a node that matches given value.
 	 * Returns reference to founded data if succeeded, NULL otherwise.
 	 * */
-	void* linkedlist_getdata (const struct LinkedList* list, const void* data);
+	SORT_API void* linkedlist_getdata (const struct LinkedList* list, const void* data);
 
 	/*
 	 * Reverses a linked list.
@@ -144,24 +145,24 @@
 	 * Auxiliary Space: O(1)
 	 *
 	 * */
-	void linkedlist_reverse (struct LinkedList* l);
+	SORT_API void linkedlist_reverse (struct LinkedList* l);
 
 	/*
 	 * Removes the first node from list.
 	 * Returns the remove node if succeeded, NULL otherwise.
 	 * */
-	struct LinkedListNode* linkedlist_remove_first (struct LinkedList* list);
+	SORT_API struct LinkedListNode* linkedlist_remove_first (struct LinkedList* list);
 
 	/*
 	 * Removes the node from list that references given data.
 	 * Returns the remove node if succeeded, NULL otherwise.
 	 * */
-	struct LinkedListNode* linkedlist_remove (struct LinkedList* list, const void* data);
+	SORT_API struct LinkedListNode* linkedlist_remove (struct LinkedList* list, const void* data);
 
 	/*
 	 * Releases the entire list..
 	 * */
-	void linkedlist_destroy (struct LinkedList* list);
+	SORT_API void linkedlist_destroy (struct LinkedList* list);
 
 #endif /* LINKEDLIST_H_ */
 
@@ -7,6 +7,8 @@
  */
 
 #include "linkedlist.h"
+#include "llsort.h"
+#include "sortstats.h"
 
 /*
  * Function to swap the nodes of a linked list.
@@ -15,6 +17,7 @@
 struct LinkedListNode* llsort_swap (struct LinkedListNode* ptr1,
 									struct LinkedListNode* ptr2)
 {
+    SORTSTATS_SWAP ();
     struct LinkedListNode* tmp = ptr2->next;
     ptr2->next = ptr1;
     ptr1->next = tmp;
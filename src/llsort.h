@@ -10,6 +10,7 @@
 	#define LLSORT_H_
 	#include "linkedlist.h"
 	#include "sort.h"
+	#include "sortapi.h"
 
 	typedef void (*SortLinkedListFunc)(struct LinkedList* list,
 									   SortCompareFunc comparefunc);
@@ -18,8 +19,8 @@
 	 * Function to swap the nodes of a linked list.
 	 * Returns the first node after swap.
 	 * */
-	struct LinkedListNode* llsort_swap (struct LinkedListNode* ptr1,
-										struct LinkedListNode* ptr2);
+	SORT_API struct LinkedListNode* llsort_swap (struct LinkedListNode* ptr1,
+												 struct LinkedListNode* ptr2);
 
 #endif /* LLSORT_H_ */
 
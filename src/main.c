@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include "quicksort.h"
 #include "selectionsort.h"
 #include "bubblesort.h"
@@ -28,9 +29,18 @@
 #include "bucketsort.h"
 #include "radixsortlsd.h"
 #include "radixsortmsd.h"
+#include "radixsortstr.h"
+#include "radixsortkey.h"
 #include "treesort.h"
 #include "twayquicksort.h"
 #include "introsort.h"
+#include "pdqsort.h"
+#include "sorttyped.h"
+#include "samplesort.h"
+#include "argsort.h"
+#include "kvsort.h"
+#include "sortstats.h"
+#include "sortauto.h"
 
 /*
  * Prints linked list of ints.
@@ -77,6 +87,17 @@ void printIntArray (int array[], int size) {
 	printf("\n");
 }
 
+/*
+ * Prints array of doubles.
+ * */
+void printDoubleArray (double array[], int size) {
+	for (int i = 0; i < size; ++i) {
+		printf ("%f  ", array[i]);
+	}
+
+	printf("\n");
+}
+
 /*
  * Prints array of strings.
  * */
@@ -256,6 +277,34 @@ void do_sort (const char* algName, SortArrayFunc sortfunc) {
 	printStrArray (sp, ns);
 }
 
+/*
+ * Main function for contiguous values sort algorithms.
+ */
+void do_sort_values (const char* algName, SortValuesFunc sortfunc) {
+	printf ("-- %s sort of contiguous values demo --\n\n", algName);
+
+	int iArr[] = { 2,  10, 24, 2,  10, 11, 27, 4,  2,  4,
+            28, 16, 9,  8,  28, 10, 13, 24, 22, 28,
+            0,  13, 27, 13, 3,  23, 18, 22, 8,  8 };
+	int ni = sizeof(iArr) / sizeof(iArr[0]);
+
+	double dArr[] = {0.08, 0.7123, 0.245, 0.881, -0.5511, 0.881, 0.9121, 0.0006};
+	int nd = sizeof(dArr) / sizeof(dArr[0]);
+
+	printf ("Unsorted arrays of ints and doubles:\n");
+	printIntArray (iArr, ni);
+	printDoubleArray (dArr, nd);
+
+	// Sort values in place, no array of pointers needed
+	printf ("\nPerform %s sort on arrays...\n", algName);
+	sortfunc (iArr, ni, sizeof (iArr[0]), compareInts);
+	sortfunc (dArr, nd, sizeof (dArr[0]), compareDoubles);
+
+	printf ("\nSorted arrays in ascending order: \n");
+	printIntArray (iArr, ni);
+	printDoubleArray (dArr, nd);
+}
+
 /*
  * Main function for array sort counting algorithm.
  */
@@ -406,6 +455,21 @@ void mergesort_demo() {
 	do_sort ("Merge", mergesort_sort);
 }
 
+/*
+ * Parallel mergesort with the default number of threads, as a 'SortArrayFunc'.
+ * */
+void mergesort_parallel_default (void* arr[], const int from, const int to,
+								 SortCompareFunc comparefunc) {
+	mergesort_sort_parallel (arr, from, to, comparefunc, 0);
+}
+
+/*
+ * Parallel merge sort demo for array of ints and strings.
+ * */
+void mergesort_parallel_demo() {
+	do_sort ("Parallel merge", mergesort_parallel_default);
+}
+
 /*
  * Heap sort demo for array of ints and strings.
  * */
@@ -427,6 +491,21 @@ void quicksort_demo() {
 	do_sort ("Quicksort", quicksort_sort);
 }
 
+/*
+ * Parallel quicksort with the default number of threads, as a 'SortArrayFunc'.
+ * */
+void quicksort_parallel_default (void* arr[], const int from, const int to,
+								 SortCompareFunc comparefunc) {
+	quicksort_sort_parallel (arr, from, to, comparefunc, 0);
+}
+
+/*
+ * Parallel quicksort demo for array of ints and strings.
+ * */
+void quicksort_parallel_demo() {
+	do_sort ("Parallel quicksort", quicksort_parallel_default);
+}
+
 /*
  * Countingsort demo for array of ints.
  * */
@@ -436,6 +515,48 @@ void countingsort_demo() {
 	do_counting_sort ("Counting", countingsort_sort);
 }
 
+/*
+ * Parallel counting sort with the default number of threads, as a
+ * 'CountingSortArrayFuncInPlace'.
+ * */
+void countingsort_parallel_default (int arr[], const int from, const int to) {
+	countingsort_sort_in_place_parallel (arr, from, to, 0);
+}
+
+/*
+ * Gets the length of a string, as the key of the counting sort of items demo.
+ * */
+int string_length_key (const void* item) {
+	return (int)strlen ((const char*)item);
+}
+
+/*
+ * Stable counting sort of items by key demo: strings sorted by length.
+ * */
+void countingsort_items_demo() {
+	printf ("-- Countingsort of items by key demo --\n\n");
+
+	char* sArr[] = {"gfd", "a", "asd", "aab", "", "aaaa", "gdd", "ded", "aa", "ewe"};
+	int n = sizeof(sArr) / sizeof(sArr[0]);
+
+	printf ("Unsorted list of strings:\n");
+	printStrArray ((void**)sArr, n);
+
+	printf ("\nPerform Countingsort of items by length on list...\n");
+	countingsort_sort_items ((void**)sArr, 0, n-1, string_length_key);
+
+	printf ("\nSorted list by length (strings of the same length keep their order): \n");
+	printStrArray ((void**)sArr, n);
+}
+
+/*
+ * Parallel counting sort demo for array of ints.
+ * */
+void countingsort_parallel_demo() {
+	do_counting_sort_in_place ("Parallel countingsort in place",
+							   countingsort_parallel_default);
+}
+
 /*
  * 3-way quicksort demo.
  * This algorithm is a Quicksort adaptation for better performance with inputs
@@ -454,11 +575,98 @@ void bucketsort_demo() {
 									  bucketsort_sort_doubles);
 }
 
+/*
+ * Parallel bucket sort of ints with the default number of threads, as a
+ * 'SortArrayFunc'.
+ * */
+void bucketsort_ints_parallel_default (void* arr[], const int from, const int to,
+									   SortCompareFunc comparefunc) {
+	bucketsort_sort_ints_parallel (arr, from, to, comparefunc, 0);
+}
+
+/*
+ * Parallel bucket sort of floats with the default number of threads, as a
+ * 'SortArrayFunc'.
+ * */
+void bucketsort_floats_parallel_default (void* arr[], const int from, const int to,
+										 SortCompareFunc comparefunc) {
+	bucketsort_sort_floats_parallel (arr, from, to, comparefunc, 0);
+}
+
+/*
+ * Parallel bucket sort of doubles with the default number of threads, as a
+ * 'SortArrayFunc'.
+ * */
+void bucketsort_doubles_parallel_default (void* arr[], const int from, const int to,
+										  SortCompareFunc comparefunc) {
+	bucketsort_sort_doubles_parallel (arr, from, to, comparefunc, 0);
+}
+
+/*
+ * Sampled bucket sort with pdqsort buckets, as a 'SortArrayFunc'.
+ * */
+void bucketsort_sampled_default (void* arr[], const int from, const int to,
+								 SortCompareFunc comparefunc) {
+	bucketsort_sort_sampled (arr, from, to, comparefunc, pdqsort_sort);
+}
+
+/*
+ * Sampled bucket sort demo for array of ints and strings.
+ * Any type with a compare function can be sorted, the buckets come from a sample.
+ * */
+void bucketsort_sampled_demo() {
+	do_sort ("Sampled bucketsort", bucketsort_sampled_default);
+}
+
+/*
+ * Parallel bucket sort function demo of ints, floats and doubles.
+ * */
+void bucketsort_parallel_demo() {
+	do_bucketsort_sort ("Parallel bucketsort", bucketsort_ints_parallel_default,
+											   bucketsort_floats_parallel_default,
+											   bucketsort_doubles_parallel_default);
+}
+
 /*
  * LSD Radix sort function demo of integers.
  * */
 void radixsortlsd_demo() {
 	do_radix_sort_in_place ("LSD Radixsort", radixsortlsd_sort_ints);
+	printf ("\n\n");
+
+	printf ("-- LSD Radixsort for signed 64 bits integers demo --\n\n");
+
+	int64_t lArr[] = {834, -73, 9000000000, 1, 0, -921000000000, 1, -623};
+	int n = sizeof(lArr) / sizeof(lArr[0]);
+
+	printf ("Unsorted list of 64 bits integers:\n");
+	for (int i = 0; i < n; ++i)
+		printf ("%lld  ", (long long)lArr[i]);
+
+	printf ("\n\nPerform LSD Radixsort sort on list...\n");
+	radixsortlsd_sort_i64 (lArr, 0, n-1);
+
+	printf ("\nSorted list in ascending order: \n");
+	for (int i = 0; i < n; ++i)
+		printf ("%lld  ", (long long)lArr[i]);
+	printf ("\n\n\n");
+
+	printf ("-- LSD Radixsort for doubles demo --\n\n");
+
+	double dArr[] = {2.5, -0.0, NAN, -7.25, 0.0, INFINITY, 1e-3, -INFINITY, 0.0, -3e8};
+	n = sizeof(dArr) / sizeof(dArr[0]);
+
+	printf ("Unsorted list of doubles:\n");
+	for (int i = 0; i < n; ++i)
+		printf ("%g  ", dArr[i]);
+
+	printf ("\n\nPerform LSD Radixsort sort on list with NaNs first...\n");
+	radixsortlsd_sort_double (dArr, 0, n-1, RADIXSORTLSD_NANS_FIRST);
+
+	printf ("\nSorted list in ascending order: \n");
+	for (int i = 0; i < n; ++i)
+		printf ("%g  ", dArr[i]);
+	printf ("\n");
 }
 
 /*
@@ -468,6 +676,72 @@ void radixsortmsd_demo() {
 	do_radix_sort_in_place ("MSD Radixsort", radixsortmsd_sort_ints);
 }
 
+/*
+ * Main function to sort array of strings using string Radixsort algorithms.
+ */
+void do_radix_sort_strings (const char* algName, RadixSortStringsFunc sortfunc) {
+	printf ("-- %s sort for strings demo --\n\n", algName);
+
+	char* sArr[] = {"gfd", "asd", "aab", "aaa", "gdd", "ded", "aab", "ewe", "a", "aa", ""};
+	int n = sizeof(sArr) / sizeof(sArr[0]);
+
+	printf ("Unsorted list of strings:\n");
+	printStrArray ((void**)sArr, n);
+
+	// Perform sort on data
+	printf ("\nPerform %s sort on list...\n", algName);
+	sortfunc (sArr, 0, n-1);
+
+	printf ("\nSorted list in lexicographical order: \n");
+	printStrArray ((void**)sArr, n);
+}
+
+/*
+ * String Radix sort functions demo (MSD radix sort and multikey quicksort).
+ * */
+void radixsortstr_demo() {
+	do_radix_sort_strings ("MSD Radixsort", radixsortstr_sort);
+	printf ("\n\n");
+	do_radix_sort_strings ("Multikey quicksort", radixsortstr_mkqsort);
+}
+
+/*
+ * Returns the first 16 characters of a string as a 128 bits key, so strings
+ * up to 16 characters long are sorted in lexicographical order.
+ * */
+struct RadixSortKey128 string_prefix_key (const void* item) {
+	const unsigned char* s = (const unsigned char*)item;
+	struct RadixSortKey128 key = { 0, 0 };
+	int i = 0;
+
+	for (; (i < 8) && (s[i] != '\0'); i++)
+		key.hi |= (uint64_t)s[i] << (56 - i * 8);
+	if (i == 8)
+		for (; (i < 16) && (s[i] != '\0'); i++)
+			key.lo |= (uint64_t)s[i] << (120 - i * 8);
+
+	return key;
+}
+
+/*
+ * Radix sort of items by key demo: strings sorted by their 128 bits prefix key.
+ * */
+void radixsortkey_demo() {
+	printf ("-- Radixsort of items by key demo --\n\n");
+
+	char* sArr[] = {"gfd", "a", "asd", "aab", "", "aaaa", "gdd", "ded", "aa", "ewe"};
+	int n = sizeof(sArr) / sizeof(sArr[0]);
+
+	printf ("Unsorted list of strings:\n");
+	printStrArray ((void**)sArr, n);
+
+	printf ("\nPerform Radixsort of items by prefix key on list...\n");
+	radixsortkey_sort_u128 ((void**)sArr, 0, n-1, string_prefix_key);
+
+	printf ("\nSorted list: \n");
+	printStrArray ((void**)sArr, n);
+}
+
 /*
  * Tree sort function demo for integers and strings.
  * */
@@ -482,6 +756,266 @@ void introsort_demo() {
 	do_sort ("Introsort", introsort_sort);
 }
 
+/*
+ * Pattern-defeating quicksort function demo for integers and strings.
+ * */
+void pdqsort_demo() {
+	do_sort ("Pattern-defeating quicksort", pdqsort_sort);
+}
+
+/*
+ * Parallel samplesort with the default number of threads, as a 'SortArrayFunc'.
+ * */
+void samplesort_parallel_default (void* arr[], const int from, const int to,
+								  SortCompareFunc comparefunc) {
+	samplesort_sort_parallel (arr, from, to, comparefunc, 0);
+}
+
+/*
+ * Samplesort function demo for integers and strings, sequential and parallel.
+ * */
+void samplesort_demo() {
+	do_sort ("Samplesort", samplesort_sort);
+	printf ("\n\n");
+	do_sort ("Parallel samplesort", samplesort_parallel_default);
+}
+
+
+/*
+ * Sort demos for contiguous values (ints and doubles arrays).
+ * */
+void sort_values_demo() {
+	do_sort_values ("Quicksort", quicksort_sort_values);
+	printf ("\n\n");
+	do_sort_values ("Merge", mergesort_sort_values);
+	printf ("\n\n");
+	do_sort_values ("Tim", timsort_sort_values);
+	printf ("\n\n");
+	do_sort_values ("Heap", heapsort_sort_values);
+	printf ("\n\n");
+	do_sort_values ("Introsort", introsort_sort_values);
+}
+
+/*
+ * Type specialized sorts demo (ints and doubles arrays, comparison inlined).
+ * */
+void sort_typed_demo() {
+	printf ("-- Type specialized sorts demo --\n\n");
+
+	int iArr[] = { 2,  10, 24, 2,  10, 11, 27, 4,  2,  4,
+				   28, 16, 9,  8,  28, 10, 13, 24, 22, 28,
+				   0,  13, 27, 13, 3,  23, 18, 22, 8,  8 };
+	int ni = sizeof (iArr) / sizeof (iArr[0]);
+	double dArr[] = { 5.25, -1.5, 3.0, 0.125, 9.75, -7.0, 3.0, 2.5 };
+	int nd = sizeof (dArr) / sizeof (dArr[0]);
+
+	printf ("Unsorted arrays:\n");
+	printIntArray (iArr, ni);
+	printDoubleArray (dArr, nd);
+
+	printf ("\nPerform sort_int_introsort and sort_double_timsort on arrays...\n");
+	sort_int_introsort (iArr, ni);
+	sort_double_timsort (dArr, nd);
+
+	printf ("Sorted arrays:\n");
+	printIntArray (iArr, ni);
+	printDoubleArray (dArr, nd);
+}
+
+/*
+ * Argsort demo: the indexes that sort a column of ages are applied to the ages
+ * and to the parallel column of names.
+ * */
+void argsort_demo() {
+	printf ("-- Argsort demo --\n\n");
+
+	int32_t ages[] = {34, 19, 52, 27, 19, 41, 27};
+	char* names[] = {"Ana", "Rui", "Rita", "Joao", "Ines", "Pedro", "Maria"};
+	int n = sizeof(ages) / sizeof(ages[0]);
+	int32_t idx[sizeof(ages) / sizeof(ages[0])];
+
+	printf ("Unsorted table:\n");
+	for (int i = 0; i < n; ++i)
+		printf ("%s (%d)  ", names[i], ages[i]);
+
+	printf ("\n\nPerform radix argsort of the ages...\n");
+	argsort_radix_i32 (ages, n, idx);
+
+	printf ("\nSorted indexes: \n");
+	for (int i = 0; i < n; ++i)
+		printf ("%d  ", idx[i]);
+
+	argsort_apply_permutation (ages, n, sizeof(ages[0]), idx);
+	argsort_apply_permutation (names, n, sizeof(names[0]), idx);
+
+	printf ("\n\nTable sorted by age: \n");
+	for (int i = 0; i < n; ++i)
+		printf ("%s (%d)  ", names[i], ages[i]);
+	printf ("\n");
+}
+
+/*
+ * Key/value sort demo: a column of prices is sorted and the parallel columns of
+ * product ids and names are permuted in step.
+ * */
+void kvsort_demo() {
+	printf ("-- Key/value sort demo --\n\n");
+
+	double prices[] = {9.99, 2.5, 120.0, 2.5, 35.75, 0.99};
+	int32_t ids[] = {101, 102, 103, 104, 105, 106};
+	char* names[] = {"pen", "clip", "chair", "tape", "lamp", "eraser"};
+	int n = sizeof(prices) / sizeof(prices[0]);
+
+	printf ("Unsorted columns:\n");
+	for (int i = 0; i < n; ++i)
+		printf ("%d %s (%.2f)  ", ids[i], names[i], prices[i]);
+
+	printf ("\n\nPerform stable key/value sort by price...\n");
+	struct KvsortPayload payloads[] = {
+		{ ids, sizeof(ids[0]) },
+		{ names, sizeof(names[0]) }
+	};
+	kvsort_sort_double (prices, n, payloads, 2, 1);
+
+	printf ("\nColumns sorted by price: \n");
+	for (int i = 0; i < n; ++i)
+		printf ("%d %s (%.2f)  ", ids[i], names[i], prices[i]);
+	printf ("\n");
+}
+
+/*
+ * Prints the counters of the last sort.
+ */
+void print_sort_stats (const char* name) {
+	struct SortStats stats;
+	sortstats_get (&stats);
+	printf ("%-10s comparisons: %-8llu swaps: %-8llu moves: %-8llu allocations: %llu"
+			"  peak aux bytes: %zu\n", name, (unsigned long long)stats.comparisons,
+			(unsigned long long)stats.swaps, (unsigned long long)stats.moves,
+			(unsigned long long)stats.allocations, stats.peak_aux_bytes);
+}
+
+/*
+ * Instrumentation demo: counts of the same input sorted by several algorithms.
+ */
+void sortstats_demo() {
+	printf ("-- Sort instrumentation demo --\n\n");
+
+	const int n = 1000;
+	int values[1000];
+	void* arr[1000];
+	struct {
+		const char* name;
+		SortArrayFunc sortfunc;
+	} sorts[] = {
+		{ "insertion", insertionsort_sort },
+		{ "heap", heapsort_sort },
+		{ "merge", mergesort_sort },
+		{ "tim", timsort_sort },
+		{ "pdq", pdqsort_sort }
+	};
+
+	if (!sortstats_enabled ())
+		printf ("Note: built without -DSORT_STATS, only comparisons are counted.\n\n");
+
+	printf ("Sorting %d random ints:\n", n);
+	for (size_t s = 0; s < sizeof(sorts) / sizeof(sorts[0]); ++s) {
+		srand (1);
+		for (int i = 0; i < n; ++i) {
+			values[i] = rand () % 10000;
+			arr[i] = &values[i];
+		}
+
+		sortstats_reset ();
+		sorts[s].sortfunc (arr, 0, n - 1, sortstats_counting_compare (compareInts));
+		print_sort_stats (sorts[s].name);
+	}
+}
+
+/*
+ * Returns the order-preserving key of an int for the adaptive sort.
+ * */
+uint32_t int_key (const void* item) {
+	return radixsortkey_key_i32 (*(const int*)item);
+}
+
+/*
+ * Adaptive sort demo: the algorithm chosen for inputs of several shapes.
+ * */
+void sortauto_demo() {
+	printf ("-- Adaptive sort demo --\n\n");
+
+	const int n = 10000;
+	int* values = malloc (n * sizeof (int));
+	void** arr = malloc (n * sizeof (void*));
+	const char* inputs[] = {"random", "sorted", "reversed", "few unique", "dups + tail",
+							"random (key)"};
+
+	if ((values == NULL) || (arr == NULL)) {
+		fprintf (stderr, "Error: failed to allocate memory for adaptive sort demo.");
+		abort ();
+	}
+
+	printf ("Sorting %d ints:\n", n);
+	for (int s = 0; s < 6; ++s) {
+		srand (1);
+		for (int i = 0; i < n; ++i) {
+			switch (s) {
+			case 1: values[i] = i; break;
+			case 2: values[i] = n - i; break;
+			case 3: values[i] = rand () % 4; break;
+			// 80% of random {-1, 0} then an ascending tail of distinct values
+			case 4: values[i] = (i < n * 8 / 10) ? -(rand () % 2) : i; break;
+			default: values[i] = rand () % 100000; break;
+			}
+			arr[i] = &values[i];
+		}
+
+		int path = (s == 5) ? sort_auto_key32 (arr, 0, n - 1, compareInts, int_key)
+							: sort_auto (arr, 0, n - 1, compareInts);
+
+		int sorted = 1;
+		for (int i = 1; i < n; ++i)
+			if (*(int*)arr[i - 1] > *(int*)arr[i])
+				sorted = 0;
+		printf ("%-14s sorted by %-14s %s\n", inputs[s], sort_auto_name (path),
+				sorted ? "ok" : "NOT SORTED");
+	}
+
+	// Subranges arr[from..to]: the elements outside, all greater than the ones
+	// inside, must stay in place
+	const int from = 100;
+	const int lengths[] = {5, 5000, 5000};
+	const char* subranges[] = {"5 random", "5000 random", "5000 (key)"};
+
+	printf ("\nSorting subranges of %d ints starting at %d:\n", n, from);
+	for (int s = 0; s < 3; ++s) {
+		const int to = from + lengths[s] - 1;
+		srand (1);
+		for (int i = 0; i < n; ++i) {
+			values[i] = ((i < from) || (i > to)) ? 100000 : rand () % 100000;
+			arr[i] = &values[i];
+		}
+
+		int path = (s == 2) ? sort_auto_key32 (arr, from, to, compareInts, int_key)
+							: sort_auto (arr, from, to, compareInts);
+
+		int sorted = 1;
+		for (int i = 0; i < n; ++i) {
+			if ((i < from) || (i > to)) {
+				if (arr[i] != &values[i])
+					sorted = 0;
+			}
+			else if ((i > from) && (*(int*)arr[i - 1] > *(int*)arr[i]))
+				sorted = 0;
+		}
+		printf ("%-14s sorted by %-14s %s\n", subranges[s], sort_auto_name (path),
+				sorted ? "ok" : "NOT SORTED");
+	}
+
+	free (arr);
+	free (values);
+}
 
 
 /*
@@ -538,25 +1072,57 @@ int main() {
 	printf("\n\n");
 	mergesort_demo ();
 	printf("\n\n");
+	mergesort_parallel_demo ();
+	printf("\n\n");
 	heapsort_demo ();
 	printf("\n\n");
 	timsort_demo ();
 	printf("\n\n");
 	quicksort_demo ();
 	printf("\n\n");
+	quicksort_parallel_demo ();
+	printf("\n\n");
 	countingsort_demo ();
+	printf ("\n\n");
+	countingsort_parallel_demo ();
+	printf ("\n\n");
+	countingsort_items_demo ();
 	printf("\n\n");
 	bucketsort_demo ();
 	printf ("\n\n");
+	bucketsort_parallel_demo ();
+	printf ("\n\n");
+	bucketsort_sampled_demo ();
+	printf ("\n\n");
 	radixsortlsd_demo ();
 	printf ("\n\n");
 	radixsortmsd_demo ();
 	printf ("\n\n");
+	radixsortstr_demo ();
+	printf ("\n\n");
+	radixsortkey_demo ();
+	printf ("\n\n");
 	treesort_demo ();
 	printf ("\n\n");
 	twayquicksort_demo ();
 	printf ("\n\n");
 	introsort_demo ();
+	printf ("\n\n");
+	pdqsort_demo ();
+	printf ("\n\n");
+	samplesort_demo ();
+	printf ("\n\n");
+	sort_values_demo ();
+	printf ("\n\n");
+	sort_typed_demo ();
+	printf ("\n\n");
+	argsort_demo ();
+	printf ("\n\n");
+	kvsort_demo ();
+	printf ("\n\n");
+	sortstats_demo ();
+	printf ("\n\n");
+	sortauto_demo ();
 
 	printf("\n\n\n");
 	printf ("------------------------------\n");
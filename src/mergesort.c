@@ -134,80 +134,406 @@
  *
  */
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "sort.h"
+#include "insertionsort.h"
+#include "mergesort.h"
+#include "sortstats.h"
+
+// Partitions up to this size are sorted with insertion sort
+static const int mergesort_INSERTION_SORT = 16;
 
 /*
- * Merges two subarrays of arr[].
- * First subarray is arr[l..m]
- * Second subarray is arr[m+1..r]
+ * Sorts dst[0..n-1] using src[0..n-1] as auxiliary space.
+ * Both ranges must hold the same elements on entry. Source and destination swap
+ * roles at each recursion level, so each element is moved once per level.
  */
-static void mergesort_merge (void* arr[],
-							 const int l, const int m, const int r,
-							 SortCompareFunc comparefunc)
+static void mergesort_rec (void* src[], void* dst[], const int n,
+						   SortCompareFunc comparefunc)
+{
+	if (n <= mergesort_INSERTION_SORT) {
+		insertionsort_sort (dst, 0, n - 1, comparefunc);
+		return;
+	}
+
+	// Sort both halves into src, then merge them into dst
+	int m = n / 2;
+	mergesort_rec (dst, src, m, comparefunc);
+	mergesort_rec (dst + m, src + m, n - m, comparefunc);
+	SORTSTATS_MOVES (n);
+
+	// Halves already in order, nothing to merge
+	if (!(comparefunc (src[m - 1], src[m]) > 0)) {
+		memcpy (dst, src, n * sizeof (void*));
+		return;
+	}
+
+	int i = 0;
+	int j = m;
+	int k = 0;
+	while (i < m && j < n) {
+		if (!(comparefunc (src[i], src[j]) > 0))	// (L[i] <= R[j])
+			dst[k++] = src[i++];
+		else
+			dst[k++] = src[j++];
+	}
+
+	// Copy the remaining elements of the left or right half
+	while (i < m)
+		dst[k++] = src[i++];
+	while (j < n)
+		dst[k++] = src[j++];
+}
+
+/*
+ * Sorts an array or part of array arr[l..r] using the merge sort algorithm,
+ * with the caller supplied auxiliary buffer 'buf' of at least r-l+1 elements.
+ * No memory is allocated, so repeated sorts can reuse the same buffer.
+ */
+void mergesort_sort_with_buffer (void* arr[], const int l, const int r,
+								 SortCompareFunc comparefunc, void* buf[])
 {
-	int i, j, k;
-	int n1 = m - l + 1;
-	int n2 = r - m;
-
-    // Create temp arrays
-    void* L[n1];
-	void* R[n2];
-
-    // Copy data to temp arrays L[] and R[]
-    for (i = 0; i < n1; i++)
-        L[i] = arr[l + i];
-    for (j = 0; j < n2; j++)
-        R[j] = arr[m + 1 + j];
-
-    // Merge the temp arrays back into arr[l..r
-    i = 0;
-    j = 0;
-    k = l;
-    while (i < n1 && j < n2) {
-        if (!(comparefunc (L[i], R[j]) > 0)) {	// (L[i] <= R[j]) {
-            arr[k] = L[i];
-            i++;
-        }
-        else {
-            arr[k] = R[j];
-            j++;
-        }
-        k++;
-    }
-
-    // Copy the remaining elements of L[],
-    // if there are any
-    while (i < n1) {
-        arr[k] = L[i];
-        i++;
-        k++;
-    }
-
-    // Copy the remaining elements of R[],
-    // if there are any
-    while (j < n2) {
-        arr[k] = R[j];
-        j++;
-        k++;
-    }
+	if (l < r) {
+		const int n = r - l + 1;
+		memcpy (buf, &arr[l], n * sizeof (void*));
+		SORTSTATS_MOVES (n);
+		mergesort_rec (buf, &arr[l], n, comparefunc);
+	}
 }
 
 /*
  * Sorts an array or part of array using the merge sort recursive algorithm.
  * l is for left index and r is right index of the
  * sub-array of arr to be sorted.
+ * A single auxiliary buffer of r-l+1 elements is allocated for the whole sort.
  */
 void mergesort_sort (void* arr[], const int l, const int r,
 					 SortCompareFunc comparefunc)
 {
-    if (l < r) {
-    	int m = l + (r - l) / 2;
+	if (l < r) {
+		void** buf = sortstats_malloc ((r - l + 1) * sizeof (void*));
+		if (buf == NULL) {
+			fprintf (stderr, "Error: failed to allocate memory for merge sort.");
+			abort ();
+		}
+
+		mergesort_sort_with_buffer (arr, l, r, comparefunc, buf);
+		sortstats_free (buf);
+	}
+}
+
+
+/*
+ * Parallel mergesort section.
+ *
+ * About:
+ *
+ *    The left half of each range is sorted by a task of the thread pool while the
+ *    current thread sorts the right half, then both are merged. Ranges below
+ *    'mergesort_PARALLEL_CUTOFF' are sorted by the sequential algorithm. Source and
+ *    destination swap roles between levels, as in 'mergesort_sort ()'.
+ *
+ *    Splitting the sort alone does not scale: the top merge is O(n) and runs on a
+ *    single thread. So big merges are split too (merge path). The output is cut in
+ *    chunks of equal size and, for the first output position 'd' of each chunk, a
+ *    binary search finds how many elements 'i' come from the left half (and d - i
+ *    from the right half). That is the co-rank of 'd', the point where the merge
+ *    path crosses the diagonal 'd'. Every chunk is then merged by its own task,
+ *    independently from the others. Equal elements are taken from the left half
+ *    first, at the chunk bounds too, so the sort is stable.
+ */
+
+// Ranges up to this size are sorted sequentially by a single task
+static const int mergesort_PARALLEL_CUTOFF = 16384;
+
+// Minimum number of elements of each chunk of a parallel merge
+static const int mergesort_MERGE_BLOCK = 32768;
+
+// A range to sort, dst[0..n-1] using src[0..n-1] as auxiliary space
+struct MergesortJob {
+	void** src;
+	void** dst;
+	int n;
+	SortCompareFunc comparefunc;
+	struct ThreadPool* pool;
+};
+
+// A chunk of a parallel merge of left[0..nleft-1] and right[0..nright-1] into
+// dst[from..end-1]
+struct MergesortChunk {
+	void** left;
+	int nleft;
+	void** right;
+	int nright;
+	void** dst;
+	int from;
+	int end;
+	SortCompareFunc comparefunc;
+};
+
+/*
+ * Merges left[0..nleft-1] and right[0..nright-1] into dst (stable).
+ */
+static void mergesort_merge_into (void* left[], const int nleft,
+								  void* right[], const int nright,
+								  void* dst[], SortCompareFunc comparefunc)
+{
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	SORTSTATS_MOVES (nleft + nright);
+	while (i < nleft && j < nright) {
+		if (!(comparefunc (left[i], right[j]) > 0))
+			dst[k++] = left[i++];
+		else
+			dst[k++] = right[j++];
+	}
+
+	if (i < nleft)
+		memcpy (&dst[k], &left[i], (nleft - i) * sizeof (void*));
+	if (j < nright)
+		memcpy (&dst[k], &right[j], (nright - j) * sizeof (void*));
+}
+
+/*
+ * Returns the number of elements of 'left' among the first 'd' elements of the
+ * stable merge of left[0..nleft-1] and right[0..nright-1] (co-rank of 'd').
+ */
+static int mergesort_corank (const int d, void* left[], const int nleft,
+							 void* right[], const int nright,
+							 SortCompareFunc comparefunc)
+{
+	int lo = (d > nright) ? d - nright : 0;
+	int hi = (d < nleft) ? d : nleft;
+
+	// Smallest i such that left[i] > right[d-i-1], left[i] goes after the first d
+	while (lo < hi) {
+		int i = lo + (hi - lo) / 2;
+		int j = d - i;
+		if (j > 0 && !(comparefunc (left[i], right[j - 1]) > 0))
+			lo = i + 1;
+		else
+			hi = i;
+	}
+
+	return lo;
+}
+
+/*
+ * Task merging a chunk of a parallel merge.
+ * */
+static void mergesort_merge_chunk_task (void* arg) {
+	struct MergesortChunk* c = arg;
+
+	int i0 = mergesort_corank (c->from, c->left, c->nleft, c->right, c->nright,
+							   c->comparefunc);
+	int i1 = mergesort_corank (c->end, c->left, c->nleft, c->right, c->nright,
+							   c->comparefunc);
+	int j0 = c->from - i0;
+	int j1 = c->end - i1;
+
+	mergesort_merge_into (c->left + i0, i1 - i0, c->right + j0, j1 - j0,
+						  c->dst + c->from, c->comparefunc);
+}
+
+/*
+ * Merges the sorted halves src[0..m-1] and src[m..n-1] of job into job dst,
+ * split in chunks merged by tasks of the pool.
+ * */
+static void mergesort_merge_parallel (const struct MergesortJob* job, const int m) {
+	int nchunks = job->n / mergesort_MERGE_BLOCK;
+	int maxchunks = 2 * threadpool_num_threads (job->pool);
+	if (nchunks > maxchunks)
+		nchunks = maxchunks;
+
+	if (nchunks < 2) {
+		mergesort_merge_into (job->src, m, job->src + m, job->n - m, job->dst,
+							  job->comparefunc);
+		return;
+	}
+
+	struct MergesortChunk chunks[nchunks];
+	struct ThreadPoolGroup group;
+	threadpool_group_init (&group);
+
+	for (int c = 0; c < nchunks; c++) {
+		chunks[c].left = job->src;
+		chunks[c].nleft = m;
+		chunks[c].right = job->src + m;
+		chunks[c].nright = job->n - m;
+		chunks[c].dst = job->dst;
+		chunks[c].from = (int)((long long)job->n * c / nchunks);
+		chunks[c].end = (int)((long long)job->n * (c + 1) / nchunks);
+		chunks[c].comparefunc = job->comparefunc;
+		if (c > 0)
+			threadpool_submit (job->pool, &group, mergesort_merge_chunk_task, &chunks[c]);
+	}
+
+	mergesort_merge_chunk_task (&chunks[0]);
+	threadpool_wait (job->pool, &group);
+}
+
+static void mergesort_parallel_rec (struct MergesortJob job);
+
+/*
+ * Task sorting a range of a parallel sort.
+ * */
+static void mergesort_parallel_task (void* arg) {
+	mergesort_parallel_rec (*((struct MergesortJob*)arg));
+}
+
+/*
+ * Sorts job range, handing the left half to the thread pool.
+ * */
+static void mergesort_parallel_rec (struct MergesortJob job) {
+	if (job.n <= mergesort_PARALLEL_CUTOFF) {
+		mergesort_rec (job.src, job.dst, job.n, job.comparefunc);
+		return;
+	}
+
+	// Sort both halves into src, then merge them into dst
+	int m = job.n / 2;
+	struct MergesortJob left = { job.dst, job.src, m, job.comparefunc, job.pool };
+	struct MergesortJob right = { job.dst + m, job.src + m, job.n - m, job.comparefunc,
+								  job.pool };
+
+	struct ThreadPoolGroup group;
+	threadpool_group_init (&group);
+	threadpool_submit (job.pool, &group, mergesort_parallel_task, &left);
+	mergesort_parallel_rec (right);
+	threadpool_wait (job.pool, &group);
+
+	// Halves already in order, nothing to merge
+	if (!(job.comparefunc (job.src[m - 1], job.src[m]) > 0)) {
+		SORTSTATS_MOVES (job.n);
+		memcpy (job.dst, job.src, job.n * sizeof (void*));
+		return;
+	}
+
+	mergesort_merge_parallel (&job, m);
+}
+
+/*
+ * Parallel stable mergesort of arr[l..r] running on the threads of the given pool.
+ * A single auxiliary buffer of r-l+1 elements is allocated for the whole sort.
+ * */
+void mergesort_sort_pool (void* arr[], const int l, const int r,
+						  SortCompareFunc comparefunc, struct ThreadPool* pool) {
+	if (l < r) {
+		const int n = r - l + 1;
+		void** buf = sortstats_malloc (n * sizeof (void*));
+		if (buf == NULL) {
+			fprintf (stderr, "Error: failed to allocate memory for merge sort.");
+			abort ();
+		}
+
+		memcpy (buf, &arr[l], n * sizeof (void*));
+		SORTSTATS_MOVES (n);
+		struct MergesortJob job = { buf, &arr[l], n, comparefunc, pool };
+		mergesort_parallel_rec (job);
+		sortstats_free (buf);
+	}
+}
+
+/*
+ * Parallel stable mergesort of arr[l..r] with 'nthreads' threads (the number of
+ * online processors if 'nthreads' <= 0).
+ * */
+void mergesort_sort_parallel (void* arr[], const int l, const int r,
+							  SortCompareFunc comparefunc, const int nthreads) {
+	struct ThreadPool* pool = NULL;
+	if ((r - l + 1 > mergesort_PARALLEL_CUTOFF) && (nthreads != 1))
+		pool = threadpool_create (nthreads);
+
+	if (pool == NULL) {
+		mergesort_sort (arr, l, r, comparefunc);
+		return;
+	}
+
+	mergesort_sort_pool (arr, l, r, comparefunc, pool);
+	threadpool_destroy (pool);
+}
+
+
+/*
+ * Contiguous values section.
+ *
+ * Same algorithm for arrays of fixed size elements stored one after the other
+ * (like 'qsort ()'). A single auxiliary buffer of n elements is allocated for the
+ * whole sort, and source and destination swap roles between recursion levels, as
+ * in 'mergesort_sort ()'.
+ */
+
+// Partitions up to this size are sorted with insertion sort
+static const size_t mergesort_VALUES_INSERTION_SORT = 16;
+
+/*
+ * Sorts dst[0..n[ using src[0..n[ as auxiliary space.
+ * Both ranges must hold the same elements on entry.
+ */
+static void mergesort_values_rec (char* src, char* dst, const size_t n,
+								  const size_t size, SortCompareFunc comparefunc)
+{
+	if (n <= mergesort_VALUES_INSERTION_SORT) {
+		insertionsort_sort_values (dst, n, size, comparefunc);
+		return;
+	}
+
+	// Sort both halves into src, then merge them into dst
+	size_t m = n / 2;
+	mergesort_values_rec (dst, src, m, size, comparefunc);
+	mergesort_values_rec (dst + m * size, src + m * size, n - m, size, comparefunc);
+
+	char* l = src;
+	char* lend = src + m * size;
+	char* r = lend;
+	char* rend = src + n * size;
+	SORTSTATS_MOVES (n);
+
+	// Halves already in order, nothing to merge
+	if (!(comparefunc (lend - size, r) > 0)) {
+		memcpy (dst, src, n * size);
+		return;
+	}
+
+	while (l < lend && r < rend) {
+		if (!(comparefunc (l, r) > 0)) {	// (L[i] <= R[j])
+			memcpy (dst, l, size);
+			l += size;
+		}
+		else {
+			memcpy (dst, r, size);
+			r += size;
+		}
+		dst += size;
+	}
+
+	// Copy the remaining elements of one of the halves
+	memcpy (dst, l, lend - l);
+	memcpy (dst + (lend - l), r, rend - r);
+}
+
+/*
+ * Sorts 'n' contiguous elements of 'size' bytes each starting at 'base' using the
+ * merge sort algorithm.
+ * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+ */
+void mergesort_sort_values (void* base, const size_t n, const size_t size,
+							SortCompareFunc comparefunc)
+{
+	if (n < 2)
+		return;
 
-        // Sort first and second halves
-        mergesort_sort (arr, l, m, comparefunc);
-        mergesort_sort (arr, m + 1, r, comparefunc);
+	char* buf = sortstats_malloc (n * size);
+	if (buf == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for merge sort.");
+		abort ();
+	}
 
-        mergesort_merge(arr, l, m, r, comparefunc);
-    }
+	memcpy (buf, base, n * size);
+	SORTSTATS_MOVES (n);
+	mergesort_values_rec (buf, base, n, size, comparefunc);
+	sortstats_free (buf);
 }
@@ -11,13 +11,49 @@
 
 	#include <stdlib.h>
 	#include "sort.h"
+	#include "threadpool.h"
+	#include "sortapi.h"
 
 	/*
 	 * Sorts an array or part of array using the merge sort recursive algorithm.
 	 * l is for left index and r is right index of the
 	 * sub-array of arr to be sorted.
+	 * A single auxiliary buffer of r-l+1 elements is allocated for the whole sort.
 	 */
-	void mergesort_sort (void* arr[], const int l, const int r,
-					 	 SortCompareFunc comparefunc);
+	SORT_API void mergesort_sort (void* arr[], const int l, const int r,
+								  SortCompareFunc comparefunc);
+
+	/*
+	 * Sorts an array or part of array arr[l..r] using the merge sort algorithm,
+	 * with the caller supplied auxiliary buffer 'buf' of at least r-l+1 elements.
+	 * No memory is allocated, so repeated sorts can reuse the same buffer.
+	 */
+	SORT_API void mergesort_sort_with_buffer (void* arr[], const int l, const int r,
+											  SortCompareFunc comparefunc, void* buf[]);
+
+	/*
+	 * Parallel stable mergesort of arr[l..r] running on the threads of the given pool.
+	 * A single auxiliary buffer of r-l+1 elements is allocated for the whole sort.
+	 */
+	SORT_API void mergesort_sort_pool (void* arr[], const int l, const int r,
+									   SortCompareFunc comparefunc, struct ThreadPool* pool);
+
+	/*
+	 * Parallel stable mergesort of arr[l..r] with 'nthreads' threads (the number of
+	 * online processors if 'nthreads' <= 0).
+	 * Halves above a cutoff are sorted by tasks of a work-stealing thread pool, and
+	 * big merges are split between tasks by co-ranking (merge path), so the top
+	 * merges run in parallel too.
+	 */
+	SORT_API void mergesort_sort_parallel (void* arr[], const int l, const int r,
+										   SortCompareFunc comparefunc, const int nthreads);
+
+	/*
+	 * Sorts 'n' contiguous elements of 'size' bytes each starting at 'base' using the
+	 * merge sort algorithm (stable).
+	 * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+	 */
+	SORT_API void mergesort_sort_values (void* base, const size_t n, const size_t size,
+										 SortCompareFunc comparefunc);
 
 #endif /* MERGESORT_H_ */
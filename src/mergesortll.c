@@ -36,6 +36,7 @@
  */
 
 #include "sort.h"
+#include "mergesortll.h"
 #include "llsort.h"
 #include "linkedlist.h"
 #include <assert.h>
@@ -11,6 +11,7 @@
 
 	#include "linkedlist.h"
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
 	 * Sorts the linked list using merge sort algorithm by changing
@@ -19,7 +20,7 @@
 	 * Time complexity: O(nlog(n))
 	 * Space complexity: O(1)
 	 * */
-	void mergesortll_sort (struct LinkedList* list, SortCompareFunc comparefunc);
+	SORT_API void mergesortll_sort (struct LinkedList* list, SortCompareFunc comparefunc);
 
 	/*
 	 * Sorts the linked list using merge sort algorithm by changing
@@ -28,6 +29,6 @@
 	 * Time complexity: O(nlog(n))
 	 * Space complexity: O(1)
 	 * */
-	void mergesortll_sort_with_it_merge (struct LinkedList* list, SortCompareFunc comparefunc);
+	SORT_API void mergesortll_sort_with_it_merge (struct LinkedList* list, SortCompareFunc comparefunc);
 
 #endif /* MERGESORTLL_H_ */
@@ -0,0 +1,441 @@
+/*
+ * pdqsort.c
+ *
+ *  Created on: 16/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements the Pattern-defeating quicksort (pdqsort) sorting algorithm.
+ *
+ *
+ * About:
+ *
+ *    Pattern-defeating quicksort, by Orson Peters, is a hybrid sorting algorithm that
+ *    combines the fast average case of randomized quicksort with the fast worst case of
+ *    heapsort, while achieving linear time on inputs with certain patterns. It is the
+ *    unstable sort of the Rust and Go standard libraries and of Boost.
+ *
+ *    Like Introsort it switches to insertion sort on small ranges and to heapsort when
+ *    quicksort goes wrong, but it adds a few ideas on top of it:
+ *
+ *    1. Pivot selection: median of 3 on small ranges and Tukey's ninther (median of
+ *       three medians of 3) on big ranges.
+ *
+ *    2. Partition: elements equal to the pivot go to the right side, so no swaps are
+ *       done for them. When no swap was needed at all the range was already
+ *       partitioned, and a partial insertion sort is tried on both sides. It gives up
+ *       after a few moves, so it costs almost nothing when the guess is wrong and
+ *       sorts (nearly) sorted and reversed inputs in linear time.
+ *
+ *    3. Many equal keys: when the chosen pivot is equal to the element just before the
+ *       range (the pivot of the previous partition), every element of the range is
+ *       greater or equal than it. The range is then partitioned the other way, with the
+ *       elements equal to the pivot on the left side, and that left side is done since
+ *       all of its elements are equal. Each distinct value is partitioned at most
+ *       twice, giving O(n*k) time for k distinct keys.
+ *
+ *    4. Bad partitions: a partition leaving less than 1/8 of the elements on one side
+ *       is considered bad. The pattern that produced it is broken by swapping a few
+ *       elements at fixed positions, and after log(n) bad partitions heapsort takes
+ *       over, which bounds the worst case to O(n*log n).
+ *
+ *
+ * Complexity Analysis:
+ *
+ * 	|---------------------------------------------------|
+ * 	| Best Case		Average Case		Worst Case   	|
+ * 	| --------------------------------------------------|
+ * 	| Ω(n) 			θ(n*log(n))			O(n*log(n))  	|
+ * 	|---------------------------------------------------|
+ *
+ * Space
+ *	O(log n)
+ *
+ * Stable
+ *	NO
+ *
+ *
+ * Sources:
+ * 		https://arxiv.org/abs/2106.05123
+ * 		https://github.com/orlp/pdqsort
+ *
+ */
+
+#include "sort.h"
+#include "pdqsort.h"
+#include "sortstats.h"
+
+// Partitions below this size are sorted using insertion sort
+static const int pdqsort_INSERTION_SORT_THRESHOLD = 24;
+
+// Partitions above this size use Tukey's ninther to select the pivot
+static const int pdqsort_NINTHER_THRESHOLD = 128;
+
+// When we detect an already sorted partition, attempt an insertion sort that
+// allows this amount of element moves before giving up
+static const int pdqsort_PARTIAL_INSERTION_SORT_LIMIT = 8;
+
+/*
+ * Sorts arr[begin..end[ using insertion sort.
+ */
+static void pdqsort_insertion_sort (void* arr[], const int begin, const int end,
+									SortCompareFunc comparefunc)
+{
+	for (int cur = begin + 1; cur < end; ++cur) {
+		int sift = cur;
+
+		// Compare first so we can avoid 2 moves for an element already positioned
+		// correctly
+		if (comparefunc (arr[sift], arr[sift - 1]) < 0) {
+			void* tmp = arr[sift];
+
+			do {
+				arr[sift] = arr[sift - 1];
+				sift--;
+			} while (sift != begin && (comparefunc (tmp, arr[sift - 1]) < 0));
+
+			arr[sift] = tmp;
+			SORTSTATS_MOVES (cur - sift + 1);
+		}
+	}
+}
+
+/*
+ * Sorts arr[begin..end[ using insertion sort.
+ * Assumes arr[begin - 1] is an element smaller than or equal to any element in
+ * [begin..end[, so the inner loop has no bounds check.
+ */
+static void pdqsort_unguarded_insertion_sort (void* arr[], const int begin,
+											  const int end,
+											  SortCompareFunc comparefunc)
+{
+	for (int cur = begin + 1; cur < end; ++cur) {
+		int sift = cur;
+
+		if (comparefunc (arr[sift], arr[sift - 1]) < 0) {
+			void* tmp = arr[sift];
+
+			do {
+				arr[sift] = arr[sift - 1];
+				sift--;
+			} while (comparefunc (tmp, arr[sift - 1]) < 0);
+
+			arr[sift] = tmp;
+			SORTSTATS_MOVES (cur - sift + 1);
+		}
+	}
+}
+
+/*
+ * Attempts to use insertion sort on arr[begin..end[. Gives up if more than
+ * 'pdqsort_PARTIAL_INSERTION_SORT_LIMIT' elements were moved.
+ * Returns 1 if the range is sorted, 0 otherwise.
+ */
+static int pdqsort_partial_insertion_sort (void* arr[], const int begin,
+										   const int end,
+										   SortCompareFunc comparefunc)
+{
+	int limit = 0;
+
+	for (int cur = begin + 1; cur < end; ++cur) {
+		int sift = cur;
+
+		if (comparefunc (arr[sift], arr[sift - 1]) < 0) {
+			void* tmp = arr[sift];
+
+			do {
+				arr[sift] = arr[sift - 1];
+				sift--;
+			} while (sift != begin && (comparefunc (tmp, arr[sift - 1]) < 0));
+
+			arr[sift] = tmp;
+			SORTSTATS_MOVES (cur - sift + 1);
+			limit += cur - sift;
+		}
+
+		if (limit > pdqsort_PARTIAL_INSERTION_SORT_LIMIT)
+			return 0;
+	}
+
+	return 1;
+}
+
+/*
+ * Sorts the two elements at indexes a and b.
+ */
+static void pdqsort_sort2 (void* arr[], const int a, const int b,
+						   SortCompareFunc comparefunc)
+{
+	if (comparefunc (arr[b], arr[a]) < 0)
+		sort_swap (&arr[a], &arr[b]);
+}
+
+/*
+ * Sorts the three elements at indexes a, b and c.
+ */
+static void pdqsort_sort3 (void* arr[], const int a, const int b, const int c,
+						   SortCompareFunc comparefunc)
+{
+	pdqsort_sort2 (arr, a, b, comparefunc);
+	pdqsort_sort2 (arr, b, c, comparefunc);
+	pdqsort_sort2 (arr, a, b, comparefunc);
+}
+
+/*
+ * Sifts down the element at index i of the max heap stored in arr[begin..begin+n[.
+ */
+static void pdqsort_sift_down (void* arr[], const int begin, int i, const int n,
+							   SortCompareFunc comparefunc)
+{
+	void* tmp = arr[begin + i];
+	int child;
+
+	while ((child = 2 * i + 1) < n) {
+		if (child + 1 < n &&
+				(comparefunc (arr[begin + child], arr[begin + child + 1]) < 0))
+			child++;
+
+		if (!(comparefunc (tmp, arr[begin + child]) < 0))
+			break;
+
+		arr[begin + i] = arr[begin + child];
+		SORTSTATS_MOVES (1);
+		i = child;
+	}
+
+	arr[begin + i] = tmp;
+	SORTSTATS_MOVES (1);
+}
+
+/*
+ * Sorts arr[begin..end[ using heap sort, the O(n*log n) worst case fallback.
+ */
+static void pdqsort_heapsort (void* arr[], const int begin, const int end,
+							  SortCompareFunc comparefunc)
+{
+	int n = end - begin;
+
+	for (int i = n / 2 - 1; i >= 0; i--)
+		pdqsort_sift_down (arr, begin, i, n, comparefunc);
+
+	for (int i = n - 1; i > 0; i--) {
+		sort_swap (&arr[begin], &arr[begin + i]);
+		pdqsort_sift_down (arr, begin, 0, i, comparefunc);
+	}
+}
+
+/*
+ * Partitions arr[begin..end[ around pivot arr[begin]. Elements equal to the pivot are
+ * put in the right-hand partition.
+ * Returns the position of the pivot after partitioning. 'alreadypartitioned' is set
+ * to 1 if no swap was needed.
+ * Note: Assumes the pivot is a median of at least 3 elements and that arr[begin..end[
+ * 		 is at least 'pdqsort_INSERTION_SORT_THRESHOLD' long.
+ */
+static int pdqsort_partition_right (void* arr[], const int begin, const int end,
+									SortCompareFunc comparefunc,
+									int* alreadypartitioned)
+{
+	void* pivot = arr[begin];
+	int first = begin;
+	int last = end;
+
+	// Find the first element greater than or equal than the pivot (the median of 3
+	// guarantees this exists)
+	while (comparefunc (arr[++first], pivot) < 0)
+		;
+
+	// Find the first element strictly smaller than the pivot. We have to guard this
+	// search if there was no element before *first
+	if (first - 1 == begin)
+		while (first < last && !(comparefunc (arr[--last], pivot) < 0))
+			;
+	else
+		while (!(comparefunc (arr[--last], pivot) < 0))
+			;
+
+	// If the first pair of elements that should be swapped to partition are the same
+	// element, the passed in sequence already was correctly partitioned
+	*alreadypartitioned = (first >= last);
+
+	// Keep swapping pairs of elements that are on the wrong side of the pivot.
+	// Previously swapped pairs guard the searches, which is why the first iteration is
+	// special-cased above
+	while (first < last) {
+		sort_swap (&arr[first], &arr[last]);
+		while (comparefunc (arr[++first], pivot) < 0)
+			;
+		while (!(comparefunc (arr[--last], pivot) < 0))
+			;
+	}
+
+	// Put the pivot in the right place
+	int pivotpos = first - 1;
+	arr[begin] = arr[pivotpos];
+	arr[pivotpos] = pivot;
+	SORTSTATS_MOVES (2);
+
+	return pivotpos;
+}
+
+/*
+ * Similar function to the one above, except elements equal to the pivot are put to the
+ * left of the pivot and it doesn't check or return if the passed sequence already was
+ * partitioned.
+ * Since this is rarely used (the many equal case), and in that case pdqsort already
+ * has O(n) performance, no block quicksort is applied here for simplicity.
+ */
+static int pdqsort_partition_left (void* arr[], const int begin, const int end,
+								   SortCompareFunc comparefunc)
+{
+	void* pivot = arr[begin];
+	int first = begin;
+	int last = end;
+
+	while (comparefunc (pivot, arr[--last]) < 0)
+		;
+
+	if (last + 1 == end)
+		while (first < last && !(comparefunc (pivot, arr[++first]) < 0))
+			;
+	else
+		while (!(comparefunc (pivot, arr[++first]) < 0))
+			;
+
+	while (first < last) {
+		sort_swap (&arr[first], &arr[last]);
+		while (comparefunc (pivot, arr[--last]) < 0)
+			;
+		while (!(comparefunc (pivot, arr[++first]) < 0))
+			;
+	}
+
+	int pivotpos = last;
+	arr[begin] = arr[pivotpos];
+	arr[pivotpos] = pivot;
+	SORTSTATS_MOVES (2);
+
+	return pivotpos;
+}
+
+/*
+ * Shuffles a few elements of a bad partition side arr[begin..end[ at fixed
+ * positions, breaking the pattern that produced it.
+ */
+static void pdqsort_break_patterns (void* arr[], const int begin, const int end)
+{
+	int size = end - begin;
+	int q = size / 4;
+
+	if (size < pdqsort_INSERTION_SORT_THRESHOLD)
+		return;
+
+	sort_swap (&arr[begin], &arr[begin + q]);
+	sort_swap (&arr[end - 1], &arr[end - q]);
+
+	if (size > pdqsort_NINTHER_THRESHOLD) {
+		sort_swap (&arr[begin + 1], &arr[begin + (q + 1)]);
+		sort_swap (&arr[begin + 2], &arr[begin + (q + 2)]);
+		sort_swap (&arr[end - 2], &arr[end - (q + 1)]);
+		sort_swap (&arr[end - 3], &arr[end - (q + 2)]);
+	}
+}
+
+/*
+ * Main pdqsort loop on arr[begin..end[.
+ * 'badallowed' is the number of bad partitions allowed before switching to heapsort,
+ * 'leftmost' tells if there is no element before begin (so arr[begin - 1] can not
+ * be used as a sentinel).
+ */
+static void pdqsort_loop (void* arr[], int begin, const int end,
+						  SortCompareFunc comparefunc, int badallowed, int leftmost)
+{
+	// Use a while loop for tail recursion elimination
+	while (1) {
+		int size = end - begin;
+
+		// Insertion sort is faster for small arrays
+		if (size < pdqsort_INSERTION_SORT_THRESHOLD) {
+			if (leftmost)
+				pdqsort_insertion_sort (arr, begin, end, comparefunc);
+			else
+				pdqsort_unguarded_insertion_sort (arr, begin, end, comparefunc);
+			return;
+		}
+
+		// Choose pivot as median of 3 or pseudomedian of 9
+		int s2 = size / 2;
+		if (size > pdqsort_NINTHER_THRESHOLD) {
+			pdqsort_sort3 (arr, begin, begin + s2, end - 1, comparefunc);
+			pdqsort_sort3 (arr, begin + 1, begin + (s2 - 1), end - 2, comparefunc);
+			pdqsort_sort3 (arr, begin + 2, begin + (s2 + 1), end - 3, comparefunc);
+			pdqsort_sort3 (arr, begin + (s2 - 1), begin + s2, begin + (s2 + 1), comparefunc);
+			sort_swap (&arr[begin], &arr[begin + s2]);
+		}
+		else
+			pdqsort_sort3 (arr, begin + s2, begin, end - 1, comparefunc);
+
+		// If arr[begin - 1] is the end of the right partition of a previous partition
+		// operation we know that arr[begin - 1] is smaller or equal to every element of
+		// the range. So if it is equal to the pivot, there is no element smaller than
+		// the pivot: put all keys equal to it on the left and leave them alone
+		if (!leftmost && !(comparefunc (arr[begin - 1], arr[begin]) < 0)) {
+			begin = pdqsort_partition_left (arr, begin, end, comparefunc) + 1;
+			continue;
+		}
+
+		// Partition and get results
+		int alreadypartitioned;
+		int pivotpos = pdqsort_partition_right (arr, begin, end, comparefunc,
+												&alreadypartitioned);
+
+		// Check for a highly unbalanced partition
+		int lsize = pivotpos - begin;
+		int rsize = end - (pivotpos + 1);
+		int highlyunbalanced = (lsize < size / 8) || (rsize < size / 8);
+
+		if (highlyunbalanced) {
+			// If we had too many bad partitions, switch to heapsort to guarantee
+			// O(n*log n)
+			if (--badallowed == 0) {
+				pdqsort_heapsort (arr, begin, end, comparefunc);
+				return;
+			}
+
+			pdqsort_break_patterns (arr, begin, pivotpos);
+			pdqsort_break_patterns (arr, pivotpos + 1, end);
+		}
+		else {
+			// If we were decently balanced and we tried to sort an already partitioned
+			// sequence try to use insertion sort
+			if (alreadypartitioned &&
+					pdqsort_partial_insertion_sort (arr, begin, pivotpos, comparefunc) &&
+					pdqsort_partial_insertion_sort (arr, pivotpos + 1, end, comparefunc))
+				return;
+		}
+
+		// Sort the left partition first using recursion and do tail recursion
+		// elimination for the right-hand partition
+		pdqsort_loop (arr, begin, pivotpos, comparefunc, badallowed, leftmost);
+		begin = pivotpos + 1;
+		leftmost = 0;
+	}
+}
+
+/*
+ * Sorts an array or part of an array items [from..to] using the pattern-defeating
+ * quicksort algorithm.
+ * Note: from (inclusive) .. to (inclusive)
+ */
+void pdqsort_sort (void* arr[], const int from, const int to,
+				   SortCompareFunc comparefunc)
+{
+	int size = to - from + 1;
+	if (size < 2)
+		return;
+
+	// Number of bad partitions allowed, floor(log2(size))
+	int badallowed = 0;
+	while (size >>= 1)
+		badallowed++;
+
+	pdqsort_loop (arr, from, to + 1, comparefunc, badallowed, 1);
+}
@@ -0,0 +1,26 @@
+/*
+ * pdqsort.h
+ *
+ *  Created on: 16/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the Pattern-defeating quicksort (pdqsort) sorting
+ * 				algorithm.
+ */
+
+#ifndef PDQSORT_H_
+	#define PDQSORT_H_
+
+	#include "sort.h"
+	#include "sortapi.h"
+
+	/*
+	 * Sorts an array or part of an array items [from..to] using the pattern-defeating
+	 * quicksort algorithm.
+	 * It is a drop-in replacement for 'introsort_sort ()' that runs in linear time on
+	 * sorted, reversed and many repeated keys inputs.
+	 * Note: from (inclusive) .. to (inclusive)
+	 */
+	SORT_API void pdqsort_sort (void* arr[], const int from, const int to,
+								SortCompareFunc comparefunc);
+
+#endif /* PDQSORT_H_ */
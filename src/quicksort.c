@@ -45,11 +45,14 @@
 
 #include <stdio.h>
 #include "quicksort.h"
+#include "insertionsort.h"
+#include "sortstats.h"
 
 /*
  * Swap a and b data pointers.
  * */
 void quicksort_swap (void** a, void** b) {
+	SORTSTATS_SWAP ();
 	void* t = *a;
 	*a = *b;
 	*b = t;
@@ -86,25 +89,439 @@ int quicksort_partition (void* array[], int low, int high, int (*comparefunc)(co
 	return (i + 1);
 }
 
+/*
+ * Moves the median of array[low], array[middle] and array[high] to array[high],
+ * where 'quicksort_partition ()' takes its pivot from.
+ * Note: Taking the rightmost element as pivot is quadratic on already sorted input,
+ * 		 the median of three keeps sorted and reversed input at O(n*log n).
+ * */
+static void quicksort_median_of_three (void* array[], const int low, const int high,
+									   SortCompareFunc comparefunc) {
+	int mid = low + (high - low) / 2;
+
+	// order array[low] <= array[mid] <= array[high], then park median at high
+	if (comparefunc (array[mid], array[low]) < 0)
+		quicksort_swap (&array[mid], &array[low]);
+	if (comparefunc (array[high], array[low]) < 0)
+		quicksort_swap (&array[high], &array[low]);
+	if (comparefunc (array[high], array[mid]) < 0)
+		quicksort_swap (&array[high], &array[mid]);
+
+	quicksort_swap (&array[mid], &array[high]);
+}
+
 /*
  * Quicksort recursive algorithm.
  * Returns the source array with its elements sorted.
+ * Note: Recurses on the smaller side and loops on the bigger one, so the stack
+ * 		 depth is O(log n) even on bad pivots.
  * */
-void quicksort_sort (void* array[], const int low, const int high,
+void quicksort_sort (void* array[], int low, int high,
 					 SortCompareFunc comparefunc) {
 		//void (*swapfunc)(void* a, void* b)) {
-	if (low < high) {
+	while (low < high) {
+
+		if (high - low > 2)
+			quicksort_median_of_three (array, low, high, comparefunc);
 
 		// find the pivot element such that
 		// elements smaller than pivot are on left of pivot
 		// elements greater than pivot are on right of pivot
 		int pi = quicksort_partition (array, low, high, comparefunc);
 
-		// recursive call on the left of pivot
-		quicksort_sort (array, low, pi - 1, comparefunc);
+		// recursive call on the smaller side of pivot
+		if (pi - low < high - pi) {
+			quicksort_sort (array, low, pi - 1, comparefunc);
+			low = pi + 1;
+		}
+		else {
+			quicksort_sort (array, pi + 1, high, comparefunc);
+			high = pi - 1;
+		}
+	}
+}
+
+
+/*
+ * Parallel quicksort section.
+ *
+ * About:
+ *
+ *    After each partition both sides are independent, so one side is submitted to the
+ *    thread pool as a new task while the current thread keeps partitioning the other
+ *    one. Ranges below 'quicksort_PARALLEL_CUTOFF' are sorted by the sequential
+ *    'quicksort_sort ()'.
+ *
+ *    Spawning tasks alone does not scale: the first partition is O(n) and runs on a
+ *    single thread, the next two on two threads, and so on. So big ranges are also
+ *    partitioned in parallel:
+ *
+ *      1. The range is split in blocks and every block is partitioned by its own task
+ *         around the same pivot value.
+ *      2. The size of the left side 'm' is the sum of the left sizes of the blocks.
+ *         Elements belonging to the right side found before 'm' and elements belonging
+ *         to the left side found after 'm' are misplaced, and there are as many of one
+ *         kind as of the other.
+ *      3. The misplaced elements are swapped pairwise, again split between tasks.
+ *
+ *    To keep inputs with many repeated keys from degenerating, partitioning is done
+ *    against 'x < pivot' first and, when the right side is too big, the right side is
+ *    partitioned again against 'x <= pivot'. Keys equal to the pivot end up in the
+ *    middle and are left out of the recursion.
+ */
+
+// Ranges up to this size are sorted sequentially by a single task
+static const int quicksort_PARALLEL_CUTOFF = 8192;
+
+// Minimum number of elements of each block of a parallel partition
+static const int quicksort_PARTITION_BLOCK = 32768;
+
+// A range to sort, shared by the tasks of a parallel sort
+struct QuicksortJob {
+	void** array;
+	int low;
+	int high;
+	SortCompareFunc comparefunc;
+	struct ThreadPool* pool;
+	struct ThreadPoolGroup* group;
+};
+
+// A block of a parallel partition
+struct QuicksortBlock {
+	void** array;
+	int from;					// first index of block
+	int end;					// index after the last one of the block
+	void* pivot;
+	int orequal;				// left side is 'x <= pivot' instead of 'x < pivot'
+	SortCompareFunc comparefunc;
+	int split;					// first index of the right side, after partition
+};
+
+// Misplaced elements of a parallel partition: lists of intervals [from..end[ with
+// elements to move right and elements to move left
+struct QuicksortMisplaced {
+	void** array;
+	int* rightfrom; int* rightend;
+	int* leftfrom; int* leftend;
+	int first;					// rank of first pair of misplaced elements to swap
+	int last;					// rank after the last pair to swap
+};
+
+/*
+ * Checks if an element belongs to the left side of a partition.
+ * */
+static int quicksort_goes_left (void* x, void* pivot, const int orequal,
+								SortCompareFunc comparefunc) {
+	int c = comparefunc (x, pivot);
+	return orequal ? (c <= 0) : (c < 0);
+}
+
+/*
+ * Partitions array[from..end[ with Hoare's two pointers scheme, elements going to
+ * the left side first.
+ * Returns the index of the first element of the right side.
+ * */
+static int quicksort_partition_block (void* array[], const int from, const int end,
+									  void* pivot, const int orequal,
+									  SortCompareFunc comparefunc) {
+	int i = from;
+	int j = end - 1;
 
-		// recursive call on the right of pivot
-		quicksort_sort (array, pi + 1, high, comparefunc);
+	while (1) {
+		while (i <= j && quicksort_goes_left (array[i], pivot, orequal, comparefunc))
+			i++;
+		while (i <= j && !quicksort_goes_left (array[j], pivot, orequal, comparefunc))
+			j--;
+		if (i >= j)
+			break;
+
+		quicksort_swap (&array[i++], &array[j--]);
+	}
+
+	return i;
+}
+
+/*
+ * Task partitioning a block of a parallel partition.
+ * */
+static void quicksort_partition_block_task (void* arg) {
+	struct QuicksortBlock* block = arg;
+	block->split = quicksort_partition_block (block->array, block->from, block->end,
+											  block->pivot, block->orequal,
+											  block->comparefunc);
+}
+
+/*
+ * Finds the misplaced element of given rank on a list of intervals.
+ * Sets 'k' to its interval and 'pos' to its index in array.
+ * */
+static void quicksort_misplaced_seek (const int* from, const int* end, int rank,
+									  int* k, int* pos) {
+	*k = 0;
+	while (rank >= end[*k] - from[*k]) {
+		rank -= end[*k] - from[*k];
+		(*k)++;
+	}
+	*pos = from[*k] + rank;
+}
+
+/*
+ * Task swapping a share of the misplaced elements of a parallel partition.
+ * */
+static void quicksort_swap_misplaced_task (void* arg) {
+	struct QuicksortMisplaced* m = arg;
+	int kr, r, kl, l;
+
+	if (m->last <= m->first)
+		return;
+
+	quicksort_misplaced_seek (m->rightfrom, m->rightend, m->first, &kr, &r);
+	quicksort_misplaced_seek (m->leftfrom, m->leftend, m->first, &kl, &l);
+
+	for (int i = m->first; i < m->last; ++i) {
+		quicksort_swap (&m->array[r++], &m->array[l++]);
+
+		// Move to next non empty interval when current one is exhausted
+		if (i + 1 < m->last) {
+			while (r == m->rightend[kr])
+				r = m->rightfrom[++kr];
+			while (l == m->leftend[kl])
+				l = m->leftfrom[++kl];
+		}
 	}
 }
 
+/*
+ * Partitions array[from..end[ using the threads of the pool.
+ * Returns the index of the first element of the right side.
+ * */
+static int quicksort_partition_parallel (const struct QuicksortJob* job,
+										 const int from, const int end,
+										 void* pivot, const int orequal) {
+	int n = end - from;
+	int nblocks = n / quicksort_PARTITION_BLOCK;
+	int nthreads = threadpool_num_threads (job->pool);
+	if (nblocks > nthreads)
+		nblocks = nthreads;
+
+	struct QuicksortBlock* blocks = NULL;
+	if (nblocks > 1)
+		blocks = sortstats_malloc (nblocks * sizeof (struct QuicksortBlock));
+
+	if (blocks == NULL)
+		return quicksort_partition_block (job->array, from, end, pivot, orequal,
+										  job->comparefunc);
+
+	// 1. Partition each block on its own
+	struct ThreadPoolGroup group;
+	threadpool_group_init (&group);
+	for (int b = 0; b < nblocks; ++b) {
+		blocks[b].array = job->array;
+		blocks[b].from = from + (int)(((long long)n * b) / nblocks);
+		blocks[b].end = from + (int)(((long long)n * (b + 1)) / nblocks);
+		blocks[b].pivot = pivot;
+		blocks[b].orequal = orequal;
+		blocks[b].comparefunc = job->comparefunc;
+		if (b > 0)
+			threadpool_submit (job->pool, &group, quicksort_partition_block_task, &blocks[b]);
+	}
+	quicksort_partition_block_task (&blocks[0]);
+	threadpool_wait (job->pool, &group);
+
+	// 2. Find split point and misplaced elements on each side of it
+	int split = from;
+	for (int b = 0; b < nblocks; ++b)
+		split += blocks[b].split - blocks[b].from;
+
+	// Shares of the misplaced elements, followed by the 4 intervals of each block
+	struct QuicksortMisplaced* shares = sortstats_malloc (nblocks * sizeof (*shares) +
+														  4 * nblocks * sizeof (int));
+	if (shares == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for parallel partition.");
+		abort ();
+	}
+
+	int* intervals = (int*)(shares + nblocks);
+	int* rightfrom = intervals;
+	int* rightend = intervals + nblocks;
+	int* leftfrom = intervals + 2 * nblocks;
+	int* leftend = intervals + 3 * nblocks;
+	int nmisplaced = 0;
+	for (int b = 0; b < nblocks; ++b) {
+		// right side elements of block before split
+		rightfrom[b] = blocks[b].split;
+		rightend[b] = (blocks[b].end < split) ? blocks[b].end : split;
+		if (rightend[b] < rightfrom[b])
+			rightend[b] = rightfrom[b];
+
+		// left side elements of block after split
+		leftfrom[b] = (blocks[b].from > split) ? blocks[b].from : split;
+		leftend[b] = blocks[b].split;
+		if (leftend[b] < leftfrom[b])
+			leftend[b] = leftfrom[b];
+
+		nmisplaced += rightend[b] - rightfrom[b];
+	}
+
+	// 3. Swap misplaced elements
+	if (nmisplaced > 0) {
+		for (int b = 0; b < nblocks; ++b) {
+			shares[b].array = job->array;
+			shares[b].rightfrom = rightfrom;
+			shares[b].rightend = rightend;
+			shares[b].leftfrom = leftfrom;
+			shares[b].leftend = leftend;
+			shares[b].first = (int)(((long long)nmisplaced * b) / nblocks);
+			shares[b].last = (int)(((long long)nmisplaced * (b + 1)) / nblocks);
+			if (b > 0)
+				threadpool_submit (job->pool, &group, quicksort_swap_misplaced_task, &shares[b]);
+		}
+		quicksort_swap_misplaced_task (&shares[0]);
+		threadpool_wait (job->pool, &group);
+	}
+
+	sortstats_free (shares);
+	sortstats_free (blocks);
+	return split;
+}
+
+/*
+ * Picks the pivot of a big range as the median of three medians of three
+ * (Tukey's ninther).
+ * */
+static void* quicksort_ninther (void* array[], const int low, const int high,
+								SortCompareFunc comparefunc) {
+	int step = (high - low) / 8;
+	void* m[3];
+	for (int k = 0; k < 3; ++k) {
+		int c = low + step + k * 3 * step;
+		void* a = array[c - step];
+		void* b = array[c];
+		void* d = array[c + step];
+
+		if (comparefunc (a, b) > 0) { void* t = a; a = b; b = t; }
+		if (comparefunc (b, d) > 0) b = (comparefunc (a, d) > 0) ? a : d;
+		m[k] = b;
+	}
+
+	if (comparefunc (m[0], m[1]) > 0) { void* t = m[0]; m[0] = m[1]; m[1] = t; }
+	if (comparefunc (m[1], m[2]) > 0)
+		m[1] = (comparefunc (m[0], m[2]) > 0) ? m[0] : m[2];
+
+	return m[1];
+}
+
+static void quicksort_parallel_rec (struct QuicksortJob job);
+
+/*
+ * Task sorting a range of a parallel sort.
+ * */
+static void quicksort_parallel_task (void* arg) {
+	struct QuicksortJob job = *((struct QuicksortJob*)arg);
+	sortstats_free (arg);
+	quicksort_parallel_rec (job);
+}
+
+/*
+ * Sorts job range, handing one side of each partition to the thread pool.
+ * */
+static void quicksort_parallel_rec (struct QuicksortJob job) {
+	while (job.high - job.low + 1 > quicksort_PARALLEL_CUTOFF) {
+		int end = job.high + 1;
+		void* pivot = quicksort_ninther (job.array, job.low, job.high, job.comparefunc);
+
+		// [low..lt[ < pivot, [lt..gt[ == pivot, [gt..end[ > pivot
+		int lt = quicksort_partition_parallel (&job, job.low, end, pivot, 0);
+		int gt = lt;
+		if (4 * (end - lt) > 3 * (end - job.low))
+			gt = quicksort_partition_parallel (&job, lt, end, pivot, 1);
+
+		// Hand the left side to the pool, keep going with the right side
+		struct QuicksortJob* left = sortstats_malloc (sizeof (struct QuicksortJob));
+		if (left != NULL) {
+			*left = job;
+			left->high = lt - 1;
+			threadpool_submit (job.pool, job.group, quicksort_parallel_task, left);
+		}
+		else
+			quicksort_sort (job.array, job.low, lt - 1, job.comparefunc);
+
+		job.low = gt;
+	}
+
+	quicksort_sort (job.array, job.low, job.high, job.comparefunc);
+}
+
+/*
+ * Parallel quicksort running on the threads of the given pool.
+ * 'low' and 'high' are inclusive array bounds to sort.
+ * */
+void quicksort_sort_pool (void* array[], const int low, const int high,
+						  SortCompareFunc comparefunc, struct ThreadPool* pool) {
+	struct ThreadPoolGroup group;
+	threadpool_group_init (&group);
+
+	struct QuicksortJob job = { array, low, high, comparefunc, pool, &group };
+	quicksort_parallel_rec (job);
+	threadpool_wait (pool, &group);
+}
+
+/*
+ * Parallel quicksort with 'nthreads' threads (the number of online processors if
+ * 'nthreads' <= 0).
+ * 'low' and 'high' are inclusive array bounds to sort.
+ * */
+void quicksort_sort_parallel (void* array[], const int low, const int high,
+							  SortCompareFunc comparefunc, const int nthreads) {
+	struct ThreadPool* pool = NULL;
+	if ((high - low + 1 > quicksort_PARALLEL_CUTOFF) && (nthreads != 1))
+		pool = threadpool_create (nthreads);
+
+	if (pool == NULL) {
+		quicksort_sort (array, low, high, comparefunc);
+		return;
+	}
+
+	quicksort_sort_pool (array, low, high, comparefunc, pool);
+	threadpool_destroy (pool);
+}
+
+
+/*
+ * Contiguous values section.
+ *
+ * Same algorithm for arrays of fixed size elements stored one after the other
+ * (like 'qsort ()'), so comparisons read the elements directly instead of following
+ * pointers to them. Partitioning uses Hoare's scheme, that swaps less elements than
+ * Lomuto's, since each swap moves whole elements.
+ */
+
+// Partitions up to this size are sorted with insertion sort
+static const size_t quicksort_VALUES_INSERTION_SORT = 16;
+
+/*
+ * Sorts 'n' contiguous elements of 'size' bytes each starting at 'base' using the
+ * quicksort algorithm.
+ * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+ * */
+void quicksort_sort_values (void* base, size_t n, const size_t size,
+							SortCompareFunc comparefunc) {
+	char* arr = base;
+
+	while (n > quicksort_VALUES_INSERTION_SORT) {
+		size_t pi = sort_partition_values (arr, n, size, comparefunc);
+
+		// recursive call on the smaller side of pivot
+		if (pi < n - pi - 1) {
+			quicksort_sort_values (arr, pi, size, comparefunc);
+			arr += (pi + 1) * size;
+			n -= pi + 1;
+		}
+		else {
+			quicksort_sort_values (arr + (pi + 1) * size, n - pi - 1, size, comparefunc);
+			n = pi;
+		}
+	}
+
+	insertionsort_sort_values (arr, n, size, comparefunc);
+}
@@ -44,9 +44,36 @@
 	#define QUICKSORT_H_
 
 	#include "sort.h"
+	#include "threadpool.h"
+	#include "sortapi.h"
 
-	void quicksort_sort (void* array[], const int low, const int high,
-						 SortCompareFunc comparefunc);
+	SORT_API void quicksort_sort (void* array[], const int low, const int high,
+								  SortCompareFunc comparefunc);
+
+	/*
+	 * Parallel quicksort running on the threads of the given pool.
+	 * 'low' and 'high' are inclusive array bounds to sort.
+	 */
+	SORT_API void quicksort_sort_pool (void* array[], const int low, const int high,
+									   SortCompareFunc comparefunc, struct ThreadPool* pool);
+
+	/*
+	 * Parallel quicksort with 'nthreads' threads (the number of online processors if
+	 * 'nthreads' <= 0).
+	 * Ranges above a cutoff are partitioned by several threads and become tasks of a
+	 * work-stealing thread pool, smaller ones are sorted by 'quicksort_sort ()'.
+	 * 'low' and 'high' are inclusive array bounds to sort.
+	 */
+	SORT_API void quicksort_sort_parallel (void* array[], const int low, const int high,
+										   SortCompareFunc comparefunc, const int nthreads);
+
+	/*
+	 * Sorts 'n' contiguous elements of 'size' bytes each starting at 'base' using the
+	 * quicksort algorithm.
+	 * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+	 */
+	SORT_API void quicksort_sort_values (void* base, const size_t n, const size_t size,
+										 SortCompareFunc comparefunc);
 
 #endif /* QUICKSORT_H_ */
 
@@ -34,6 +34,7 @@
 
 #include <stdlib.h>
 #include "sort.h"
+#include "quicksortll.h"
 #include "linkedlist.h"
 
 /*
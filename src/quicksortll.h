@@ -11,20 +11,21 @@
 
 	#include "sort.h"
 	#include "linkedlist.h"
+	#include "sortapi.h"
 
 	/*
 	 * Performs quick sort in the given linked list.
 	 * (recursive function)
 	 */
-	void quicksortll_sort_recu (struct LinkedListNode* first,
-						   	    struct LinkedListNode* last,
-								SortCompareFunc comparefunc);
+	SORT_API void quicksortll_sort_recu (struct LinkedListNode* first,
+										 struct LinkedListNode* last,
+										 SortCompareFunc comparefunc);
 
 	/*
 	 * Performs quick sort in the given linked list.
 	 * Note: Invokes quicksort recursive function.
 	 */
-	void quicksortll_sort (struct LinkedList* list,
-						   SortCompareFunc comparefunc);
+	SORT_API void quicksortll_sort (struct LinkedList* list,
+									SortCompareFunc comparefunc);
 
 #endif /* QUICKSORTLL_H_ */
@@ -0,0 +1,145 @@
+/*
+ * radixsortdef.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Header only generator of the LSD Radix sort (radix 256) of arrays of
+ * 				keys or of (key, item) pairs, shared by radixsortlsd.c,
+ * 				radixsortkey.c and argsort.c.
+ *
+ * About:
+ *
+ *    'RADIXSORT_DEFINE_LSD (name, type, ndigits, digitfunc, greaterfunc)' defines
+ *
+ *       static type* name (type arr[], type buf[], const size_t n);
+ *
+ *    that sorts arr[0..n-1] by their keys of 'ndigits' bytes and returns the array
+ *    that holds the sorted elements, 'arr' or 'buf' (n elements):
+ *
+ *       - the histograms of all the digits are computed in a single pass;
+ *       - one pass per digit, from the least significant to the most significant,
+ *         moves the elements between 'arr' and 'buf'. Passes where all keys have
+ *         the same digit are skipped;
+ *       - arrays smaller than 'RADIXSORTDEF_INSERTION_SORT_THRESHOLD' are sorted
+ *         with insertion sort in 'arr', and 'buf' is not used (it may be NULL).
+ *
+ *    'digitfunc (const type* e, const int d)' returns the byte 'd' (0 is the least
+ *    significant) of the key of 'e', 'greaterfunc (const type* a, const type* b)'
+ *    returns 1 if the key of 'a' is greater than the key of 'b'. The sort is stable.
+ *
+ *    'RADIXSORT_DEFINE_LSD_KEY (name, type, ktype, key_expr)' defines both functions
+ *    for keys of unsigned integer type 'ktype', 'key_expr' being the key of 'e':
+ *
+ *       struct Pair { uint32_t key; void* item; };
+ *       RADIXSORT_DEFINE_LSD_KEY (pair_radixsort, struct Pair, uint32_t, e->key)
+ *
+ */
+
+#ifndef RADIXSORTDEF_H_
+	#define RADIXSORTDEF_H_
+
+	#include <string.h>
+	#include "sortstats.h"
+
+	/*
+	 * Arrays smaller than this are sorted with insertion sort.
+	 */
+	#define RADIXSORTDEF_INSERTION_SORT_THRESHOLD 64
+
+	/*
+	 * Unrolls the loop over the digits of a key when building the histograms, so the
+	 * key is loaded and shifted in registers (GCC doesn't do it at -O2).
+	 */
+	#if defined (__GNUC__)
+		#define RADIXSORTDEF_UNROLL_ _Pragma ("GCC unroll 16")
+	#else
+		#define RADIXSORTDEF_UNROLL_
+	#endif
+
+	/*
+	 * Defines the LSD radix sort 'name' of arrays of 'type' by the digits returned
+	 * by 'digitfunc'.
+	 */
+	#define RADIXSORT_DEFINE_LSD(name, type, ndigits, digitfunc, greaterfunc) \
+		static type* name (type arr[], type buf[], const size_t n) \
+		{ \
+			if (n < (size_t)RADIXSORTDEF_INSERTION_SORT_THRESHOLD) { \
+				for (size_t i = 1; i < n; i++) { \
+					type p = arr[i]; \
+					size_t j = i; \
+					while ((j > 0) && greaterfunc (&arr[j - 1], &p)) { \
+						arr[j] = arr[j - 1]; \
+						j--; \
+					} \
+					arr[j] = p; \
+					SORTSTATS_MOVES (i - j + 1); \
+				} \
+				return arr; \
+			} \
+			\
+			size_t count[ndigits][256]; \
+			memset (count, 0, sizeof (count)); \
+			\
+			/* Histograms of all digits in a single pass */ \
+			for (size_t i = 0; i < n; i++) { \
+				const type e = arr[i]; \
+				RADIXSORTDEF_UNROLL_ \
+				for (int d = 0; d < (int)(ndigits); d++) \
+					count[d][digitfunc (&e, d)]++; \
+			} \
+			\
+			type* src = arr; \
+			type* dst = buf; \
+			\
+			for (int pass = 0; pass < (int)(ndigits); pass++) { \
+				size_t* c = count[pass]; \
+				\
+				/* All keys have the same digit, nothing to do */ \
+				if (c[digitfunc (&src[0], pass)] == n) \
+					continue; \
+				\
+				/* Counts to start positions */ \
+				size_t sum = 0; \
+				for (int d = 0; d < 256; d++) { \
+					size_t t = c[d]; \
+					c[d] = sum; \
+					sum += t; \
+				} \
+				\
+				for (size_t i = 0; i < n; i++) { \
+					const type e = src[i]; \
+					dst[c[digitfunc (&e, pass)]++] = e; \
+				} \
+				SORTSTATS_MOVES (n); \
+				\
+				type* t = src; \
+				src = dst; \
+				dst = t; \
+			} \
+			\
+			return src; \
+		}
+
+	/*
+	 * Defines the LSD radix sort 'name' of arrays of 'type' by the unsigned integer
+	 * key of type 'ktype' 'key_expr', an expression on the element pointer 'e'.
+	 */
+	#define RADIXSORT_DEFINE_LSD_KEY(name, type, ktype, key_expr) \
+		static inline ktype name##_key (const type* e) \
+		{ \
+			return (key_expr); \
+		} \
+		\
+		static inline unsigned name##_digit (const type* e, const int d) \
+		{ \
+			return (unsigned)(name##_key (e) >> (d * 8)) & 0xFF; \
+		} \
+		\
+		static inline int name##_greater (const type* a, const type* b) \
+		{ \
+			return name##_key (a) > name##_key (b); \
+		} \
+		\
+		RADIXSORT_DEFINE_LSD (name, type, sizeof (ktype), name##_digit, name##_greater)
+
+#endif /* RADIXSORTDEF_H_ */
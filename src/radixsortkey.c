@@ -0,0 +1,210 @@
+/*
+ * radixsortkey.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements the LSD Radix sort of arrays of items by a key extracted
+ * 				from each item.
+ *
+ * About:
+ *
+ * 	Arrays of pointers to records are usually sorted with a comparison function,
+ * 	which is called O(n log n) times and reads both records on each call. When the
+ * 	order of the records can be expressed by an unsigned integer key (32, 64 or 128
+ * 	bits), the records can be radix sorted instead with a few linear passes.
+ *
+ *
+ * Algorithm:
+ *
+ * 	1. The key function is called once per item and the (key, item) pairs are
+ * 	   gathered into a contiguous array, so the passes never read the records.
+ *
+ * 	2. The histograms of all the key bytes are computed in a single pass over the
+ * 	   pairs.
+ *
+ * 	3. The pairs are sorted by LSD radix sort (radix 256, see radixsortdef.h), one
+ * 	   byte per pass from the least significant to the most significant, moving them
+ * 	   between the pairs array and a buffer of the same size. Passes where all keys
+ * 	   have the same byte are skipped, so keys that use only a few low bytes need
+ * 	   only a few passes.
+ *
+ * 	4. The items are written back to the array in the order of the sorted pairs.
+ *
+ * 	Small arrays are sorted with insertion sort on the pairs. Every step is stable,
+ * 	so items with equal keys keep their relative order.
+ *
+ *
+ * Time Complexity: O(n * w) where w is the number of bytes of the key
+ *
+ * Auxiliary Space: O(n) (two arrays of n (key, item) pairs)
+ *
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "radixsortkey.h"
+#include "radixsortdef.h"
+#include "sortstats.h"
+
+/*
+ * Pairs of key and item sorted by the radix passes.
+ */
+struct RadixsortKeyPair32 {
+	uint32_t key;
+	void* item;
+};
+
+struct RadixsortKeyPair64 {
+	uint64_t key;
+	void* item;
+};
+
+struct RadixsortKeyPair128 {
+	uint64_t hi;
+	uint64_t lo;
+	void* item;
+};
+
+/*
+ * Allocates 2 * n pairs of 'size' bytes: the pairs array and the radix buffer.
+ */
+static void* radixsortkey_alloc_pairs (const size_t n, const size_t size)
+{
+	void* pairs = sortstats_malloc (2 * n * size);
+	if (pairs == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for radix sort key pairs.");
+		abort ();
+	}
+	return pairs;
+}
+
+/*
+ * Returns the byte 'digit' (0 is the least significant) of a 128 bits key.
+ */
+static inline unsigned radixsortkey_digit128 (const struct RadixsortKeyPair128* p,
+											  const int digit)
+{
+	if (digit < 8)
+		return (unsigned)(p->lo >> (digit * 8)) & 0xFF;
+	else
+		return (unsigned)(p->hi >> ((digit - 8) * 8)) & 0xFF;
+}
+
+/*
+ * Returns 1 if the key of pair 'a' is greater than the key of pair 'b'.
+ */
+static inline int radixsortkey_greater128 (const struct RadixsortKeyPair128* a,
+										   const struct RadixsortKeyPair128* b)
+{
+	return (a->hi > b->hi) || ((a->hi == b->hi) && (a->lo > b->lo));
+}
+
+/*
+ * LSD radix sorts of the pairs.
+ */
+RADIXSORT_DEFINE_LSD_KEY (radixsortkey_lsd32, struct RadixsortKeyPair32, uint32_t, e->key)
+RADIXSORT_DEFINE_LSD_KEY (radixsortkey_lsd64, struct RadixsortKeyPair64, uint64_t, e->key)
+RADIXSORT_DEFINE_LSD (radixsortkey_lsd128, struct RadixsortKeyPair128, 16,
+					  radixsortkey_digit128, radixsortkey_greater128)
+
+/*
+ * Sorts items arr[0..n-1] by their 32 bits keys.
+ */
+static void radixsortkey_sort32 (void* arr[], const size_t n, RadixSortKey32Func keyfunc)
+{
+	struct RadixsortKeyPair32* pairs = radixsortkey_alloc_pairs (n, sizeof (*pairs));
+
+	for (size_t i = 0; i < n; i++) {
+		pairs[i].key = keyfunc (arr[i]);
+		pairs[i].item = arr[i];
+	}
+
+	struct RadixsortKeyPair32* src = radixsortkey_lsd32 (pairs, pairs + n, n);
+
+	for (size_t i = 0; i < n; i++)
+		arr[i] = src[i].item;
+	SORTSTATS_MOVES (2 * n);		// to the pairs and back
+
+	sortstats_free (pairs);
+}
+
+/*
+ * Sorts items arr[0..n-1] by their 64 bits keys.
+ */
+static void radixsortkey_sort64 (void* arr[], const size_t n, RadixSortKey64Func keyfunc)
+{
+	struct RadixsortKeyPair64* pairs = radixsortkey_alloc_pairs (n, sizeof (*pairs));
+
+	for (size_t i = 0; i < n; i++) {
+		pairs[i].key = keyfunc (arr[i]);
+		pairs[i].item = arr[i];
+	}
+
+	struct RadixsortKeyPair64* src = radixsortkey_lsd64 (pairs, pairs + n, n);
+
+	for (size_t i = 0; i < n; i++)
+		arr[i] = src[i].item;
+	SORTSTATS_MOVES (2 * n);		// to the pairs and back
+
+	sortstats_free (pairs);
+}
+
+/*
+ * Sorts items arr[0..n-1] by their 128 bits keys.
+ */
+static void radixsortkey_sort128 (void* arr[], const size_t n, RadixSortKey128Func keyfunc)
+{
+	struct RadixsortKeyPair128* pairs = radixsortkey_alloc_pairs (n, sizeof (*pairs));
+
+	for (size_t i = 0; i < n; i++) {
+		struct RadixSortKey128 k = keyfunc (arr[i]);
+		pairs[i].hi = k.hi;
+		pairs[i].lo = k.lo;
+		pairs[i].item = arr[i];
+	}
+
+	struct RadixsortKeyPair128* src = radixsortkey_lsd128 (pairs, pairs + n, n);
+
+	for (size_t i = 0; i < n; i++)
+		arr[i] = src[i].item;
+	SORTSTATS_MOVES (2 * n);		// to the pairs and back
+
+	sortstats_free (pairs);
+}
+
+/*
+ * Sorts array or part of an array of items arr[from..to] by the 32 bits
+ * keys returned by 'keyfunc', using LSD Radix Sort.
+ * Uses a buffer of 2 * n (key, item) pairs.
+ * Note: from (inclusive) .. to (inclusive)
+ */
+void radixsortkey_sort_u32 (void* arr[], const int from, const int to,
+							RadixSortKey32Func keyfunc)
+{
+	if (to > from)
+		radixsortkey_sort32 (arr + from, (size_t)(to - from + 1), keyfunc);
+}
+
+/*
+ * Sorts array or part of an array of items arr[from..to] by the 64 bits
+ * keys returned by 'keyfunc', using LSD Radix Sort.
+ * Uses a buffer of 2 * n (key, item) pairs.
+ */
+void radixsortkey_sort_u64 (void* arr[], const int from, const int to,
+							RadixSortKey64Func keyfunc)
+{
+	if (to > from)
+		radixsortkey_sort64 (arr + from, (size_t)(to - from + 1), keyfunc);
+}
+
+/*
+ * Sorts array or part of an array of items arr[from..to] by the 128 bits
+ * keys returned by 'keyfunc', using LSD Radix Sort.
+ * Uses a buffer of 2 * n (key, item) pairs.
+ */
+void radixsortkey_sort_u128 (void* arr[], const int from, const int to,
+							 RadixSortKey128Func keyfunc)
+{
+	if (to > from)
+		radixsortkey_sort128 (arr + from, (size_t)(to - from + 1), keyfunc);
+}
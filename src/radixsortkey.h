@@ -0,0 +1,81 @@
+/*
+ * radixsortkey.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the LSD Radixsort of arrays of items by a key
+ * 				extracted from each item.
+ *
+ * 	The key function must return an order-preserving unsigned key: items are sorted
+ * 	in ascending order of their keys, compared as unsigned integers. The key of each
+ * 	item is computed only once. The sort is stable.
+ *
+ * 	Signed integers are turned into order-preserving keys by
+ * 	'radixsortkey_key_i32 ()' and 'radixsortkey_key_i64 ()'. Composite keys are
+ * 	packed from the most significant field to the least significant one, e.g. a
+ * 	record sorted by (year, day) has the key ((uint32_t)year << 16) | day.
+ */
+
+#ifndef RADIXSORTKEY_H_
+	#define RADIXSORTKEY_H_
+
+	#include <stdint.h>
+	#include "sortapi.h"
+
+	/*
+	 * 128 bits key, 'hi' is the most significant half.
+	 */
+	struct RadixSortKey128 {
+		uint64_t hi;
+		uint64_t lo;
+	};
+
+	/*
+	 * Functions that return the key of an item.
+	 */
+	typedef uint32_t (*RadixSortKey32Func)(const void* item);
+	typedef uint64_t (*RadixSortKey64Func)(const void* item);
+	typedef struct RadixSortKey128 (*RadixSortKey128Func)(const void* item);
+
+	/*
+	 * Returns the order-preserving unsigned key of a signed 32 bits integer.
+	 */
+	static inline uint32_t radixsortkey_key_i32 (const int32_t value)
+	{
+		return (uint32_t)value ^ UINT32_C (0x80000000);
+	}
+
+	/*
+	 * Returns the order-preserving unsigned key of a signed 64 bits integer.
+	 */
+	static inline uint64_t radixsortkey_key_i64 (const int64_t value)
+	{
+		return (uint64_t)value ^ UINT64_C (0x8000000000000000);
+	}
+
+	/*
+	 * Sorts array or part of an array of items arr[from..to] by the 32 bits
+	 * keys returned by 'keyfunc', using LSD Radix Sort.
+	 * Uses a buffer of 2 * n (key, item) pairs.
+	 * Note: from (inclusive) .. to (inclusive)
+	 */
+	SORT_API void radixsortkey_sort_u32 (void* arr[], const int from, const int to,
+										 RadixSortKey32Func keyfunc);
+
+	/*
+	 * Sorts array or part of an array of items arr[from..to] by the 64 bits
+	 * keys returned by 'keyfunc', using LSD Radix Sort.
+	 * Uses a buffer of 2 * n (key, item) pairs.
+	 */
+	SORT_API void radixsortkey_sort_u64 (void* arr[], const int from, const int to,
+										 RadixSortKey64Func keyfunc);
+
+	/*
+	 * Sorts array or part of an array of items arr[from..to] by the 128 bits
+	 * keys returned by 'keyfunc', using LSD Radix Sort.
+	 * Uses a buffer of 2 * n (key, item) pairs.
+	 */
+	SORT_API void radixsortkey_sort_u128 (void* arr[], const int from, const int to,
+										  RadixSortKey128Func keyfunc);
+
+#endif /* RADIXSORTKEY_H_ */
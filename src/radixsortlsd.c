@@ -5,7 +5,8 @@
  *      Author: Tiago C. Teixeira
  * Description: Implements the Radix sort sorting algorithm.
  *
- * Note: This LSD radix sort implementation only works for non negative integers.
+ * Note: Keys are processed one byte (radix 256) at a time, not in base 10, and
+ * 		 negative integers are supported by flipping the sign bit of the keys.
  *
  *
  * About:
@@ -113,7 +114,13 @@
  *      digit. Radix sort uses counting sort as a subroutine to sort.
  *
  *
- * 	Note: LSD radix sort implementation for non negative integers.
+ * 	Note: This implementation uses base 256 digits (the bytes of the key) instead
+ * 	of base 10, so a digit is a shift and a mask instead of a division and a modulo,
+ * 	and a 32 bits key takes at most 4 passes. The histograms of all digits are built
+ * 	in a single pass over the keys, passes where all keys share the same digit are
+ * 	skipped, and the keys are scattered back and forth between the array and a
+ * 	single heap buffer (see radixsortdef.h). Signed keys are sorted by flipping their sign bit when the
+ * 	digit is extracted, so negative keys come first.
  *
  *
  * When to use Radix Sort vs. Bucket Sort
@@ -130,69 +137,341 @@
  *
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "radixsortlsd.h"
+#include "radixsortkey.h"
+#include "radixsortdef.h"
+#include "sortstats.h"
+
 /*
- * A utility function to get maximum value in arr[from..to].
+ * Returns a buffer for n keys of size 'size' or aborts if it can't be allocated.
  */
-static int radixsortlsd_get_max (int arr[], const int from, const int to)
+static void* radixsortlsd_alloc_buffer (const size_t n, const size_t size)
 {
-    int mx = arr[from];
-    for (int i = (from + 1); i < (to+1); i++)
-        if (arr[i] > mx)
-            mx = arr[i];
-    return mx;
+	void* buf = sortstats_malloc (n * size);
+	if (buf == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for radix sort buffer.");
+		abort ();
+	}
+	return buf;
 }
 
 /*
-* A function to do counting sort of arr[] according to the digit represented by exp.
-*/
-static void radixsortlsd_countsort (int arr[], const int from, const int to, int exp)
+ * LSD radix sorts of unsigned and signed (sign bit flipped) 32 and 64 bits keys.
+ */
+RADIXSORT_DEFINE_LSD_KEY (radixsortlsd_lsd_u32, uint32_t, uint32_t, *e)
+RADIXSORT_DEFINE_LSD_KEY (radixsortlsd_lsd_i32, uint32_t, uint32_t,
+						  *e ^ UINT32_C (0x80000000))
+RADIXSORT_DEFINE_LSD_KEY (radixsortlsd_lsd_u64, uint64_t, uint64_t, *e)
+RADIXSORT_DEFINE_LSD_KEY (radixsortlsd_lsd_i64, uint64_t, uint64_t,
+						  *e ^ UINT64_C (0x8000000000000000))
+
+/*
+ * Sorts 32 bits keys arr[0..n-1], as signed integers if 'issigned' is not 0.
+ * 'buffer' holds n keys, if NULL a buffer is allocated.
+ */
+static void radixsortlsd_sort32 (uint32_t arr[], uint32_t buffer[], const size_t n,
+								 const int issigned)
 {
-	const int n = to - from + 1;
-	// Output array	\111													111111111111111111
-	int output[n];
-	int i, count[10] = { 0 };
+	uint32_t* buf = buffer;
+	if ((buf == NULL) && (n >= (size_t)RADIXSORTDEF_INSERTION_SORT_THRESHOLD))
+		buf = radixsortlsd_alloc_buffer (n, sizeof (uint32_t));
+
+	uint32_t* src = issigned ? radixsortlsd_lsd_i32 (arr, buf, n)
+							 : radixsortlsd_lsd_u32 (arr, buf, n);
 
-	// Store count of occurrences
-	// in count[]
-	for (i = from; i < (to + 1); i++)
-		count[(arr[i] / exp) % 10]++;
+	if (src != arr) {
+		memcpy (arr, src, n * sizeof (uint32_t));
+		SORTSTATS_MOVES (n);
+	}
+	if (buffer == NULL)
+		sortstats_free (buf);
+}
 
-	// Change count[i] so that count[i]
-	// now contains actual position
-	// of this digit in output[]
-	for (i = 1; i < 10; i++)
-		count[i] += count[i - 1];
+/*
+ * Sorts 64 bits keys arr[0..n-1], as signed integers if 'issigned' is not 0.
+ * 'buffer' holds n keys, if NULL a buffer is allocated.
+ */
+static void radixsortlsd_sort64 (uint64_t arr[], uint64_t buffer[], const size_t n,
+								 const int issigned)
+{
+	uint64_t* buf = buffer;
+	if ((buf == NULL) && (n >= (size_t)RADIXSORTDEF_INSERTION_SORT_THRESHOLD))
+		buf = radixsortlsd_alloc_buffer (n, sizeof (uint64_t));
+
+	uint64_t* src = issigned ? radixsortlsd_lsd_i64 (arr, buf, n)
+							 : radixsortlsd_lsd_u64 (arr, buf, n);
 
-	int cntidx;
-	// Build the output array
-	for (i = to; i >= from; i--) {
-		cntidx = (arr[i] / exp) % 10;
-		output[count[cntidx] - 1] = arr[i];
-		count[cntidx]--;
+	if (src != arr) {
+		memcpy (arr, src, n * sizeof (uint64_t));
+		SORTSTATS_MOVES (n);
 	}
+	if (buffer == NULL)
+		sortstats_free (buf);
+}
+
+/*
+ * Sorts unsigned 32 bits integers arr[from..to] using LSD Radix Sort.
+ */
+void radixsortlsd_sort_u32 (uint32_t arr[], const int from, const int to)
+{
+	if (to > from)
+		radixsortlsd_sort32 (arr + from, NULL, (size_t)(to - from + 1), 0);
+}
+
+/*
+ * Sorts signed 32 bits integers arr[from..to] using LSD Radix Sort.
+ */
+void radixsortlsd_sort_i32 (int32_t arr[], const int from, const int to)
+{
+	if (to > from)
+		radixsortlsd_sort32 ((uint32_t*)(arr + from), NULL, (size_t)(to - from + 1), 1);
+}
+
+/*
+ * Sorts unsigned 64 bits integers arr[from..to] using LSD Radix Sort.
+ */
+void radixsortlsd_sort_u64 (uint64_t arr[], const int from, const int to)
+{
+	if (to > from)
+		radixsortlsd_sort64 (arr + from, NULL, (size_t)(to - from + 1), 0);
+}
 
-	// Copy the output array to arr[],
-	// so that arr[] now contains sorted
-	// numbers according to current digit
-	for (i = 0; i < n; i++)
-		arr[i+from] = output[i];
+/*
+ * Sorts signed 64 bits integers arr[from..to] using LSD Radix Sort.
+ */
+void radixsortlsd_sort_i64 (int64_t arr[], const int from, const int to)
+{
+	if (to > from)
+		radixsortlsd_sort64 ((uint64_t*)(arr + from), NULL, (size_t)(to - from + 1), 1);
 }
 
 /*
  * The main function to that sorts integer arr[from..to] using Radix Sort.
- * Note: Only works for non-negative integers.
- * LSD radixsort implementation.
+ * LSD radixsort implementation, negative integers are supported.
  */
 void radixsortlsd_sort_ints (int arr[], const int from, const int to)
 {
-	// Find the maximum number to
-    // know number of digits
-    int m = radixsortlsd_get_max (arr, from, to);
+	radixsortlsd_sort_i32 ((int32_t*)arr, from, to);
+}
+
+/*
+ * Sorts floats arr[0..n-1] by their order-preserving keys: the sign bit of the
+ * positive values is set and all the bits of the negative ones are flipped.
+ * NaNs (and zeros if they are equal) are set aside at the end of the keys in
+ * reverse order, and put back in their place in input order.
+ */
+static void radixsortlsd_sort_float_keys (float arr[], const size_t n, const int flags)
+{
+	const uint32_t sign = UINT32_C (0x80000000);
+	const uint32_t inf = UINT32_C (0x7F800000);
+	const int zeros = (flags & RADIXSORTLSD_ZEROS_EQUAL) != 0;
+	uint32_t* keys = radixsortlsd_alloc_buffer (2 * n, sizeof (uint32_t));
+	size_t m = 0;		// keys of the numbers, keys[0..m-1]
+	size_t back = n;	// set aside values, keys[back..n-1]
+	size_t nneg = 0;
+	size_t nnan = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		uint32_t u;
+		memcpy (&u, &arr[i], sizeof (u));
+		if ((u & ~sign) > inf) {
+			keys[--back] = u;
+			nnan++;
+		}
+		else if (zeros && ((u & ~sign) == 0))
+			keys[--back] = u;
+		else {
+			uint32_t k = (u & sign) ? ~u : (u | sign);
+			keys[m++] = k;
+			nneg += (k < sign);
+		}
+	}
+
+	radixsortlsd_sort32 (keys, keys + n, m, 0);
+
+	// Numbers, with the zeros between the negative and the positive ones
+	const size_t nzero = n - m - nnan;
+	const size_t numpos = (flags & RADIXSORTLSD_NANS_FIRST) ? nnan : 0;
+	size_t nanpos = (flags & RADIXSORTLSD_NANS_FIRST) ? 0 : m + nzero;
+	size_t zeropos = numpos + nneg;
+
+	for (size_t j = 0; j < m; j++) {
+		uint32_t k = keys[j];
+		uint32_t u = (k & sign) ? (k ^ sign) : ~k;
+		memcpy (&arr[numpos + j + ((j < nneg) ? 0 : nzero)], &u, sizeof (u));
+	}
+
+	for (size_t i = n; i > back; ) {
+		uint32_t u = keys[--i];
+		if ((u & ~sign) > inf)
+			memcpy (&arr[nanpos++], &u, sizeof (u));
+		else
+			memcpy (&arr[zeropos++], &u, sizeof (u));
+	}
+	SORTSTATS_MOVES (2 * n);		// to the keys and back
+
+	sortstats_free (keys);
+}
+
+/*
+ * Sorts doubles arr[0..n-1] by their order-preserving keys, see
+ * 'radixsortlsd_sort_float_keys ()'.
+ */
+static void radixsortlsd_sort_double_keys (double arr[], const size_t n, const int flags)
+{
+	const uint64_t sign = UINT64_C (0x8000000000000000);
+	const uint64_t inf = UINT64_C (0x7FF0000000000000);
+	const int zeros = (flags & RADIXSORTLSD_ZEROS_EQUAL) != 0;
+	uint64_t* keys = radixsortlsd_alloc_buffer (2 * n, sizeof (uint64_t));
+	size_t m = 0;		// keys of the numbers, keys[0..m-1]
+	size_t back = n;	// set aside values, keys[back..n-1]
+	size_t nneg = 0;
+	size_t nnan = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		uint64_t u;
+		memcpy (&u, &arr[i], sizeof (u));
+		if ((u & ~sign) > inf) {
+			keys[--back] = u;
+			nnan++;
+		}
+		else if (zeros && ((u & ~sign) == 0))
+			keys[--back] = u;
+		else {
+			uint64_t k = (u & sign) ? ~u : (u | sign);
+			keys[m++] = k;
+			nneg += (k < sign);
+		}
+	}
 
-    // Do counting sort for every digit.
-    // Note that instead of passing digit
-    // number, exp is passed. exp is 10^i
-    // where i is current digit number
-    for (int exp = 1; m / exp > 0; exp *= 10)
-    	radixsortlsd_countsort (arr, from, to, exp);
+	radixsortlsd_sort64 (keys, keys + n, m, 0);
+
+	// Numbers, with the zeros between the negative and the positive ones
+	const size_t nzero = n - m - nnan;
+	const size_t numpos = (flags & RADIXSORTLSD_NANS_FIRST) ? nnan : 0;
+	size_t nanpos = (flags & RADIXSORTLSD_NANS_FIRST) ? 0 : m + nzero;
+	size_t zeropos = numpos + nneg;
+
+	for (size_t j = 0; j < m; j++) {
+		uint64_t k = keys[j];
+		uint64_t u = (k & sign) ? (k ^ sign) : ~k;
+		memcpy (&arr[numpos + j + ((j < nneg) ? 0 : nzero)], &u, sizeof (u));
+	}
+
+	for (size_t i = n; i > back; ) {
+		uint64_t u = keys[--i];
+		if ((u & ~sign) > inf)
+			memcpy (&arr[nanpos++], &u, sizeof (u));
+		else
+			memcpy (&arr[zeropos++], &u, sizeof (u));
+	}
+	SORTSTATS_MOVES (2 * n);		// to the keys and back
+
+	sortstats_free (keys);
+}
+
+/*
+ * Key functions of the pointers to floats for each combination of flags.
+ */
+static uint32_t radixsortlsd_float_key_0 (const void* item)
+{
+	return radixsortlsd_key_float (*(const float*)item, 0);
+}
+
+static uint32_t radixsortlsd_float_key_1 (const void* item)
+{
+	return radixsortlsd_key_float (*(const float*)item, 1);
+}
+
+static uint32_t radixsortlsd_float_key_2 (const void* item)
+{
+	return radixsortlsd_key_float (*(const float*)item, 2);
+}
+
+static uint32_t radixsortlsd_float_key_3 (const void* item)
+{
+	return radixsortlsd_key_float (*(const float*)item, 3);
+}
+
+/*
+ * Key functions of the pointers to doubles for each combination of flags.
+ */
+static uint64_t radixsortlsd_double_key_0 (const void* item)
+{
+	return radixsortlsd_key_double (*(const double*)item, 0);
+}
+
+static uint64_t radixsortlsd_double_key_1 (const void* item)
+{
+	return radixsortlsd_key_double (*(const double*)item, 1);
+}
+
+static uint64_t radixsortlsd_double_key_2 (const void* item)
+{
+	return radixsortlsd_key_double (*(const double*)item, 2);
+}
+
+static uint64_t radixsortlsd_double_key_3 (const void* item)
+{
+	return radixsortlsd_key_double (*(const double*)item, 3);
+}
+
+/*
+ * Key functions by flags (RADIXSORTLSD_NANS_FIRST | RADIXSORTLSD_ZEROS_EQUAL).
+ */
+static const RadixSortKey32Func radixsortlsd_float_keyfuncs[4] = {
+	radixsortlsd_float_key_0, radixsortlsd_float_key_1,
+	radixsortlsd_float_key_2, radixsortlsd_float_key_3
+};
+
+static const RadixSortKey64Func radixsortlsd_double_keyfuncs[4] = {
+	radixsortlsd_double_key_0, radixsortlsd_double_key_1,
+	radixsortlsd_double_key_2, radixsortlsd_double_key_3
+};
+
+/*
+ * Sorts floats arr[from..to] using LSD Radix Sort. NaNs are put last (first with
+ * RADIXSORTLSD_NANS_FIRST) and -0.0 before +0.0 (in input order with
+ * RADIXSORTLSD_ZEROS_EQUAL).
+ * Uses a buffer of 2 * n keys.
+ */
+void radixsortlsd_sort_float (float arr[], const int from, const int to, const int flags)
+{
+	if (to > from)
+		radixsortlsd_sort_float_keys (arr + from, (size_t)(to - from + 1), flags);
+}
+
+/*
+ * Sorts doubles arr[from..to] using LSD Radix Sort, see 'radixsortlsd_sort_float ()'.
+ * Uses a buffer of 2 * n keys.
+ */
+void radixsortlsd_sort_double (double arr[], const int from, const int to,
+							   const int flags)
+{
+	if (to > from)
+		radixsortlsd_sort_double_keys (arr + from, (size_t)(to - from + 1), flags);
+}
+
+/*
+ * Sorts array or part of an array of pointers to floats arr[from..to] using LSD
+ * Radix Sort, see 'radixsortlsd_sort_float ()'. The sort is stable.
+ * Uses a buffer of 2 * n (key, pointer) pairs.
+ */
+void radixsortlsd_sort_floats (void* arr[], const int from, const int to, const int flags)
+{
+	radixsortkey_sort_u32 (arr, from, to, radixsortlsd_float_keyfuncs[flags & 3]);
+}
+
+/*
+ * Sorts array or part of an array of pointers to doubles arr[from..to] using LSD
+ * Radix Sort, see 'radixsortlsd_sort_float ()'. The sort is stable.
+ * Uses a buffer of 2 * n (key, pointer) pairs.
+ */
+void radixsortlsd_sort_doubles (void* arr[], const int from, const int to,
+								const int flags)
+{
+	radixsortkey_sort_u64 (arr, from, to, radixsortlsd_double_keyfuncs[flags & 3]);
 }
@@ -5,17 +5,124 @@
  *      Author: Tiago C. Teixeira
  * Description: C headers for LSD Radixsort sorting algorithm.
  *
- *  Note: This LSD radix sort implementation only works for non negative integers.
+ *  Note: Keys are sorted one byte at a time, negative integers are supported.
+ *
+ *  Floats and doubles are sorted by their IEEE-754 bits mapped to unsigned keys:
+ *  the sign bit of positive values is set and all the bits of negative values are
+ *  flipped, so -inf < negatives < -0.0 < +0.0 < positives < +inf. NaNs keep their
+ *  input order and are put at the end, or at the start with RADIXSORTLSD_NANS_FIRST.
+ *  With RADIXSORTLSD_ZEROS_EQUAL -0.0 and +0.0 are equal and keep their input order.
  *
  */
 
 #ifndef RADIXSORTLSD_H_
 	#define RADIXSORTLSD_H_
 
+	#include <stdint.h>
+	#include <string.h>
+	#include "sortapi.h"
+
+	/*
+	 * Flags of the floats and doubles sorts.
+	 */
+	#define RADIXSORTLSD_NANS_FIRST 1
+	#define RADIXSORTLSD_ZEROS_EQUAL 2
+
+	/*
+	 * Returns the order-preserving unsigned key of a float: NaNs have the biggest
+	 * key (the smallest with RADIXSORTLSD_NANS_FIRST) and -0.0 has the key of +0.0
+	 * with RADIXSORTLSD_ZEROS_EQUAL.
+	 */
+	static inline uint32_t radixsortlsd_key_float (const float value, const int flags)
+	{
+		const uint32_t sign = UINT32_C (0x80000000);
+		uint32_t u;
+		memcpy (&u, &value, sizeof (u));
+
+		if ((u & ~sign) > UINT32_C (0x7F800000))
+			return (flags & RADIXSORTLSD_NANS_FIRST) ? 0 : UINT32_MAX;
+		if ((flags & RADIXSORTLSD_ZEROS_EQUAL) && ((u & ~sign) == 0))
+			return sign;
+		return (u & sign) ? ~u : (u | sign);
+	}
+
+	/*
+	 * Returns the order-preserving unsigned key of a double, see
+	 * 'radixsortlsd_key_float ()'.
+	 */
+	static inline uint64_t radixsortlsd_key_double (const double value, const int flags)
+	{
+		const uint64_t sign = UINT64_C (0x8000000000000000);
+		uint64_t u;
+		memcpy (&u, &value, sizeof (u));
+
+		if ((u & ~sign) > UINT64_C (0x7FF0000000000000))
+			return (flags & RADIXSORTLSD_NANS_FIRST) ? 0 : UINT64_MAX;
+		if ((flags & RADIXSORTLSD_ZEROS_EQUAL) && ((u & ~sign) == 0))
+			return sign;
+		return (u & sign) ? ~u : (u | sign);
+	}
+
 	/*
 	 * The main function to sort array or part of an array of integers
 	 * arr[from..to] using LSD Radix Sort algorithm.
 	 */
-	void radixsortlsd_sort_ints (int arr[], const int from, const int to);
+	SORT_API void radixsortlsd_sort_ints (int arr[], const int from, const int to);
+
+	/*
+	 * Sorts unsigned 32 bits integers arr[from..to] using LSD Radix Sort.
+	 * Uses a buffer of n keys.
+	 */
+	SORT_API void radixsortlsd_sort_u32 (uint32_t arr[], const int from, const int to);
+
+	/*
+	 * Sorts signed 32 bits integers arr[from..to] using LSD Radix Sort.
+	 * Uses a buffer of n keys.
+	 */
+	SORT_API void radixsortlsd_sort_i32 (int32_t arr[], const int from, const int to);
+
+	/*
+	 * Sorts unsigned 64 bits integers arr[from..to] using LSD Radix Sort.
+	 * Uses a buffer of n keys.
+	 */
+	SORT_API void radixsortlsd_sort_u64 (uint64_t arr[], const int from, const int to);
+
+	/*
+	 * Sorts signed 64 bits integers arr[from..to] using LSD Radix Sort.
+	 * Uses a buffer of n keys.
+	 */
+	SORT_API void radixsortlsd_sort_i64 (int64_t arr[], const int from, const int to);
+
+	/*
+	 * Sorts floats arr[from..to] using LSD Radix Sort. NaNs are put last (first with
+	 * RADIXSORTLSD_NANS_FIRST) and -0.0 before +0.0 (in input order with
+	 * RADIXSORTLSD_ZEROS_EQUAL).
+	 * Uses a buffer of 2 * n keys.
+	 */
+	SORT_API void radixsortlsd_sort_float (float arr[], const int from, const int to,
+										   const int flags);
+
+	/*
+	 * Sorts doubles arr[from..to] using LSD Radix Sort, see 'radixsortlsd_sort_float ()'.
+	 * Uses a buffer of 2 * n keys.
+	 */
+	SORT_API void radixsortlsd_sort_double (double arr[], const int from, const int to,
+											const int flags);
+
+	/*
+	 * Sorts array or part of an array of pointers to floats arr[from..to] using LSD
+	 * Radix Sort, see 'radixsortlsd_sort_float ()'. The sort is stable.
+	 * Uses a buffer of 2 * n (key, pointer) pairs.
+	 */
+	SORT_API void radixsortlsd_sort_floats (void* arr[], const int from, const int to,
+											const int flags);
+
+	/*
+	 * Sorts array or part of an array of pointers to doubles arr[from..to] using LSD
+	 * Radix Sort, see 'radixsortlsd_sort_float ()'. The sort is stable.
+	 * Uses a buffer of 2 * n (key, pointer) pairs.
+	 */
+	SORT_API void radixsortlsd_sort_doubles (void* arr[], const int from, const int to,
+											 const int flags);
 
 #endif /* RADIXSORTLSD_H_ */
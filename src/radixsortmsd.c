@@ -5,9 +5,10 @@
  *      Author: Tiago C. Teixeira
  * Description: Implements the MSD Radixsort sorting algorithm.
  *
- *  Notes: The original aglgorithm fails to sort with repeated keys.
- *  	   So this is basically a recursive version of lsd implementation
- *  	   for non negative integers lists.
+ *  Notes: This is an in-place MSD radix sort (American flag sort) with base 256
+ *  	   digits (the bytes of the key), for signed and unsigned 32 and 64 bits
+ *  	   integers. Unlike the LSD version it needs no buffer for the keys, only
+ *  	   256 entries tables on the stack for each digit level.
  *
  *
  * MSD Radix Sort: It starts sorting from the beginning of strings
@@ -59,252 +60,244 @@
  *      other sorting algorithms as one needs to know the entire data priorly only.
  *
  *
+ * American flag sort:
+ *
+ * 		Buckets are permuted in place. A histogram of the current digit gives the
+ * 		start (head) and end (tail) of each bucket. For each bucket, while its head
+ * 		hasn't reached its tail, the key at the head is swapped into the head of the
+ * 		bucket it belongs to, following the cycle until a key that belongs to the
+ * 		current bucket is found. Each key is moved at most once per digit. Then each
+ * 		bucket is sorted recursively on the next digit, and small buckets are sorted
+ * 		with insertion sort. Levels where all keys share the same digit are skipped
+ * 		without moving anything. Signed keys are sorted by flipping their sign bit
+ * 		when the digit is extracted.
+ *
+ * 		The auxiliary space is O(B * M) for the bucket tables on the stack, where M
+ * 		is the number of bytes of the key (at most 8 levels).
+ *
+ *
  * Sources:
  * 		https://www.geeksforgeeks.org/msd-most-significant-digit-radix-sort/?ref=lbp
  * 		https://www.geeksforgeeks.org/radix-sort-vs-bucket-sort/?ref=lbp
+ * 		https://en.wikipedia.org/wiki/American_flag_sort
  */
 
-/* C program for the implementation
-   of MSD Radix Sort using linked list
-   Linked list node structure */
-
-#include <stdio.h>
-#include <stdlib.h> // For using malloc
 #include <string.h> // For using memset
+#include "radixsortmsd.h"
+#include "sortstats.h"
 
-//// Linked list node declaration
-//struct RadixsortMSDNode {
-//    int arr_length;
-//    struct RadixsortMSDNode* next[10];
-//    int arr[];	// Original implementation used fixed array length arr[100]. Really bad choice.
-//};
+/*
+ * Buckets smaller than this are sorted with insertion sort.
+ */
+static const int radixsortmsd_INSERTION_SORT_THRESHOLD = 32;
 
-///*
-// * Function to create a new node of the Linked List.
-// */
-//static struct RadixsortMSDNode* radixsortmsd_new_node (size_t numElements)
-//{
-//	size_t arrSize = sizeof (int) * numElements;
-//    struct RadixsortMSDNode* tempNode
-//        = (struct RadixsortMSDNode*)malloc (sizeof (struct RadixsortMSDNode) + arrSize);
-//
-//    tempNode->arr_length = 0;
-//
-//    for (int i = 0; i < 10; i++) {
-//        tempNode->next[i] = NULL;
-//    }
-//
-//    // Return the created node
-//    return tempNode;
-//}
+/*
+ * Sorts 32 bits keys arr[0..n-1] with insertion sort. Keys are compared as
+ * unsigned after xor with 'signmask'.
+ */
+static void radixsortmsd_insertion_sort32 (uint32_t arr[], const size_t n,
+										   const uint32_t signmask)
+{
+	for (size_t i = 1; i < n; i++) {
+		uint32_t key = arr[i];
+		size_t j = i;
+		while ((j > 0) && ((arr[j - 1] ^ signmask) > (key ^ signmask))) {
+			arr[j] = arr[j - 1];
+			j--;
+		}
+		arr[j] = key;
+		SORTSTATS_MOVES (i - j + 1);
+	}
+}
 
 /*
- * Function to calculate the MSD of the maximum value in the array.
+ * Sorts 32 bits keys arr[0..n-1] in place on digit at 'shift' and recursively
+ * on the lower digits.
  */
-static int radixsortmsd_get_max_exp (int* arr, const int n)
+static void radixsortmsd_sort32_rec (uint32_t arr[], const size_t n, int shift,
+									 const uint32_t signmask)
 {
-    // Stores the maximum element
-    int mx = arr[0];
+	size_t head[256];
+	size_t tail[256];
+
+	if (n < (size_t)radixsortmsd_INSERTION_SORT_THRESHOLD) {
+		radixsortmsd_insertion_sort32 (arr, n, signmask);
+		return;
+	}
 
-    // Traverse the given array
-    for (int i = 1; i < n; i++) {
+	// Skip the digits all keys share
+	for (;;) {
+		memset (head, 0, sizeof (head));
+		for (size_t i = 0; i < n; i++)
+			head[((arr[i] ^ signmask) >> shift) & 0xFF]++;
 
-        // Update the value of maximum
-        if (arr[i] > mx) {
-            mx = arr[i];
-        }
-    }
+		if (head[((arr[0] ^ signmask) >> shift) & 0xFF] < n)
+			break;
+		if (shift == 0)
+			return;
+		shift -= 8;
+	}
 
-    int exp = 1;
+	// Counts to buckets boundaries
+	size_t sum = 0;
+	for (int d = 0; d < 256; d++) {
+		tail[d] = sum + head[d];
+		head[d] = sum;
+		sum = tail[d];
+	}
 
-    while (mx > 10) {
-        mx /= 10;
-        exp *= 10;
-    }
+	// Permute keys into their buckets following cycles
+	for (int d = 0; d < 256; d++) {
+		while (head[d] < tail[d]) {
+			uint32_t v = arr[head[d]];
+			int dv = ((v ^ signmask) >> shift) & 0xFF;
+			while (dv != d) {
+				uint32_t t = arr[head[dv]];
+				arr[head[dv]++] = v;
+				v = t;
+				dv = ((v ^ signmask) >> shift) & 0xFF;
+			}
+			arr[head[d]++] = v;
+		}
+	}
+	SORTSTATS_MOVES (n);
 
-    // Return the resultant value
-    return exp;
+	// Now head[d] is the end of bucket d, sort each bucket on the next digit
+	if (shift == 0)
+		return;
+	size_t start = 0;
+	for (int d = 0; d < 256; d++) {
+		if (head[d] - start > 1)
+			radixsortmsd_sort32_rec (arr + start, head[d] - start, shift - 8, signmask);
+		start = head[d];
+	}
 }
 
 /*
- * A recursive function to do counting sort of arr[] according to the digit represented by exp.
- *
+ * Sorts 64 bits keys arr[0..n-1] with insertion sort. Keys are compared as
+ * unsigned after xor with 'signmask'.
  */
-static void radixsortmsd_countsort_rec (int arr[], const int from, const int to, const int exp)
+static void radixsortmsd_insertion_sort64 (uint64_t arr[], const size_t n,
+										   const uint64_t signmask)
 {
-	if (exp <= 0)
-		return;
+	for (size_t i = 1; i < n; i++) {
+		uint64_t key = arr[i];
+		size_t j = i;
+		while ((j > 0) && ((arr[j - 1] ^ signmask) > (key ^ signmask))) {
+			arr[j] = arr[j - 1];
+			j--;
+		}
+		arr[j] = key;
+		SORTSTATS_MOVES (i - j + 1);
+	}
+}
 
-	// Do counting sort for every digit recursively.
-	radixsortmsd_countsort_rec (arr, from, to, exp / 10);
+/*
+ * Sorts 64 bits keys arr[0..n-1] in place on digit at 'shift' and recursively
+ * on the lower digits.
+ */
+static void radixsortmsd_sort64_rec (uint64_t arr[], const size_t n, int shift,
+									 const uint64_t signmask)
+{
+	size_t head[256];
+	size_t tail[256];
 
-	const int n = to - from + 1;
-	// Output array	\111													111111111111111111
-	int output[n];
-	int i, count[10] = { 0 };
+	if (n < (size_t)radixsortmsd_INSERTION_SORT_THRESHOLD) {
+		radixsortmsd_insertion_sort64 (arr, n, signmask);
+		return;
+	}
 
-	// Store count of occurrences
-	// in count[]
-	for (i = from; i < (to + 1); i++)
-		count[(arr[i] / exp) % 10]++;
+	// Skip the digits all keys share
+	for (;;) {
+		memset (head, 0, sizeof (head));
+		for (size_t i = 0; i < n; i++)
+			head[((arr[i] ^ signmask) >> shift) & 0xFF]++;
 
-	// Change count[i] so that count[i]
-	// now contains actual position
-	// of this digit in output[]
-	for (i = 1; i < 10; i++)
-		count[i] += count[i - 1];
+		if (head[((arr[0] ^ signmask) >> shift) & 0xFF] < n)
+			break;
+		if (shift == 0)
+			return;
+		shift -= 8;
+	}
 
-	int cntidx;
-	// Build the output array
-	for (i = to; i >= from; i--) {
-		cntidx = (arr[i] / exp) % 10;
-		output[count[cntidx] - 1] = arr[i];
-		count[cntidx]--;
+	// Counts to buckets boundaries
+	size_t sum = 0;
+	for (int d = 0; d < 256; d++) {
+		tail[d] = sum + head[d];
+		head[d] = sum;
+		sum = tail[d];
 	}
 
-	// Copy the output array to arr[],
-	// so that arr[] now contains sorted
-	// numbers according to current digit
-	for (i = 0; i < n; i++)
-		arr[i+from] = output[i];
+	// Permute keys into their buckets following cycles
+	for (int d = 0; d < 256; d++) {
+		while (head[d] < tail[d]) {
+			uint64_t v = arr[head[d]];
+			int dv = ((v ^ signmask) >> shift) & 0xFF;
+			while (dv != d) {
+				uint64_t t = arr[head[dv]];
+				arr[head[dv]++] = v;
+				v = t;
+				dv = ((v ^ signmask) >> shift) & 0xFF;
+			}
+			arr[head[d]++] = v;
+		}
+	}
+	SORTSTATS_MOVES (n);
+
+	// Now head[d] is the end of bucket d, sort each bucket on the next digit
+	if (shift == 0)
+		return;
+	size_t start = 0;
+	for (int d = 0; d < 256; d++) {
+		if (head[d] - start > 1)
+			radixsortmsd_sort64_rec (arr + start, head[d] - start, shift - 8, signmask);
+		start = head[d];
+	}
 }
 
 /*
- * The main function to that sorts integer arr[from..to] using Radix Sort.
- * Note: Only works for non-negative integers.
- * LSD radixsort implementation.
+ * Sorts unsigned 32 bits integers arr[from..to] in place using MSD Radix Sort.
  */
-void radixsortmsd_sort_ints (int arr[], const int from, const int to)
+void radixsortmsd_sort_u32 (uint32_t arr[], const int from, const int to)
 {
-	int n = (to - from + 1);
-
-	// Find the optimal longest exponent
-	int maxExp = radixsortmsd_get_max_exp (arr, n);
-
-//    // Do counting sort for every digit.
-//    // Note that instead of passing digit
-//    // number, exp is passed. exp is 10^i
-//    // where i is current digit number
-//    for (int e = maxExp; e > 0; e /= 10)
-    radixsortmsd_countsort_rec (arr, from, to, maxExp);
+	if (to > from)
+		radixsortmsd_sort32_rec (arr + from, (size_t)(to - from + 1), 24, 0);
 }
 
+/*
+ * Sorts signed 32 bits integers arr[from..to] in place using MSD Radix Sort.
+ */
+void radixsortmsd_sort_i32 (int32_t arr[], const int from, const int to)
+{
+	if (to > from)
+		radixsortmsd_sort32_rec ((uint32_t*)(arr + from), (size_t)(to - from + 1), 24,
+								 UINT32_C (0x80000000));
+}
 
-///*
-// * Function to sort the given array
-// * using MSD Radix Sort recursively.
-
-// * Note: This algorithm fails to sort lists with repeated keys.
-// */
-//static void radixsortmsd_sort_rec (struct RadixsortMSDNode* root, int exp,
-//								   int* sorted_arr, int* sorted_arr_length)
-//{
-//    if (exp <= 0) {
-//        return;
-//    }
-//
-//    int j;
-//
-//    // Stores the numbers in different
-//    // buckets according their MSD
-//    for (int i = 0; i < root->arr_length; i++) {
-//
-//        // Get the MSD in j
-//        j = (root->arr[i] / exp) % 10;
-//
-//        // If j-th index in the node
-//        // array is empty create and
-//        // link a new node in index
-//        if (root->next[j] == NULL) {
-//            root->next[j] = radixsortmsd_new_node (root->arr_length);
-//        }
-//
-//        // Store the number in j-th node
-//        root->next[j]->arr[root->next[j]->arr_length] = root->arr[i];
-//        root->next[j]->arr_length++;
-//    }
-//
-//    // Sort again every child node that
-//    // has more than one number
-//    for (int i = 0; i < 10; i++) {
-//
-//        // If root->next is NULL
-//        if (root->next[i] != NULL) {
-//
-//            if (root->next[i]->arr_length > 1) {
-//
-//                // Sort recursively
-//            	radixsortmsd_sort_rec (root->next[i], exp / 10,
-//                         sorted_arr, sorted_arr_length);
-//            }
-//
-//            // If any node have only
-//            // one number then it means
-//            // the number is sorted
-//            else {
-//                sorted_arr[*sorted_arr_length]
-//                    = root->next[i]->arr[0];
-//                *sorted_arr_length += 1;
-//            }
-//        }
-//    }
-//}
-
-
+/*
+ * Sorts unsigned 64 bits integers arr[from..to] in place using MSD Radix Sort.
+ */
+void radixsortmsd_sort_u64 (uint64_t arr[], const int from, const int to)
+{
+	if (to > from)
+		radixsortmsd_sort64_rec (arr + from, (size_t)(to - from + 1), 56, 0);
+}
 
-///*
-// * Releases linked list.
-// */
-//static void radixsortmsd_free_linked_list (struct RadixsortMSDNode* root)
-//{
-//	if (root == NULL) return;
-//	for (int i = 0; i < 10; ++i) {
-//		if (root->next[i] != NULL)
-//			radixsortmsd_free_linked_list (root->next[i]);
-//	}
-//
-//	free (root);
-//}
+/*
+ * Sorts signed 64 bits integers arr[from..to] in place using MSD Radix Sort.
+ */
+void radixsortmsd_sort_i64 (int64_t arr[], const int from, const int to)
+{
+	if (to > from)
+		radixsortmsd_sort64_rec ((uint64_t*)(arr + from), (size_t)(to - from + 1), 56,
+								 UINT64_C (0x8000000000000000));
+}
 
-///*
-// * Recursive function to sort an array of integers using MSD Radixsort sorting
-// * algorithm.
-// * Note: A linked list is used to avoid wasting memory space.
-// */
-//void radixsortmsd_sort_ints (int arr[], const int from, const int to)
-//{
-//	// Number of elements to sort
-//	int n = (to - from + 1);
-//	struct RadixsortMSDNode* root = radixsortmsd_new_node (n);
-//
-//	// Stores the unsorted array
-//	// in the root node and
-//	// set arr_length
-//	// Note: This is really bad if input array size is greater than root node fixed
-//	//		 array size. This was the original implementation.
-//	//
-//	//		 Maybe an option is to alloc mem for array dinamically since we know the
-//	// 		 size of input array to sort.
-//	// 		 That's what i did.
-//	memcpy (root->arr, (arr + from), sizeof (int) * n);
-//	root->arr_length = n;
-//
-//	// Find the optimal longest exponent
-//	int exp = radixsortmsd_get_max_exp (root->arr, root->arr_length);
-//
-//	// Stores the sorted numbers
-//	int output[n];
-//	int* sorted_arr = &output[0];
-//	int sorted_arr_length = 0;	// Output array filled length
-//
-//	// Function Call
-//	radixsortmsd_sort_rec (root, exp, sorted_arr, &sorted_arr_length);
-//
-//	// Copy sorted array to arr
-//	for (int i = 0, j = from; i < n; ++i, ++j) {
-//		arr[j] = sorted_arr[i];
-//	}
-//
-//	// Free linked list
-//	radixsortmsd_free_linked_list (root);
-//}
+/*
+ * The main function to that sorts integer arr[from..to] using Radix Sort.
+ * In place MSD radixsort implementation, negative integers are supported.
+ */
+void radixsortmsd_sort_ints (int arr[], const int from, const int to)
+{
+	radixsortmsd_sort_i32 ((int32_t*)arr, from, to);
+}
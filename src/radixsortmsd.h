@@ -4,16 +4,45 @@
  *  Created on: 20/02/2024
  *      Author: Tiago C. Teixeira
  * Description: C headers for MSD Radixsort sorting algorithm.
+ *
+ *  Note: In place (American flag sort), keys are sorted one byte at a time and
+ *  	  negative integers are supported.
  */
 
 #ifndef RADIXSORTMSD_H_
 	#define RADIXSORTMSD_H_
 
+	#include <stdint.h>
+	#include "sortapi.h"
+
+	/*
+	 * Sorts an array or part of an array of integers arr[from..to] in place using
+	 * MSD Radixsort sorting algorithm.
+	 */
+	SORT_API void radixsortmsd_sort_ints (int arr[], const int from, const int to);
+
+	/*
+	 * Sorts unsigned 32 bits integers arr[from..to] in place using MSD Radix Sort.
+	 * No buffer is allocated.
+	 */
+	SORT_API void radixsortmsd_sort_u32 (uint32_t arr[], const int from, const int to);
+
+	/*
+	 * Sorts signed 32 bits integers arr[from..to] in place using MSD Radix Sort.
+	 * No buffer is allocated.
+	 */
+	SORT_API void radixsortmsd_sort_i32 (int32_t arr[], const int from, const int to);
+
+	/*
+	 * Sorts unsigned 64 bits integers arr[from..to] in place using MSD Radix Sort.
+	 * No buffer is allocated.
+	 */
+	SORT_API void radixsortmsd_sort_u64 (uint64_t arr[], const int from, const int to);
+
 	/*
-	 * Recursive function to sort an array of integers using MSD Radixsort sorting
-	 * algorithm.
-	 * Note: A linked list is used to avoid wasting memory space.
+	 * Sorts signed 64 bits integers arr[from..to] in place using MSD Radix Sort.
+	 * No buffer is allocated.
 	 */
-	void radixsortmsd_sort_ints (int arr[], const int from, const int to);
+	SORT_API void radixsortmsd_sort_i64 (int64_t arr[], const int from, const int to);
 
 #endif /* RADIXSORTMSD_H_ */
@@ -5,83 +5,271 @@
  *      Author: Tiago C. Teixeira
  * Description: Implements the Radixsort sorting algorithm for strings.
  *
- * _________________This is a bad implementation
- *
  * About:
  *
- *		This implementation is for the strings based on the counting sort() method.
- *		As C style ASCII character is 1 byte. So, the 256 size array is used to count
- *		occurrences of characters, and it sorts the strings lexicographically.
+ *		Strings are sorted in lexicographical order (same as strcmp) by their
+ *		characters, starting from the first one (MSD). As C style ASCII character is
+ *		1 byte, 256 buckets are used for each character position, bucket 0 holds the
+ *		strings that ended.
+ *
+ *		Only the pointers are moved, the strings are never copied.
+ *
+ *
+ * MSD Radix sort with character caching:
+ *
+ *		Each string is read once per character position: the character at the
+ *		current position is stored in a cache array while counting occurrences,
+ *		and the pointers and their cached characters are permuted together into
+ *		their buckets in place (American flag sort). Bucket 0 (strings that ended)
+ *		is already sorted, other buckets are sorted on the next character. The
+ *		largest bucket is sorted by the loop instead of a recursive call, so the
+ *		recursion depth is at most log2(n). Positions where all strings share the
+ *		same character are skipped. Small buckets are sorted with multikey quicksort.
+ *
+ *
+ * Multikey quicksort (three-way radix quicksort):
+ *
+ *		Partitions the strings in 3 groups by the character at the current position:
+ *		less than, equal to and greater than the pivot character. The less and
+ *		greater groups are sorted on the same position, the equal group on the next
+ *		position. Compares one character at a time instead of whole strings, so
+ *		common prefixes are never compared twice.
  *
  *
- * Adapted from:
+ * Complexity:
+ *
+ *		Time: O(D + n log n) for multikey quicksort and O(D + n) character reads
+ *		for MSD radix sort, where D is the total length of the distinguishing
+ *		prefixes.
+ *		Auxiliary space: n bytes for the MSD radix sort characters cache plus the
+ *		bucket tables on the stack, O(log n) stack for multikey quicksort.
+ *
+ *
+ * Sources:
  * 		https://www.geeksforgeeks.org/msd-most-significant-digit-radix-sort/?ref=lbp
+ * 		J. Bentley, R. Sedgewick, Fast Algorithms for Sorting and Searching Strings.
+ * 		J. Karkkainen, T. Rantala, Engineering Radix Sort for Strings.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "radixsortstr.h"
+#include "sortstats.h"
+
+/*
+ * Buckets smaller than this are sorted with multikey quicksort.
+ */
+static const int radixsortstr_MKQSORT_THRESHOLD = 64;
+
+/*
+ * Partitions smaller than this are sorted with insertion sort in multikey
+ * quicksort.
+ */
+static const int radixsortstr_INSERTION_SORT_THRESHOLD = 12;
+
+/*
+ * Returns the character at position 'depth' of string str as unsigned.
+ */
+static inline int radixsortstr_char_at (const char* str, const size_t depth)
+{
+	return (unsigned char)str[depth];
+}
+
+/*
+ * Swaps two strings pointers.
+ */
+static inline void radixsortstr_swap (char** a, char** b)
+{
+	SORTSTATS_SWAP ();
+	char* t = *a;
+	*a = *b;
+	*b = t;
+}
+
+/*
+ * Sorts strings arr[0..n-1] that share their first 'depth' characters using
+ * insertion sort.
+ */
+static void radixsortstr_insertion_sort (char* arr[], const size_t n, const size_t depth)
+{
+	for (size_t i = 1; i < n; i++) {
+		char* key = arr[i];
+		size_t j = i;
+		while ((j > 0) && (strcmp (arr[j - 1] + depth, key + depth) > 0)) {
+			arr[j] = arr[j - 1];
+			j--;
+		}
+		arr[j] = key;
+		SORTSTATS_MOVES (i - j + 1);
+	}
+}
+
+/*
+ * Returns the median of 3 characters.
+ */
+static inline int radixsortstr_median3 (const int a, const int b, const int c)
+{
+	if (a < b)
+		return (b < c) ? b : ((a < c) ? c : a);
+	else
+		return (a < c) ? a : ((b < c) ? c : b);
+}
+
+/*
+ * Multikey quicksort of strings arr[0..n-1] that share their first 'depth'
+ * characters.
+ */
+static void radixsortstr_mkqsort_rec (char* arr[], size_t n, size_t depth)
+{
+	while (n >= (size_t)radixsortstr_INSERTION_SORT_THRESHOLD) {
+		const int v = radixsortstr_median3 (radixsortstr_char_at (arr[0], depth),
+											radixsortstr_char_at (arr[n / 2], depth),
+											radixsortstr_char_at (arr[n - 1], depth));
+
+		// arr[0..lt-1] < v, arr[lt..gt-1] == v, arr[gt..n-1] > v
+		size_t lt = 0, i = 0, gt = n;
+		while (i < gt) {
+			int c = radixsortstr_char_at (arr[i], depth);
+			if (c < v)
+				radixsortstr_swap (&arr[lt++], &arr[i++]);
+			else if (c > v)
+				radixsortstr_swap (&arr[i], &arr[--gt]);
+			else
+				i++;
+		}
+
+		// Recurse on the smaller groups and loop on the largest one
+		size_t neq = (v == 0) ? 0 : gt - lt;	// equal strings that ended are sorted
+		size_t ngt = n - gt;
+		if (lt >= neq && lt >= ngt) {
+			radixsortstr_mkqsort_rec (arr + lt, neq, depth + 1);
+			radixsortstr_mkqsort_rec (arr + gt, ngt, depth);
+			n = lt;
+		}
+		else if (neq >= ngt) {
+			radixsortstr_mkqsort_rec (arr, lt, depth);
+			radixsortstr_mkqsort_rec (arr + gt, ngt, depth);
+			arr += lt;
+			n = neq;
+			depth++;
+		}
+		else {
+			radixsortstr_mkqsort_rec (arr, lt, depth);
+			radixsortstr_mkqsort_rec (arr + lt, neq, depth + 1);
+			arr += gt;
+			n = ngt;
+		}
+	}
+
+	radixsortstr_insertion_sort (arr, n, depth);
+}
+
+/*
+ * MSD radix sort of strings arr[0..n-1] that share their first 'depth'
+ * characters. 'cache' has room for n characters.
+ */
+static void radixsortstr_msd_rec (char* arr[], size_t n, size_t depth,
+								  unsigned char cache[])
+{
+	size_t head[256];
+	size_t tail[256];
+
+	while (n >= (size_t)radixsortstr_MKQSORT_THRESHOLD) {
+		// Count characters, skipping the positions all strings share
+		for (;;) {
+			memset (head, 0, sizeof (head));
+			for (size_t i = 0; i < n; i++) {
+				cache[i] = (unsigned char)arr[i][depth];
+				head[cache[i]]++;
+			}
+			if (head[cache[0]] < n)
+				break;
+			if (cache[0] == 0)
+				return;		// all strings are equal
+			depth++;
+		}
+
+		// Counts to buckets boundaries
+		size_t sum = 0;
+		for (int d = 0; d < 256; d++) {
+			tail[d] = sum + head[d];
+			head[d] = sum;
+			sum = tail[d];
+		}
+
+		// Permute pointers and cached characters into their buckets
+		for (int d = 0; d < 256; d++) {
+			while (head[d] < tail[d]) {
+				char* s = arr[head[d]];
+				unsigned char c = cache[head[d]];
+				while (c != d) {
+					size_t j = head[c]++;
+					char* ts = arr[j];
+					unsigned char tc = cache[j];
+					arr[j] = s;
+					cache[j] = c;
+					s = ts;
+					c = tc;
+				}
+				arr[head[d]] = s;
+				cache[head[d]++] = c;
+			}
+		}
+		SORTSTATS_MOVES (n);
+
+		// Sort buckets on next character, bucket 0 (ended strings) is sorted.
+		// The largest bucket is left to the loop.
+		int largest = 1;
+		for (int d = 2; d < 256; d++)
+			if (tail[d] - head[d - 1] > tail[largest] - head[largest - 1])
+				largest = d;
+
+		for (int d = 1; d < 256; d++) {
+			size_t start = head[d - 1];
+			size_t len = tail[d] - start;
+			if (d != largest && len > 1)
+				radixsortstr_msd_rec (arr + start, len, depth + 1, cache);
+		}
+
+		size_t start = head[largest - 1];
+		n = tail[largest] - start;
+		arr += start;
+		depth++;
+	}
+
+	radixsortstr_mkqsort_rec (arr, n, depth);
+}
+
+/*
+ * Sorts an array or part of an array of strings arr[from..to] in lexicographical
+ * order using MSD radix sort with characters caching.
+ * Note: from (inclusive) .. to (inclusive)
+ */
+void radixsortstr_sort (char* arr[], const int from, const int to)
+{
+	if (to <= from)
+		return;
+
+	const size_t n = (size_t)(to - from + 1);
+	unsigned char* cache = sortstats_malloc (n);
+	if (cache == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for radix sort cache.");
+		abort ();
+	}
+
+	radixsortstr_msd_rec (arr + from, n, 0, cache);
+	sortstats_free (cache);
+}
+
+/*
+ * Sorts an array or part of an array of strings arr[from..to] in lexicographical
+ * order using multikey quicksort (three-way radix quicksort). No memory is
+ * allocated.
+ * Note: from (inclusive) .. to (inclusive)
  */
-//
-///*
-// * C program for the implementation
-// * of MSD Radix Sort for strings in lexicographical order using counting sort()
-// */
-//#include <stdio.h>
-//#include <string.h>
-//
-///*
-// * A utility function to get the ASCII value
-// * of the character at index d in a string.
-// */
-//int radixsortstr_char_at (char* str, int d)
-//{
-//    if (sizeof(str) / sizeof(str[0]) <= d)
-//        return -1;
-//    else
-//        return str[d];
-//}
-//
-///*
-// * The main function to sort strings array using
-// * MSD Radix Sort recursively.
-// */
-//void radixsortstr_msd_sort (char** str, int lo, int hi, int d, const int n)
-//{
-//    // Recursion break condition
-//    if (hi <= lo + 1) {
-//        return;
-//    }
-//
-//    // Each character is one byte (0..255)
-//    int count[256 + 2] = { 0 };
-//
-//    // Temp is created to easily swap strings in str[]
-//    char temp[n][100];
-//
-//    // Store occurrences of most significant character
-//    // from each string in count[]
-//    for (int i = lo; i <= hi; i++) {
-//        int c = radixsortstr_char_at (str[i], d);
-//        count++;
-//    }
-//
-//    // Change count[] so that count[] now contains actual
-//    //  position of this digits in temp[]
-//    for (int r = 0; r < 256 + 1; r++)
-//        count[r + 1] += count[r];
-//
-//    // Build the temp
-//    for (int i = lo; i <= hi; i++) {
-//        int c = radixsortstr_char_at (str[i], d);
-//        memcpy (temp[count++], str[i],
-//                strlen(str[i]) + 1);
-//    }
-//
-//    // Copy all strings of temp to str[], so that str[] now
-//    // contains partially sorted strings
-//    for (int i = lo; i <= hi; i++) {
-//        str[i] = strdup (temp[i - lo]);  // ???? Memory leaks ???
-//    }
-//
-//    // Recursively MSD_sort() on each partially sorted
-//    // strings set to sort them by their next character
-//    for (int r = 0; r < 256; r++)
-//    	radixsortstr_msd_sort (str, lo + count[r], lo + count[r + 1] - 1,
-//                 d + 1);
-//}
+void radixsortstr_mkqsort (char* arr[], const int from, const int to)
+{
+	if (to > from)
+		radixsortstr_mkqsort_rec (arr + from, (size_t)(to - from + 1), 0);
+}
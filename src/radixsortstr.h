@@ -0,0 +1,33 @@
+/*
+ * radixsortstr.h
+ *
+ *  Created on: 21/02/2024
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for Radixsort sorting algorithms for strings.
+ *
+ *  Note: Strings are sorted in the same order as strcmp, only the pointers
+ *  	  are moved.
+ */
+
+#ifndef RADIXSORTSTR_H_
+	#define RADIXSORTSTR_H_
+
+	#include "sortapi.h"
+
+	/*
+	 * Sorts an array or part of an array of strings arr[from..to] in lexicographical
+	 * order using MSD radix sort with characters caching.
+	 * Uses a buffer of n bytes.
+	 * Note: from (inclusive) .. to (inclusive)
+	 */
+	SORT_API void radixsortstr_sort (char* arr[], const int from, const int to);
+
+	/*
+	 * Sorts an array or part of an array of strings arr[from..to] in lexicographical
+	 * order using multikey quicksort (three-way radix quicksort).
+	 * No memory is allocated.
+	 * Note: from (inclusive) .. to (inclusive)
+	 */
+	SORT_API void radixsortstr_mkqsort (char* arr[], const int from, const int to);
+
+#endif /* RADIXSORTSTR_H_ */
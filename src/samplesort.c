@@ -0,0 +1,838 @@
+/*
+ * samplesort.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements the in-place parallel super scalar samplesort (IPS4o)
+ * 				sorting algorithm.
+ *
+ *
+ * About:
+ *
+ *    Samplesort generalizes quicksort to k pivots (splitters): the range is split
+ *    into k buckets in one pass and every bucket is sorted recursively. With k = 256
+ *    a range of 100M elements is split into buckets that fit the caches after 2 or
+ *    3 passes, where quicksort needs more than 20, each one going through memory.
+ *
+ *    In-place super scalar samplesort (IPS4o), by Axtmann, Witt, Ferizovic and
+ *    Sanders, is a samplesort that needs no O(n) buffer and runs in parallel. Each
+ *    partitioning step has 4 phases:
+ *
+ *    1. Sampling: k*8 random elements are sorted and k-1 equidistant ones are kept
+ *       as splitters. They are stored as an implicit binary search tree (Eytzinger
+ *       layout, the children of node j are 2j and 2j+1), so the bucket of an element
+ *       is found in log2(k) steps with no branches: j = 2j + (splitter[j] < x).
+ *       Elements of 4 at a time are classified together, so their searches overlap
+ *       in the CPU pipeline. When the sample has repeated splitters, elements equal
+ *       to a splitter get a bucket of their own, which is done and not sorted again
+ *       (equal buckets), so inputs with few distinct keys are sorted in linear time.
+ *
+ *    2. Classification: the range is split in one stripe per thread. Each thread
+ *       moves the elements of its stripe to one buffer block per bucket (blocks of
+ *       2KB). When a buffer block is full it is written back to the start of the
+ *       stripe, over elements already read. At the end each stripe begins with full
+ *       blocks of a single bucket each, and the remaining elements are in the
+ *       buffers.
+ *
+ *    3. Block permutation: with the bucket sizes known, every bucket is given a
+ *       range of block slots. The blocks are swapped to the slots of their bucket
+ *       following cycles, as the American flag sort does with elements (see
+ *       radixsortmsd.c), so each block is moved once. Every bucket has a write
+ *       position, its next free slot, and a read position, its last unread block.
+ *       Threads take blocks from the buckets and swap them to their destination
+ *       until an empty slot is found. The positions of a bucket are protected by
+ *       a lock, and taken blocks are read while holding it, so a thread writing
+ *       into an empty slot never overwrites a block still being read.
+ *
+ *    4. Cleanup: buckets don't start at block boundaries. The elements of the last
+ *       block of a bucket that fall into the next bucket, and the elements left in
+ *       the buffers, are copied into the free space at the start and at the end of
+ *       the bucket.
+ *
+ *    Buckets larger than the base case are sorted recursively, in parallel by tasks
+ *    of a work-stealing thread pool. Base cases are sorted with pdqsort, or with the
+ *    type specialized introsort of sortdef.h for numeric keys.
+ *
+ *    The extra memory is k+3 blocks per thread (about 1MB for k = 256 and 8 bytes
+ *    elements), whatever the number of elements.
+ *
+ *    The algorithm is written once as the macro SAMPLESORT_DEFINE_, instanced for
+ *    arrays of pointers (comparison function) and for arrays of numeric keys
+ *    (comparison inlined).
+ *
+ *
+ * Complexity Analysis:
+ *
+ * 	|---------------------------------------------------|
+ * 	| Best Case		Average Case		Worst Case   	|
+ * 	| --------------------------------------------------|
+ * 	| Ω(n) 			θ(n*log(n))			O(n*log(n))  	|
+ * 	|---------------------------------------------------|
+ *
+ * 	The O(n*log(n)) worst case holds with high probability, as splitters are taken
+ * 	from a random sample.
+ *
+ * Space
+ *	O(k*B*t), k buckets, B elements per block and t threads
+ *
+ * Stable
+ *	NO
+ *
+ *
+ * Sources:
+ * 		https://arxiv.org/abs/1705.02257
+ * 		https://github.com/ips4o/ips4o
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "sort.h"
+#include "sortdef.h"
+#include "pdqsort.h"
+#include "samplesort.h"
+#include "sortstats.h"
+
+// Maximum number of buckets (the splitters tree has log2 of it levels)
+#define SAMPLESORT_MAX_BUCKETS 256
+
+// Size of the blocks of elements moved by the block permutation
+static const int samplesort_BLOCK_BYTES = 2048;
+
+// Sampled elements per bucket
+static const int samplesort_OVERSAMPLING = 8;
+
+// Ranges up to this size are sorted by the base case sorting algorithm
+static const int samplesort_BASE_CASE = 4096;
+
+// Ranges up to this size are sorted sequentially
+static const int samplesort_PARALLEL_CUTOFF = 131072;
+
+// Write and read positions of the block slots of a bucket
+struct SamplesortBucket {
+	size_t write;						// next slot to write
+	size_t read;						// end of the unread blocks
+	pthread_mutex_t lock;				// protects the positions (parallel sort)
+};
+
+/*
+ * Locks the positions of a bucket, if the partition runs in parallel.
+ */
+static inline void samplesort_lock (const int parallel, struct SamplesortBucket* bucket)
+{
+	if (parallel)
+		pthread_mutex_lock (&bucket->lock);
+}
+
+/*
+ * Unlocks the positions of a bucket, if the partition runs in parallel.
+ */
+static inline void samplesort_unlock (const int parallel, struct SamplesortBucket* bucket)
+{
+	if (parallel)
+		pthread_mutex_unlock (&bucket->lock);
+}
+
+/*
+ * Rounds position 'pos' up to a multiple of the block size.
+ */
+static inline size_t samplesort_align (const size_t pos, const size_t bsize)
+{
+	return (pos + bsize - 1) / bsize * bsize;
+}
+
+/*
+ * Gets log2 of the number of buckets to split 'n' elements into, so there are at
+ * least 2 blocks of 'bsize' elements per bucket.
+ */
+static int samplesort_levels (const size_t n, const size_t bsize)
+{
+	int levels = 1;
+	while ((1 << levels) < SAMPLESORT_MAX_BUCKETS &&
+		   ((size_t)4 << levels) * bsize <= n)
+		levels++;
+	return levels;
+}
+
+/*
+ * Defines, for elements of the given type ordered by 'less_expr' (an expression on
+ * 'a', 'b' and the comparison function 'cmp'), the static functions:
+ *
+ * 		void name_sort_range (type* arr, const size_t n, SortCompareFunc cmp);
+ * 		void name_sort_range_pool (type* arr, const size_t n, SortCompareFunc cmp,
+ * 								   struct ThreadPool* pool);
+ *
+ * 'basesort (type* arr, const size_t n, SortCompareFunc cmp)' sorts the base cases.
+ */
+#define SAMPLESORT_DEFINE_(name, type, less_expr, basesort) \
+	static inline int name##_less (const type a, const type b, SortCompareFunc cmp) \
+	{ \
+		(void) cmp; \
+		if (cmp == NULL) \
+			SORTSTATS_COMPARE ();		/* keys, no comparison function to count */ \
+		return (less_expr); \
+	} \
+	\
+	struct name##_Partition; \
+	\
+	/* Buffers and counters of a stripe (the part of the range of a thread) */ \
+	struct name##_Stripe { \
+		struct name##_Partition* part; \
+		type* buf;						/* k+3 blocks: buckets, 2 to swap, overflow */ \
+		size_t* bufcount;				/* elements in the buffer of each bucket */ \
+		size_t* count;					/* elements of each bucket in the stripe */ \
+		size_t begin; \
+		size_t end; \
+		size_t fullend;					/* end of the full blocks written back */ \
+		int firstbucket;				/* first bucket read by the block permutation */ \
+	}; \
+	\
+	/* A partitioning step of arr[0..n-1] */ \
+	struct name##_Partition { \
+		type* arr; \
+		size_t n; \
+		SortCompareFunc cmp; \
+		size_t bsize;					/* elements per block */ \
+		int levels;						/* levels of the splitters tree */ \
+		int numtree;					/* leaves of the splitters tree */ \
+		int numbuckets;					/* numtree, or 2*numtree with equal buckets */ \
+		int equal;						/* 1 if equal buckets are used */ \
+		int parallel;					/* 1 if buckets positions need locks */ \
+		type tree[SAMPLESORT_MAX_BUCKETS];		/* splitters, tree[1] is the root */ \
+		type splitters[SAMPLESORT_MAX_BUCKETS];	/* sorted splitters */ \
+		size_t start[2 * SAMPLESORT_MAX_BUCKETS + 1];	/* first element of each bucket */ \
+		struct SamplesortBucket* buckets; \
+		struct name##_Stripe* stripes; \
+		int nstripes; \
+		size_t stripesize; \
+		type* overflow;					/* last block when it doesn't fit the range */ \
+	}; \
+	\
+	/* A group of buckets of a partition sorted by a task */ \
+	struct name##_Task { \
+		struct name##_Partition* part; \
+		struct ThreadPool* pool; \
+		int first; \
+		int end; \
+	}; \
+	\
+	static void name##_sort_range_pool (type* arr, const size_t n, SortCompareFunc cmp, \
+										struct ThreadPool* pool); \
+	\
+	/* Allocates the buffers of a stripe, for up to 2*numtree buckets */ \
+	static void name##_stripe_alloc (struct name##_Stripe* s, const int numtree, \
+									 const size_t bsize) \
+	{ \
+		s->buf = sortstats_malloc ((2 * numtree + 3) * bsize * sizeof (type)); \
+		s->bufcount = sortstats_malloc (2 * numtree * sizeof (size_t)); \
+		s->count = sortstats_malloc (2 * numtree * sizeof (size_t)); \
+		if (s->buf == NULL || s->bufcount == NULL || s->count == NULL) { \
+			fprintf (stderr, "Error: failed to allocate memory for samplesort buffers."); \
+			abort (); \
+		} \
+	} \
+	\
+	static void name##_stripe_free (struct name##_Stripe* s) \
+	{ \
+		sortstats_free (s->count); \
+		sortstats_free (s->bufcount); \
+		sortstats_free (s->buf); \
+	} \
+	\
+	/* Bucket of element 'x' */ \
+	static inline size_t name##_find (const struct name##_Partition* p, const type x) \
+	{ \
+		size_t b = 1; \
+		for (int l = 0; l < p->levels; ++l) \
+			b = 2 * b + name##_less (p->tree[b], x, p->cmp); \
+		b -= p->numtree; \
+		if (p->equal) \
+			b = 2 * b + !name##_less (x, p->splitters[b], p->cmp); \
+		return b; \
+	} \
+	\
+	/* Buckets of elements x[0..3], their searches are interleaved */ \
+	static inline void name##_find4 (const struct name##_Partition* p, type const* x, \
+									 size_t b[4]) \
+	{ \
+		size_t b0 = 1, b1 = 1, b2 = 1, b3 = 1; \
+		for (int l = 0; l < p->levels; ++l) { \
+			b0 = 2 * b0 + name##_less (p->tree[b0], x[0], p->cmp); \
+			b1 = 2 * b1 + name##_less (p->tree[b1], x[1], p->cmp); \
+			b2 = 2 * b2 + name##_less (p->tree[b2], x[2], p->cmp); \
+			b3 = 2 * b3 + name##_less (p->tree[b3], x[3], p->cmp); \
+		} \
+		b[0] = b0 - p->numtree; \
+		b[1] = b1 - p->numtree; \
+		b[2] = b2 - p->numtree; \
+		b[3] = b3 - p->numtree; \
+		if (p->equal) { \
+			for (int j = 0; j < 4; ++j) \
+				b[j] = 2 * b[j] + !name##_less (x[j], p->splitters[b[j]], p->cmp); \
+		} \
+	} \
+	\
+	/* Fills the splitters tree in Eytzinger order with the sorted splitters */ \
+	static void name##_fill_tree (type tree[], const int node, const int numtree, \
+								  type const splitters[], int* next) \
+	{ \
+		if (node >= numtree) \
+			return; \
+		name##_fill_tree (tree, 2 * node, numtree, splitters, next); \
+		tree[node] = splitters[(*next)++]; \
+		name##_fill_tree (tree, 2 * node + 1, numtree, splitters, next); \
+	} \
+	\
+	/* Picks the splitters from a random sample, sorted in the buffer of stripe 0 */ \
+	static void name##_sample (struct name##_Partition* p) \
+	{ \
+		const int k = 1 << p->levels; \
+		const int os = samplesort_OVERSAMPLING; \
+		const size_t nsample = (size_t)k * os; \
+		type* sample = p->stripes[0].buf; \
+	\
+		/* Random positions (xorshift), the same for the same n */ \
+		uint64_t seed = UINT64_C (88172645463325252) ^ p->n; \
+		for (size_t i = 0; i < nsample; ++i) { \
+			seed ^= seed << 13; \
+			seed ^= seed >> 7; \
+			seed ^= seed << 17; \
+			sample[i] = p->arr[seed % p->n]; \
+		} \
+		basesort (sample, nsample, p->cmp); \
+	\
+		/* Equidistant splitters, without repeated ones */ \
+		int m = 0; \
+		for (int i = 1; i < k; ++i) { \
+			type s = sample[(size_t)i * os - 1]; \
+			if (m == 0 || name##_less (p->splitters[m - 1], s, p->cmp)) \
+				p->splitters[m++] = s; \
+		} \
+	\
+		/* The last splitter is repeated up to k-1, splitters[k-1] bounds bucket k-1 */ \
+		p->equal = (m < k - 1) || (k == 2); \
+		for (int i = m; i < k; ++i) \
+			p->splitters[i] = p->splitters[m - 1]; \
+	\
+		int next = 0; \
+		name##_fill_tree (p->tree, 1, k, p->splitters, &next); \
+		p->numtree = k; \
+		p->numbuckets = p->equal ? 2 * k : k; \
+	} \
+	\
+	/* Moves the elements of a stripe to the buckets buffers, writing back full blocks */ \
+	static void name##_classify_task (void* arg) \
+	{ \
+		struct name##_Stripe* s = arg; \
+		const struct name##_Partition* p = s->part; \
+		type* arr = p->arr; \
+		const size_t bsize = p->bsize; \
+		size_t write = s->begin; \
+		size_t b[4]; \
+	\
+		memset (s->bufcount, 0, p->numbuckets * sizeof (size_t)); \
+		memset (s->count, 0, p->numbuckets * sizeof (size_t)); \
+	\
+		for (size_t i = s->begin; i < s->end; ) { \
+			size_t m = s->end - i; \
+			if (m >= 4) { \
+				m = 4; \
+				name##_find4 (p, &arr[i], b); \
+			} else { \
+				for (size_t j = 0; j < m; ++j) \
+					b[j] = name##_find (p, arr[i + j]); \
+			} \
+	\
+			/* A full block overwrites elements already moved to the buffers */ \
+			for (size_t j = 0; j < m; ++j) { \
+				type* block = s->buf + b[j] * bsize; \
+				block[s->bufcount[b[j]]++] = arr[i + j]; \
+				if (s->bufcount[b[j]] == bsize) { \
+					memcpy (&arr[write], block, bsize * sizeof (type)); \
+					write += bsize; \
+					s->count[b[j]] += bsize; \
+					s->bufcount[b[j]] = 0; \
+				} \
+			} \
+			i += m; \
+		} \
+	\
+		for (int c = 0; c < p->numbuckets; ++c) \
+			s->count[c] += s->bufcount[c]; \
+		s->fullend = write; \
+	} \
+	\
+	/* 1 if the slot at 'pos' holds a full block after the classification */ \
+	static inline int name##_is_full (const struct name##_Partition* p, const size_t pos) \
+	{ \
+		if (pos + p->bsize > p->n) \
+			return 0; \
+		return pos < p->stripes[pos / p->stripesize].fullend; \
+	} \
+	\
+	/* Computes the buckets bounds and gathers the full blocks of each bucket at the \
+	 * start of its slots (stripes leave empty slots between their full blocks) */ \
+	static void name##_prepare (struct name##_Partition* p) \
+	{ \
+		const size_t bsize = p->bsize; \
+	\
+		size_t sum = 0; \
+		for (int c = 0; c < p->numbuckets; ++c) { \
+			p->start[c] = sum; \
+			for (int t = 0; t < p->nstripes; ++t) \
+				sum += p->stripes[t].count[c]; \
+		} \
+		p->start[p->numbuckets] = sum; \
+	\
+		for (int c = 0; c < p->numbuckets; ++c) { \
+			size_t lo = samplesort_align (p->start[c], bsize); \
+			size_t hi = samplesort_align (p->start[c + 1], bsize); \
+			p->buckets[c].write = lo; \
+			for (;;) { \
+				while (lo < hi && name##_is_full (p, lo)) \
+					lo += bsize; \
+				while (hi > lo && !name##_is_full (p, hi - bsize)) \
+					hi -= bsize; \
+				if (lo >= hi) \
+					break; \
+				memcpy (&p->arr[lo], &p->arr[hi - bsize], bsize * sizeof (type)); \
+				lo += bsize; \
+				hi -= bsize; \
+			} \
+			p->buckets[c].read = lo; \
+		} \
+	} \
+	\
+	/* Swaps blocks to their buckets, starting with the blocks of the stripe first \
+	 * bucket */ \
+	static void name##_permute_task (void* arg) \
+	{ \
+		struct name##_Stripe* s = arg; \
+		const struct name##_Partition* p = s->part; \
+		type* arr = p->arr; \
+		const size_t bsize = p->bsize; \
+		const size_t blockbytes = bsize * sizeof (type); \
+		type* hand = s->buf + (size_t)p->numbuckets * bsize; \
+		type* spare = hand + bsize; \
+	\
+		for (int c = 0; c < p->numbuckets; ++c) { \
+			struct SamplesortBucket* src = &p->buckets[(s->firstbucket + c) % p->numbuckets]; \
+			for (;;) { \
+				/* Take the last unread block of the bucket */ \
+				samplesort_lock (p->parallel, src); \
+				int found = (src->read > src->write); \
+				if (found) { \
+					src->read -= bsize; \
+					memcpy (hand, &arr[src->read], blockbytes); \
+				} \
+				samplesort_unlock (p->parallel, src); \
+				if (!found) \
+					break; \
+	\
+				/* Swap it into its bucket until an empty slot is found */ \
+				for (;;) { \
+					struct SamplesortBucket* dst = &p->buckets[name##_find (p, hand[0])]; \
+					samplesort_lock (p->parallel, dst); \
+					size_t pos = dst->write; \
+					dst->write += bsize; \
+					int full = (pos < dst->read); \
+					samplesort_unlock (p->parallel, dst); \
+	\
+					if (!full) { \
+						memcpy ((pos + bsize > p->n) ? p->overflow : &arr[pos], hand, blockbytes); \
+						break; \
+					} \
+					memcpy (spare, &arr[pos], blockbytes); \
+					memcpy (&arr[pos], hand, blockbytes); \
+					type* t = hand; \
+					hand = spare; \
+					spare = t; \
+				} \
+			} \
+		} \
+	} \
+	\
+	/* Copies 'cnt' elements from 'src' to the free slots of a bucket: arr[pos..headend-1] \
+	 * first, then from 'tailstart' on */ \
+	static inline void name##_fill (type* arr, size_t* pos, const size_t headend, \
+									const size_t tailstart, type const* src, size_t cnt) \
+	{ \
+		while (cnt > 0) { \
+			if (*pos == headend) \
+				*pos = tailstart; \
+			size_t m = cnt; \
+			if (*pos < headend && headend - *pos < m) \
+				m = headend - *pos; \
+			memcpy (&arr[*pos], src, m * sizeof (type)); \
+			*pos += m; \
+			src += m; \
+			cnt -= m; \
+		} \
+	} \
+	\
+	/* Moves the elements of the buffers, and those of the last block of each bucket \
+	 * past its end, to the free slots of their bucket. Buckets are done in order, the \
+	 * elements past the end of a bucket are moved before the next bucket is filled */ \
+	static void name##_cleanup (struct name##_Partition* p) \
+	{ \
+		const size_t bsize = p->bsize; \
+	\
+		for (int c = 0; c < p->numbuckets; ++c) { \
+			const size_t start = p->start[c]; \
+			const size_t end = p->start[c + 1]; \
+			const size_t first = samplesort_align (start, bsize); \
+			const size_t write = p->buckets[c].write; \
+			const size_t headend = (first < end) ? first : end; \
+			size_t pos = start; \
+	\
+			if (write > first && write > end) { \
+				type const* src = &p->arr[end]; \
+				if (write > p->n) { \
+					size_t inside = end - (write - bsize); \
+					memcpy (&p->arr[write - bsize], p->overflow, inside * sizeof (type)); \
+					src = p->overflow + inside; \
+				} \
+				name##_fill (p->arr, &pos, headend, write, src, write - end); \
+			} \
+	\
+			for (int t = 0; t < p->nstripes; ++t) { \
+				const struct name##_Stripe* s = &p->stripes[t]; \
+				name##_fill (p->arr, &pos, headend, write, s->buf + c * bsize, \
+							 s->bufcount[c]); \
+			} \
+		} \
+	} \
+	\
+	/* Runs 'func' for every stripe, in parallel if a pool is given */ \
+	static void name##_run_stripes (struct name##_Partition* p, struct ThreadPool* pool, \
+									ThreadPoolTaskFunc func) \
+	{ \
+		if (pool == NULL) { \
+			for (int t = 0; t < p->nstripes; ++t) \
+				func (&p->stripes[t]); \
+			return; \
+		} \
+	\
+		struct ThreadPoolGroup group; \
+		threadpool_group_init (&group); \
+		for (int t = 1; t < p->nstripes; ++t) \
+			threadpool_submit (pool, &group, func, &p->stripes[t]); \
+		func (&p->stripes[0]); \
+		threadpool_wait (pool, &group); \
+	} \
+	\
+	/* Splits arr[0..n-1] in buckets, with one stripe per thread of 'pool' (one stripe \
+	 * if NULL). 'p->stripes' must have buffers for 2^levels buckets */ \
+	static void name##_partition (struct name##_Partition* p, type* arr, const size_t n, \
+								  SortCompareFunc cmp, struct ThreadPool* pool) \
+	{ \
+		p->arr = arr; \
+		p->n = n; \
+		p->cmp = cmp; \
+		p->bsize = samplesort_BLOCK_BYTES / sizeof (type); \
+		p->levels = samplesort_levels (n, p->bsize); \
+		name##_sample (p); \
+	\
+		/* Stripes of whole blocks, none of them empty */ \
+		p->stripesize = samplesort_align ((n + p->nstripes - 1) / p->nstripes, p->bsize); \
+		while (p->nstripes > 1 && (p->nstripes - 1) * p->stripesize >= n) \
+			p->nstripes--; \
+		for (int t = 0; t < p->nstripes; ++t) { \
+			struct name##_Stripe* s = &p->stripes[t]; \
+			s->part = p; \
+			s->begin = t * p->stripesize; \
+			s->end = (s->begin + p->stripesize < n) ? s->begin + p->stripesize : n; \
+			s->firstbucket = t * p->numbuckets / p->nstripes; \
+		} \
+		p->parallel = (p->nstripes > 1); \
+		p->overflow = p->stripes[0].buf + (size_t)(p->numbuckets + 2) * p->bsize; \
+	\
+		name##_run_stripes (p, pool, name##_classify_task); \
+		name##_prepare (p); \
+	\
+		if (p->parallel) { \
+			for (int c = 0; c < p->numbuckets; ++c) \
+				pthread_mutex_init (&p->buckets[c].lock, NULL); \
+		} \
+		name##_run_stripes (p, pool, name##_permute_task); \
+		if (p->parallel) { \
+			for (int c = 0; c < p->numbuckets; ++c) \
+				pthread_mutex_destroy (&p->buckets[c].lock); \
+		} \
+	\
+		name##_cleanup (p); \
+		SORTSTATS_MOVES (2 * n);		/* to the blocks, then to the buckets */ \
+	} \
+	\
+	/* 1 if bucket 'c' must be sorted (equal buckets are done) */ \
+	static inline int name##_needs_sort (const struct name##_Partition* p, const int c) \
+	{ \
+		if (p->equal && (c & 1) && (c != p->numbuckets - 1)) \
+			return 0; \
+		return (p->start[c + 1] - p->start[c] > 1); \
+	} \
+	\
+	/* Sequential samplesort with the buffers 'ws' of a single stripe */ \
+	static void name##_sort_seq (type* arr, const size_t n, SortCompareFunc cmp, \
+								 struct name##_Stripe* ws, struct SamplesortBucket* buckets) \
+	{ \
+		if (n <= (size_t)samplesort_BASE_CASE) { \
+			if (n > 1) \
+				basesort (arr, n, cmp); \
+			return; \
+		} \
+	\
+		struct name##_Partition p; \
+		p.stripes = ws; \
+		p.nstripes = 1; \
+		p.buckets = buckets; \
+		name##_partition (&p, arr, n, cmp, NULL); \
+	\
+		for (int c = 0; c < p.numbuckets; ++c) { \
+			if (name##_needs_sort (&p, c)) \
+				name##_sort_seq (&arr[p.start[c]], p.start[c + 1] - p.start[c], cmp, ws, \
+								 buckets); \
+		} \
+	} \
+	\
+	/* 1 if arr[0..n-1] is sorted, or was sorted in reverse order and is reversed */ \
+	static int name##_presorted (type* arr, const size_t n, SortCompareFunc cmp) \
+	{ \
+		size_t i = 1; \
+		if (name##_less (arr[1], arr[0], cmp)) { \
+			while (i < n && !name##_less (arr[i - 1], arr[i], cmp)) \
+				i++; \
+			if (i < n) \
+				return 0; \
+			for (size_t j = 0; j < n / 2; ++j) { \
+				SORTSTATS_SWAP (); \
+				type t = arr[j]; \
+				arr[j] = arr[n - 1 - j]; \
+				arr[n - 1 - j] = t; \
+			} \
+			return 1; \
+		} \
+		while (i < n && !name##_less (arr[i], arr[i - 1], cmp)) \
+			i++; \
+		return (i == n); \
+	} \
+	\
+	static void name##_sort_range (type* arr, const size_t n, SortCompareFunc cmp) \
+	{ \
+		if (n <= (size_t)samplesort_BASE_CASE) { \
+			if (n > 1) \
+				basesort (arr, n, cmp); \
+			return; \
+		} \
+		if (name##_presorted (arr, n, cmp)) \
+			return; \
+	\
+		const int numtree = 1 << samplesort_levels (n, samplesort_BLOCK_BYTES / sizeof (type)); \
+		struct name##_Stripe ws; \
+		name##_stripe_alloc (&ws, numtree, samplesort_BLOCK_BYTES / sizeof (type)); \
+		struct SamplesortBucket* buckets = sortstats_malloc (2 * numtree * sizeof (struct SamplesortBucket)); \
+		if (buckets == NULL) { \
+			fprintf (stderr, "Error: failed to allocate memory for samplesort buckets."); \
+			abort (); \
+		} \
+	\
+		name##_sort_seq (arr, n, cmp, &ws, buckets); \
+	\
+		sortstats_free (buckets); \
+		name##_stripe_free (&ws); \
+	} \
+	\
+	/* Task sorting a group of buckets. Buckets bigger than the share of a thread are \
+	 * partitioned in parallel again, the others sequentially */ \
+	static void name##_sort_buckets_task (void* arg) \
+	{ \
+		struct name##_Task* t = arg; \
+		const struct name##_Partition* p = t->part; \
+		const size_t share = p->n / threadpool_num_threads (t->pool); \
+	\
+		for (int c = t->first; c < t->end; ++c) { \
+			if (!name##_needs_sort (p, c)) \
+				continue; \
+			const size_t m = p->start[c + 1] - p->start[c]; \
+			if (m > share) \
+				name##_sort_range_pool (&p->arr[p->start[c]], m, p->cmp, t->pool); \
+			else \
+				name##_sort_range (&p->arr[p->start[c]], m, p->cmp); \
+		} \
+	} \
+	\
+	static void name##_sort_range_pool (type* arr, const size_t n, SortCompareFunc cmp, \
+										struct ThreadPool* pool) \
+	{ \
+		const int nthreads = threadpool_num_threads (pool); \
+		if (n <= (size_t)samplesort_PARALLEL_CUTOFF || nthreads < 2) { \
+			name##_sort_range (arr, n, cmp); \
+			return; \
+		} \
+		if (name##_presorted (arr, n, cmp)) \
+			return; \
+	\
+		const int numtree = 1 << samplesort_levels (n, samplesort_BLOCK_BYTES / sizeof (type)); \
+		struct name##_Partition p; \
+		p.nstripes = nthreads; \
+		p.stripes = sortstats_malloc (nthreads * sizeof (struct name##_Stripe)); \
+		p.buckets = sortstats_malloc (2 * numtree * sizeof (struct SamplesortBucket)); \
+		if (p.stripes == NULL || p.buckets == NULL) { \
+			fprintf (stderr, "Error: failed to allocate memory for parallel samplesort."); \
+			abort (); \
+		} \
+		for (int t = 0; t < nthreads; ++t) \
+			name##_stripe_alloc (&p.stripes[t], numtree, samplesort_BLOCK_BYTES / sizeof (type)); \
+	\
+		name##_partition (&p, arr, n, cmp, pool); \
+	\
+		for (int t = 0; t < nthreads; ++t) \
+			name##_stripe_free (&p.stripes[t]); \
+		sortstats_free (p.stripes); \
+		sortstats_free (p.buckets); \
+	\
+		/* Groups of buckets of about the same size, about 4 per thread */ \
+		struct name##_Task* tasks = sortstats_malloc (p.numbuckets * sizeof (struct name##_Task)); \
+		if (tasks == NULL) { \
+			fprintf (stderr, "Error: failed to allocate memory for parallel samplesort."); \
+			abort (); \
+		} \
+	\
+		const size_t groupsize = n / (4 * nthreads); \
+		int ntasks = 0; \
+		int first = 0; \
+		for (int c = 1; c <= p.numbuckets; ++c) { \
+			if (c == p.numbuckets || p.start[c] - p.start[first] >= groupsize) { \
+				tasks[ntasks].part = &p; \
+				tasks[ntasks].pool = pool; \
+				tasks[ntasks].first = first; \
+				tasks[ntasks].end = c; \
+				ntasks++; \
+				first = c; \
+			} \
+		} \
+	\
+		struct ThreadPoolGroup group; \
+		threadpool_group_init (&group); \
+		for (int t = 1; t < ntasks; ++t) \
+			threadpool_submit (pool, &group, name##_sort_buckets_task, &tasks[t]); \
+		name##_sort_buckets_task (&tasks[0]); \
+		threadpool_wait (pool, &group); \
+	\
+		sortstats_free (tasks); \
+	}
+
+/*
+ * Defines the samplesort of an array of numeric keys ordered by 'less_expr' (on 'a'
+ * and 'b'), with the base cases sorted by the introsort of sortdef.h:
+ *
+ * 		void samplesort_sort_suffix (type arr[], const int from, const int to);
+ * 		void samplesort_sort_suffix_pool (type arr[], const int from, const int to,
+ * 										  struct ThreadPool* pool);
+ * 		void samplesort_sort_suffix_parallel (type arr[], const int from, const int to,
+ * 											  const int nthreads);
+ */
+#define SAMPLESORT_DEFINE_KEYS_(suffix, type, less_expr) \
+	SORT_DEFINE (samplesort_##suffix##_typed, type, less_expr) \
+	\
+	static inline void samplesort_##suffix##_base (type* arr, const size_t n, \
+												   SortCompareFunc cmp) \
+	{ \
+		(void) cmp; \
+		samplesort_##suffix##_typed_introsort (arr, n); \
+	} \
+	\
+	SAMPLESORT_DEFINE_ (samplesort_##suffix, type, less_expr, samplesort_##suffix##_base) \
+	\
+	void samplesort_sort_##suffix (type arr[], const int from, const int to) \
+	{ \
+		if (to > from) \
+			samplesort_##suffix##_sort_range (arr + from, (size_t)(to - from + 1), NULL); \
+	} \
+	\
+	void samplesort_sort_##suffix##_pool (type arr[], const int from, const int to, \
+										  struct ThreadPool* pool) \
+	{ \
+		if (to > from) \
+			samplesort_##suffix##_sort_range_pool (arr + from, (size_t)(to - from + 1), \
+												   NULL, pool); \
+	} \
+	\
+	void samplesort_sort_##suffix##_parallel (type arr[], const int from, const int to, \
+											  const int nthreads) \
+	{ \
+		struct ThreadPool* pool = NULL; \
+		if ((to - from + 1 > samplesort_PARALLEL_CUTOFF) && (nthreads != 1)) \
+			pool = threadpool_create (nthreads); \
+	\
+		if (pool == NULL) { \
+			samplesort_sort_##suffix (arr, from, to); \
+			return; \
+		} \
+	\
+		samplesort_sort_##suffix##_pool (arr, from, to, pool); \
+		threadpool_destroy (pool); \
+	}
+
+/*
+ * Sorts the base cases of arrays of pointers with pdqsort.
+ */
+static void samplesort_ptr_base (void* arr[], const size_t n, SortCompareFunc cmp)
+{
+	pdqsort_sort (arr, 0, (int)n - 1, cmp);
+}
+
+SAMPLESORT_DEFINE_ (samplesort_ptr, void*, cmp (a, b) < 0, samplesort_ptr_base)
+
+SAMPLESORT_DEFINE_KEYS_ (i32, int32_t, a < b)
+SAMPLESORT_DEFINE_KEYS_ (u32, uint32_t, a < b)
+SAMPLESORT_DEFINE_KEYS_ (i64, int64_t, a < b)
+SAMPLESORT_DEFINE_KEYS_ (u64, uint64_t, a < b)
+SAMPLESORT_DEFINE_KEYS_ (float, float, SORT_LESS_NAN_LAST (a, b))
+SAMPLESORT_DEFINE_KEYS_ (double, double, SORT_LESS_NAN_LAST (a, b))
+
+/*
+ * Sorts an array or part of an array items [from..to] using the in-place super scalar
+ * samplesort algorithm.
+ * Note: from (inclusive) .. to (inclusive)
+ */
+void samplesort_sort (void* arr[], const int from, const int to,
+					  SortCompareFunc comparefunc)
+{
+	if (to > from)
+		samplesort_ptr_sort_range (arr + from, (size_t)(to - from + 1), comparefunc);
+}
+
+/*
+ * Parallel samplesort of array or part of an array[from..to] running on the threads
+ * of the given pool.
+ */
+void samplesort_sort_pool (void* arr[], const int from, const int to,
+						   SortCompareFunc comparefunc, struct ThreadPool* pool)
+{
+	if (to > from)
+		samplesort_ptr_sort_range_pool (arr + from, (size_t)(to - from + 1), comparefunc,
+										pool);
+}
+
+/*
+ * Parallel samplesort of array or part of an array[from..to] with 'nthreads' threads
+ * (the number of online processors if 'nthreads' <= 0).
+ */
+void samplesort_sort_parallel (void* arr[], const int from, const int to,
+							   SortCompareFunc comparefunc, const int nthreads)
+{
+	struct ThreadPool* pool = NULL;
+	if ((to - from + 1 > samplesort_PARALLEL_CUTOFF) && (nthreads != 1))
+		pool = threadpool_create (nthreads);
+
+	if (pool == NULL) {
+		samplesort_sort (arr, from, to, comparefunc);
+		return;
+	}
+
+	samplesort_sort_pool (arr, from, to, comparefunc, pool);
+	threadpool_destroy (pool);
+}
@@ -0,0 +1,112 @@
+/*
+ * samplesort.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the in-place parallel super scalar samplesort (IPS4o)
+ * 				sorting algorithm.
+ *
+ * 	Samplesort splits the range into up to 256 buckets per pass, using splitters taken
+ * 	from a random sample, and moves the elements to their buckets in place by blocks.
+ * 	It is the fastest algorithm of the library for big arrays (millions of elements),
+ * 	sequentially and in parallel. It is not stable.
+ *
+ * 	For arrays of numeric keys the following functions sort arr[from..to] in ascending
+ * 	order, with the comparison inlined (suffix i32, u32, i64, u64, float, double):
+ *
+ * 		samplesort_sort_suffix (arr, from, to)
+ * 		samplesort_sort_suffix_pool (arr, from, to, pool)
+ * 		samplesort_sort_suffix_parallel (arr, from, to, nthreads)
+ *
+ * 	Floats and doubles NaNs are sorted to the end of the array.
+ */
+
+#ifndef SAMPLESORT_H_
+	#define SAMPLESORT_H_
+
+	#include <stdint.h>
+	#include "sort.h"
+	#include "threadpool.h"
+	#include "sortapi.h"
+
+	/*
+	 * Sorts an array or part of an array items [from..to] using the in-place super
+	 * scalar samplesort algorithm.
+	 * Note: from (inclusive) .. to (inclusive)
+	 */
+	SORT_API void samplesort_sort (void* arr[], const int from, const int to,
+								   SortCompareFunc comparefunc);
+
+	/*
+	 * Parallel samplesort of array or part of an array[from..to] running on the
+	 * threads of the given pool.
+	 */
+	SORT_API void samplesort_sort_pool (void* arr[], const int from, const int to,
+										SortCompareFunc comparefunc, struct ThreadPool* pool);
+
+	/*
+	 * Parallel samplesort of array or part of an array[from..to] with 'nthreads'
+	 * threads (the number of online processors if 'nthreads' <= 0).
+	 * Each partitioning step classifies one stripe of the range per thread and
+	 * the blocks are permuted by all threads at once, then buckets are sorted by
+	 * tasks of a work-stealing thread pool. Ranges up to a cutoff are sorted by
+	 * 'samplesort_sort ()'.
+	 */
+	SORT_API void samplesort_sort_parallel (void* arr[], const int from, const int to,
+											SortCompareFunc comparefunc, const int nthreads);
+
+	/*
+	 * Sorts signed 32 bits integers arr[from..to] using samplesort.
+	 */
+	SORT_API void samplesort_sort_i32 (int32_t arr[], const int from, const int to);
+	SORT_API void samplesort_sort_i32_pool (int32_t arr[], const int from, const int to,
+											struct ThreadPool* pool);
+	SORT_API void samplesort_sort_i32_parallel (int32_t arr[], const int from, const int to,
+												const int nthreads);
+
+	/*
+	 * Sorts unsigned 32 bits integers arr[from..to] using samplesort.
+	 */
+	SORT_API void samplesort_sort_u32 (uint32_t arr[], const int from, const int to);
+	SORT_API void samplesort_sort_u32_pool (uint32_t arr[], const int from, const int to,
+											struct ThreadPool* pool);
+	SORT_API void samplesort_sort_u32_parallel (uint32_t arr[], const int from, const int to,
+												const int nthreads);
+
+	/*
+	 * Sorts signed 64 bits integers arr[from..to] using samplesort.
+	 */
+	SORT_API void samplesort_sort_i64 (int64_t arr[], const int from, const int to);
+	SORT_API void samplesort_sort_i64_pool (int64_t arr[], const int from, const int to,
+											struct ThreadPool* pool);
+	SORT_API void samplesort_sort_i64_parallel (int64_t arr[], const int from, const int to,
+												const int nthreads);
+
+	/*
+	 * Sorts unsigned 64 bits integers arr[from..to] using samplesort.
+	 */
+	SORT_API void samplesort_sort_u64 (uint64_t arr[], const int from, const int to);
+	SORT_API void samplesort_sort_u64_pool (uint64_t arr[], const int from, const int to,
+											struct ThreadPool* pool);
+	SORT_API void samplesort_sort_u64_parallel (uint64_t arr[], const int from, const int to,
+												const int nthreads);
+
+	/*
+	 * Sorts floats arr[from..to] using samplesort.
+	 */
+	SORT_API void samplesort_sort_float (float arr[], const int from, const int to);
+	SORT_API void samplesort_sort_float_pool (float arr[], const int from, const int to,
+											  struct ThreadPool* pool);
+	SORT_API void samplesort_sort_float_parallel (float arr[], const int from, const int to,
+												  const int nthreads);
+
+	/*
+	 * Sorts doubles arr[from..to] using samplesort.
+	 */
+	SORT_API void samplesort_sort_double (double arr[], const int from, const int to);
+	SORT_API void samplesort_sort_double_pool (double arr[], const int from, const int to,
+											   struct ThreadPool* pool);
+	SORT_API void samplesort_sort_double_parallel (double arr[], const int from, const int to,
+												   const int nthreads);
+
+#endif /* SAMPLESORT_H_ */
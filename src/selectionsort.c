@@ -63,6 +63,7 @@
 
 #include <stdlib.h>
 #include "sort.h"
+#include "selectionsort.h"
 
 /*
  * Sorts an array or part of an array items [from..to] using the selection sort algorithm.
@@ -9,13 +9,14 @@
 #ifndef SELECTIONSORT_H_
 	#define SELECTIONSORT_H_
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
 	 * Sorts an array or part of an array items [from..to] in some order.
 	 * Note: from (inclusive) .. to (inclusive)
 	 */
-	void selectionsort_sort (void* arr[], const int from, const int to,
-							 SortCompareFunc comparefunc);
+	SORT_API void selectionsort_sort (void* arr[], const int from, const int to,
+									  SortCompareFunc comparefunc);
 
 	/*
 	 * Sorts an array or part of an array items [from..to] in some order.
@@ -32,7 +33,7 @@
 	 * Adapted from:
 	 * 		https://www.geeksforgeeks.org/sorting-algorithm-slightly-improves-selection-sort/?ref=lbp
 	 */
-	void selectionsort_min_max_sort (void* arr[], const int from, const int to,
-									 SortCompareFunc comparefunc);
+	SORT_API void selectionsort_min_max_sort (void* arr[], const int from, const int to,
+											  SortCompareFunc comparefunc);
 
 #endif /* SELECTIONSORT_H_ */
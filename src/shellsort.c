@@ -97,6 +97,8 @@
  */
 
 #include "sort.h"
+#include "shellsort.h"
+#include "sortstats.h"
 
 /*
  * Function to sort array[from..to] using shellsort algorithm.
@@ -125,6 +127,7 @@ void shellsort_sort (void* arr[], const int from, const int to,
 
             //  put temp (the original a[i]) in its correct location
             arr[j] = temp;
+            SORTSTATS_MOVES ((i - j) / gap + 1);
         }
     }
 }
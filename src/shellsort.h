@@ -10,11 +10,12 @@
 	#define SHELLSORT_H_
 
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
 	 * Function to sort array[from..to] using shellsort algorithm.
 	 * */
-	void shellsort_sort (void* arr[], const int from, const int to,
-						 SortCompareFunc comparefunc);
+	SORT_API void shellsort_sort (void* arr[], const int from, const int to,
+								  SortCompareFunc comparefunc);
 
 #endif /* SHELLSORT_H_ */
@@ -7,13 +7,74 @@
  *
  */
 
+#include <string.h>
+#include "sort.h"
+#include "sortstats.h"
+
 /*
  * Swaps arguments a and b.
  */
 void sort_swap (void** a, void** b) {
+	SORTSTATS_SWAP ();
 	void* t = *a;
 	*a = *b;
 	*b = t;
 }
 
+/*
+ * Swaps the 'size' bytes long elements at a and b.
+ */
+void sort_swap_values (void* a, void* b, const size_t size) {
+	unsigned char* pa = a;
+	unsigned char* pb = b;
+	unsigned char t[64];
+
+	SORTSTATS_SWAP ();
+
+	// Swap through a small buffer, a chunk at a time
+	for (size_t left = size; left > 0; ) {
+		size_t chunk = (left < sizeof (t)) ? left : sizeof (t);
+		memcpy (t, pa, chunk);
+		memcpy (pa, pb, chunk);
+		memcpy (pb, t, chunk);
+		pa += chunk;
+		pb += chunk;
+		left -= chunk;
+	}
+}
+
+/*
+ * Partitions base[0..n[ around the median of its first, middle and last elements.
+ * Returns the final position of the pivot.
+ */
+size_t sort_partition_values (void* base, const size_t n, const size_t size,
+							  SortCompareFunc comparefunc) {
+	char* first = base;
+	char* lo = first;
+	char* mid = first + (n / 2) * size;
+	char* hi = first + (n - 1) * size;
+
+	// order lo <= mid <= hi, then park median at lo
+	if (comparefunc (mid, lo) < 0)
+		sort_swap_values (mid, lo, size);
+	if (comparefunc (hi, lo) < 0)
+		sort_swap_values (hi, lo, size);
+	if (comparefunc (hi, mid) < 0)
+		sort_swap_values (hi, mid, size);
+	sort_swap_values (lo, mid, size);
+
+	// Scans stop on elements equal to the pivot, which keeps partitions balanced
+	// with many repeated keys
+	size_t i = 0;
+	size_t j = n;
+	while (1) {
+		do i++; while ((i < n) && (comparefunc (first + i * size, lo) < 0));
+		do j--; while (comparefunc (lo, first + j * size) < 0);
+		if (i >= j)
+			break;
+		sort_swap_values (first + i * size, first + j * size, size);
+	}
 
+	sort_swap_values (lo, first + j * size, size);
+	return j;
+}
@@ -10,6 +10,7 @@
 	#define SORT_H_
 
 	#include <stdlib.h>
+	#include "sortapi.h"
 
 	/*
 	 * Defines function prototype for comparing two values for sort algorithms.
@@ -27,6 +28,16 @@
 	typedef void (*SortArrayFunc)(void* arr[], const int from, const int to,
 								  SortCompareFunc comparefunc);
 
+	/*
+	 * Defines function prototype for sorting an array of 'n' contiguous elements of
+	 * 'size' bytes each, starting at 'base' (like 'qsort ()').
+	 * Elements are sorted in place and 'comparefunc' receives pointers to them, so
+	 * no array of pointers to the elements has to be built.
+	 * Ex: to sort an array of ints, set base = arr, n = arraysize and size = sizeof (int)
+	 */
+	typedef void (*SortValuesFunc)(void* base, const size_t n, const size_t size,
+								   SortCompareFunc comparefunc);
+
 	/*
 	 * Defines function prototype for countingsort sorting (in place version).
 	 * 'from' and 'to' arguments are the array index bounds to sort,
@@ -36,6 +47,12 @@
 	typedef void (*CountingSortArrayFuncInPlace)(int arr[],
 												 const int from, const int to);
 
+	/*
+	 * Defines function prototype for getting the integer key of an item (or of a
+	 * record) for the key based counting sorts.
+	 */
+	typedef int (*CountingSortKeyFunc)(const void* item);
+
 	/*
 	 * Defines function prototype for radixsort sorting (in place version).
 	 * 'from' and 'to' arguments are the array index bounds to sort,
@@ -45,6 +62,14 @@
 	typedef void (*RadixSortArrayFuncInPlace)(int arr[],
 											  const int from, const int to);
 
+	/*
+	 * Defines function prototype for strings radixsort sorting (in place version).
+	 * 'from' and 'to' arguments are the array index bounds to sort,
+	 * and are both inclusive.
+	 * Ex: to sort entire array, set from = 0 and to = arraysize-1
+	 */
+	typedef void (*RadixSortStringsFunc)(char* arr[], const int from, const int to);
+
 	/*
 	 * Defines function prototype for countingsort sorting (in place version).
 	 * 'from' and 'to' arguments are the array index bounds to sort,
@@ -57,6 +82,20 @@
 	/*
 	 * Swaps arguments a and b.
 	 */
-	void sort_swap (void** a, void** b);
+	SORT_API void sort_swap (void** a, void** b);
+
+	/*
+	 * Swaps the 'size' bytes long elements at a and b.
+	 */
+	SORT_API void sort_swap_values (void* a, void* b, const size_t size);
+
+	/*
+	 * Partitions the 'n' contiguous elements of 'size' bytes at 'base' around the
+	 * median of the first, middle and last ones, with Hoare's scheme (n >= 2).
+	 * Returns the final position of the pivot. Used by the quicksort and introsort
+	 * of values (not exported by the shared library).
+	 */
+	size_t sort_partition_values (void* base, const size_t n, const size_t size,
+								  SortCompareFunc comparefunc);
 
 #endif /* SORT_H_ */
@@ -0,0 +1,22 @@
+/*
+ * sortapi.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the visibility of the public functions of the library.
+ *
+ * 	The library is built with -fvisibility=hidden (see makefile.targets), so only
+ * 	the functions declared with SORT_API are exported by libcsorting.so; the helpers
+ * 	shared between the files of the library are not.
+ */
+
+#ifndef SORTAPI_H_
+	#define SORTAPI_H_
+
+	#if defined (__GNUC__) && (__GNUC__ >= 4)
+		#define SORT_API __attribute__ ((visibility ("default")))
+	#else
+		#define SORT_API
+	#endif
+
+#endif /* SORTAPI_H_ */
@@ -0,0 +1,250 @@
+/*
+ * sortauto.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements the adaptive sort, that chooses the sorting algorithm
+ * 				from the size and a sample of the input.
+ *
+ *
+ * About:
+ *
+ * 	No algorithm of the library is the fastest on every input: insertion sort wins
+ * 	on a few elements, Timsort sorts presorted inputs in near linear time, radix
+ * 	sort doesn't compare the elements, pdqsort puts all the copies of a repeated
+ * 	pivot in place at once and Introsort is the fastest comparison sort on random
+ * 	data. The adaptive sort looks at a small sample of the input to pick one.
+ *
+ *
+ * Algorithm:
+ *
+ * 	Step 1: Arrays of up to 'sortauto_INSERTIONSORT_MAX' elements are sorted by
+ * 			insertion sort.
+ * 	Step 2: Runs: 'sortauto_WINDOWS' windows of 'sortauto_WINDOW' consecutive
+ * 			elements, spread over the array, are checked. If most of them are
+ * 			ascending or descending the input is made of long runs and is sorted by
+ * 			Timsort.
+ * 	Step 3: With a key function, arrays of at least 'sortauto_RADIXSORT_MIN'
+ * 			elements are sorted by LSD radix sort on the keys.
+ * 	Step 4: Duplicates: a sample of up to 'sortauto_SAMPLE' elements at
+ * 			pseudo-random positions is sorted and its equal neighbours counted. If
+ * 			most of the sample are duplicates, the input has few distinct keys and
+ * 			is sorted by pdqsort: a pivot equal to the previous one puts all its
+ * 			copies in place at once, and the heapsort fallback bounds the time to
+ * 			O(n*log(n)) whatever the order of the distinct keys. (3-way quicksort,
+ * 			that pivots on the last element with no depth limit, overflows the
+ * 			stack on duplicates followed by an ascending tail.)
+ * 	Step 5: Otherwise the array is sorted by Introsort.
+ *
+ * 	Sampling costs less than 'sortauto_WINDOWS' * 'sortauto_WINDOW' comparisons plus
+ * 	the sort of the sample, and doesn't allocate memory.
+ *
+ */
+
+#include <stdint.h>
+#include "sortauto.h"
+#include "insertionsort.h"
+#include "timsort.h"
+#include "pdqsort.h"
+#include "introsort.h"
+
+/*
+ * Biggest array sorted by insertion sort.
+ */
+static const int sortauto_INSERTIONSORT_MAX = 32;
+
+/*
+ * Number and size of the windows checked for runs, and percentage of them that
+ * must be ascending or descending to use Timsort.
+ */
+static const int sortauto_WINDOWS = 32;
+static const int sortauto_WINDOW = 8;
+static const int sortauto_RUNS_PERCENT = 75;
+
+/*
+ * Biggest sample of the duplicates check, and percentage of duplicates in it to
+ * use pdqsort.
+ */
+#define SORTAUTO_SAMPLE_MAX 128
+static const int sortauto_SAMPLE = SORTAUTO_SAMPLE_MAX;
+static const int sortauto_DUPLICATES_PERCENT = 75;
+
+/*
+ * Smallest array sorted by radix sort when a key function is given.
+ */
+static const int sortauto_RADIXSORT_MIN = 512;
+
+/*
+ * Names of the paths.
+ */
+static const char* const sortauto_NAMES[] = {
+	"insertionsort", "timsort", "radixsort", "pdqsort", "introsort"
+};
+
+/*
+ * Returns the name of path 'path'.
+ */
+const char* sort_auto_name (const int path)
+{
+	if ((path < SORTAUTO_INSERTIONSORT) || (path > SORTAUTO_INTROSORT))
+		return "unknown";
+	return sortauto_NAMES[path];
+}
+
+/*
+ * Returns 1 if arr[from..to] is made of long runs: most of the windows checked are
+ * ascending or descending.
+ */
+static int sortauto_presorted (void* arr[], const int from, const int to,
+							   SortCompareFunc comparefunc)
+{
+	const int n = to - from + 1;
+	int windows = n / sortauto_WINDOW;
+	if (windows > sortauto_WINDOWS)
+		windows = sortauto_WINDOWS;
+
+	int monotonic = 0;
+	for (int w = 0; w < windows; w++) {
+		// Windows evenly spread from the first to the last element
+		const int start = from + (int)(((int64_t)w * (n - sortauto_WINDOW)) /
+									   ((windows > 1) ? windows - 1 : 1));
+		int ascending = 1;
+		int descending = 1;
+		for (int i = start; (i < start + sortauto_WINDOW - 1) && (ascending || descending);
+			 i++) {
+			const int c = comparefunc (arr[i], arr[i + 1]);
+			if (c > 0)
+				ascending = 0;
+			else if (c < 0)
+				descending = 0;
+		}
+		if (ascending || descending)
+			monotonic++;
+	}
+
+	return monotonic * 100 >= windows * sortauto_RUNS_PERCENT;
+}
+
+/*
+ * Returns 1 if most of a sample of arr[from..to] are duplicates.
+ */
+static int sortauto_duplicates (void* arr[], const int from, const int to,
+								SortCompareFunc comparefunc)
+{
+	const int n = to - from + 1;
+	void* sample[SORTAUTO_SAMPLE_MAX];
+	int m = n / sortauto_WINDOW;
+	if (m > sortauto_SAMPLE)
+		m = sortauto_SAMPLE;
+	if (m < 2)
+		return 0;
+
+	// Pseudo-random positions (xorshift), so periodic inputs are not sampled at the
+	// same phase
+	uint64_t state = UINT64_C (0x9E3779B97F4A7C15) ^ (uint64_t)n;
+	for (int k = 0; k < m; k++) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		sample[k] = arr[from + (int)(state % (uint64_t)n)];
+	}
+
+	introsort_sort (sample, 0, m - 1, comparefunc);
+
+	int duplicates = 0;
+	for (int k = 1; k < m; k++)
+		if (comparefunc (sample[k - 1], sample[k]) == 0)
+			duplicates++;
+
+	return duplicates * 100 >= (m - 1) * sortauto_DUPLICATES_PERCENT;
+}
+
+/*
+ * Chooses the path of arr[from..to]. 'haskey' tells if radix sort can be used.
+ */
+static int sortauto_choose (void* arr[], const int from, const int to,
+							SortCompareFunc comparefunc, const int haskey)
+{
+	const int n = to - from + 1;
+
+	if (n <= sortauto_INSERTIONSORT_MAX)
+		return SORTAUTO_INSERTIONSORT;
+	if (sortauto_presorted (arr, from, to, comparefunc))
+		return SORTAUTO_TIMSORT;
+	if (haskey && (n >= sortauto_RADIXSORT_MIN))
+		return SORTAUTO_RADIXSORT;
+	if (sortauto_duplicates (arr, from, to, comparefunc))
+		return SORTAUTO_PDQSORT;
+	return SORTAUTO_INTROSORT;
+}
+
+/*
+ * Sorts arr[from..to] with the comparison sort of path 'path'.
+ */
+static void sortauto_sort (void* arr[], const int from, const int to,
+						   SortCompareFunc comparefunc, const int path)
+{
+	switch (path) {
+	case SORTAUTO_INSERTIONSORT:
+		insertionsort_sort (arr, from, to, comparefunc);
+		break;
+	case SORTAUTO_TIMSORT:
+		timsort_sort (arr, from, to, comparefunc);
+		break;
+	case SORTAUTO_PDQSORT:
+		pdqsort_sort (arr, from, to, comparefunc);
+		break;
+	default:
+		introsort_sort (arr, from, to, comparefunc);
+		break;
+	}
+}
+
+/*
+ * Sorts array or part of an array arr[from..to], choosing the algorithm from
+ * the size and a sample of the input. Returns the path taken.
+ */
+int sort_auto (void* arr[], const int from, const int to,
+			   SortCompareFunc comparefunc)
+{
+	if (to <= from)
+		return SORTAUTO_INSERTIONSORT;
+
+	const int path = sortauto_choose (arr, from, to, comparefunc, 0);
+	sortauto_sort (arr, from, to, comparefunc, path);
+	return path;
+}
+
+/*
+ * Same as 'sort_auto ()', sorting big inputs by 32 bits keys with radix sort.
+ */
+int sort_auto_key32 (void* arr[], const int from, const int to,
+					 SortCompareFunc comparefunc, RadixSortKey32Func keyfunc)
+{
+	if (to <= from)
+		return SORTAUTO_INSERTIONSORT;
+
+	const int path = sortauto_choose (arr, from, to, comparefunc, keyfunc != NULL);
+	if (path == SORTAUTO_RADIXSORT)
+		radixsortkey_sort_u32 (arr, from, to, keyfunc);
+	else
+		sortauto_sort (arr, from, to, comparefunc, path);
+	return path;
+}
+
+/*
+ * Same as 'sort_auto ()', sorting big inputs by 64 bits keys with radix sort.
+ */
+int sort_auto_key64 (void* arr[], const int from, const int to,
+					 SortCompareFunc comparefunc, RadixSortKey64Func keyfunc)
+{
+	if (to <= from)
+		return SORTAUTO_INSERTIONSORT;
+
+	const int path = sortauto_choose (arr, from, to, comparefunc, keyfunc != NULL);
+	if (path == SORTAUTO_RADIXSORT)
+		radixsortkey_sort_u64 (arr, from, to, keyfunc);
+	else
+		sortauto_sort (arr, from, to, comparefunc, path);
+	return path;
+}
@@ -0,0 +1,62 @@
+/*
+ * sortauto.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the adaptive sort, that chooses the sorting algorithm
+ * 				from the size and a sample of the input.
+ *
+ * 	'sort_auto ()' is the default way to sort an array of pointers: it samples the
+ * 	input and sorts it with insertion sort (tiny arrays), Timsort (presorted: few
+ * 	long ascending or descending runs), radix sort (when a key function is given),
+ * 	pdqsort (many duplicates) or Introsort. All of them run in O(n*log(n))
+ * 	on the inputs they are chosen for.
+ *
+ * 	The sort is not stable. The returned path (SORTAUTO_*) tells which algorithm
+ * 	sorted the array, 'sort_auto_name ()' gives its name.
+ */
+
+#ifndef SORTAUTO_H_
+	#define SORTAUTO_H_
+
+	#include "sort.h"
+	#include "radixsortkey.h"
+	#include "sortapi.h"
+
+	/*
+	 * Paths of the adaptive sort.
+	 */
+	#define SORTAUTO_INSERTIONSORT 0
+	#define SORTAUTO_TIMSORT 1
+	#define SORTAUTO_RADIXSORT 2
+	#define SORTAUTO_PDQSORT 3
+	#define SORTAUTO_INTROSORT 4
+
+	/*
+	 * Returns the name of path 'path'.
+	 */
+	SORT_API const char* sort_auto_name (const int path);
+
+	/*
+	 * Sorts array or part of an array arr[from..to], choosing the algorithm from
+	 * the size and a sample of the input. Returns the path taken.
+	 * Note: from (inclusive) .. to (inclusive)
+	 */
+	SORT_API int sort_auto (void* arr[], const int from, const int to,
+							SortCompareFunc comparefunc);
+
+	/*
+	 * Same as 'sort_auto ()', but big inputs that are not presorted are sorted by
+	 * the 32 bits keys returned by 'keyfunc' with LSD radix sort.
+	 * The keys must have the order of 'comparefunc' (see radixsortkey.h).
+	 */
+	SORT_API int sort_auto_key32 (void* arr[], const int from, const int to,
+								  SortCompareFunc comparefunc, RadixSortKey32Func keyfunc);
+
+	/*
+	 * Same as 'sort_auto_key32 ()' with 64 bits keys.
+	 */
+	SORT_API int sort_auto_key64 (void* arr[], const int from, const int to,
+								  SortCompareFunc comparefunc, RadixSortKey64Func keyfunc);
+
+#endif /* SORTAUTO_H_ */
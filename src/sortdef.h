@@ -0,0 +1,425 @@
+/*
+ * sortdef.h
+ *
+ *  Created on: 16/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Header only generator of sorting algorithms specialized for a given
+ * 				element type, with the comparison inlined.
+ *
+ * About:
+ *
+ *    The generic algorithms call the comparison through a 'SortCompareFunc' pointer.
+ *    That call can't be inlined, so every comparison costs a function call and the
+ *    compiler can't keep keys in registers or use conditional moves in the hot loops.
+ *    For numeric keys this easily makes the sort 2 to 4 times slower.
+ *
+ *    The macros below instantiate introsort, mergesort, timsort and heapsort for a
+ *    concrete type, with the "less than" comparison written as an expression on 'a'
+ *    and 'b' that the compiler inlines:
+ *
+ *       #include "sortdef.h"
+ *
+ *       struct Point { int x; int y; };
+ *       SORT_DEFINE (point, struct Point, (a.x < b.x) || (a.x == b.x && a.y < b.y))
+ *
+ *       ...
+ *       point_introsort (points, n);
+ *
+ *    'SORT_DEFINE (name, type, less_expr)' defines (as static inline):
+ *
+ *       void name_introsort (type* arr, const size_t n);	// not stable, in place
+ *       void name_heapsort (type* arr, const size_t n);	// not stable, in place
+ *       void name_mergesort (type* arr, const size_t n);	// stable, n extra elements
+ *       void name_timsort (type* arr, const size_t n);		// stable, n/2 extra elements
+ *
+ *    'less_expr' must be a strict weak ordering on 'a' and 'b' (both of 'type'). For
+ *    floating point keys use 'SORT_LESS_NAN_LAST (a, b)', plain '<' is not an ordering
+ *    when NaNs are present.
+ *
+ *    To build the functions once in a .c file and export them, use
+ *    'SORT_DECLARE (name, type)' in a header and 'SORT_DEFINE_SCOPE (, name, type,
+ *    less_expr)' in the .c file (see sorttyped.h and sorttyped.c).
+ *
+ */
+
+#ifndef SORTDEF_H_
+	#define SORTDEF_H_
+
+	#include <stdio.h>
+	#include <stdlib.h>
+	#include <string.h>
+	#include "sortstats.h"
+	#include "sortapi.h"
+
+	/*
+	 * Strict weak ordering for floating point keys: NaNs are greater than any other
+	 * value and equal to each other.
+	 */
+	#define SORT_LESS_NAN_LAST(a, b) (((a) < (b)) || (((b) != (b)) && ((a) == (a))))
+
+	/*
+	 * Declares the functions generated by 'SORT_DEFINE_SCOPE (, name, type, ...)'.
+	 */
+	#define SORT_DECLARE(name, type) \
+		SORT_API void name##_introsort (type* arr, const size_t n); \
+		SORT_API void name##_heapsort (type* arr, const size_t n); \
+		SORT_API void name##_mergesort (type* arr, const size_t n); \
+		SORT_API void name##_timsort (type* arr, const size_t n);
+
+	/*
+	 * Defines all sorting functions as static inline.
+	 */
+	#define SORT_DEFINE(name, type, less_expr) \
+		SORT_DEFINE_SCOPE (static inline, name, type, less_expr)
+
+	/*
+	 * Defines all sorting functions with the given storage class 'scope' (empty for
+	 * exported functions). Internal helpers are always static inline.
+	 */
+	#define SORT_DEFINE_SCOPE(scope, name, type, less_expr) \
+		SORT_DEFINE_COMMON_ (name, type, less_expr) \
+		SORT_DEFINE_HEAPSORT_ (scope, name, type) \
+		SORT_DEFINE_INTROSORT_ (scope, name, type) \
+		SORT_DEFINE_MERGESORT_ (scope, name, type) \
+		SORT_DEFINE_TIMSORT_ (scope, name, type)
+
+
+	/*
+	 * Comparison, swap and insertion sort.
+	 */
+	#define SORT_DEFINE_COMMON_(name, type, less_expr) \
+		static inline int name##_less (const type a, const type b) \
+		{ \
+			SORTSTATS_COMPARE (); \
+			return (less_expr); \
+		} \
+		\
+		static inline void name##_swap (type* x, type* y) \
+		{ \
+			SORTSTATS_SWAP (); \
+			type t = *x; \
+			*x = *y; \
+			*y = t; \
+		} \
+		\
+		static inline void name##_insertion_sort (type* arr, const size_t n) \
+		{ \
+			for (size_t i = 1; i < n; ++i) { \
+				type key = arr[i]; \
+				size_t j = i; \
+				while ((j > 0) && name##_less (key, arr[j - 1])) { \
+					arr[j] = arr[j - 1]; \
+					j--; \
+				} \
+				arr[j] = key; \
+				SORTSTATS_MOVES (i - j + 1); \
+			} \
+		}
+
+
+	/*
+	 * Heapsort (see heapsort.c).
+	 */
+	#define SORT_DEFINE_HEAPSORT_(scope, name, type) \
+		static inline void name##_sift_down (type* arr, size_t i, const size_t n) \
+		{ \
+			type tmp = arr[i]; \
+			size_t child; \
+			while ((child = 2 * i + 1) < n) { \
+				if ((child + 1 < n) && name##_less (arr[child], arr[child + 1])) \
+					child++; \
+				if (!name##_less (tmp, arr[child])) \
+					break; \
+				arr[i] = arr[child]; \
+				SORTSTATS_MOVES (1); \
+				i = child; \
+			} \
+			arr[i] = tmp; \
+			SORTSTATS_MOVES (1); \
+		} \
+		\
+		scope void name##_heapsort (type* arr, const size_t n) \
+		{ \
+			if (n < 2) \
+				return; \
+			for (size_t i = n / 2; i-- > 0; ) \
+				name##_sift_down (arr, i, n); \
+			for (size_t i = n - 1; i > 0; i--) { \
+				name##_swap (&arr[0], &arr[i]); \
+				name##_sift_down (arr, 0, i); \
+			} \
+		}
+
+
+	/*
+	 * Introsort (see introsort.c): quicksort with median of 3 pivot and Hoare's
+	 * partition, heapsort after 2*log2(n) levels, insertion sort on small ranges.
+	 */
+	#define SORT_DEFINE_INTROSORT_(scope, name, type) \
+		static inline size_t name##_partition (type* arr, const size_t n) \
+		{ \
+			size_t mid = n / 2; \
+			if (name##_less (arr[mid], arr[0])) \
+				name##_swap (&arr[mid], &arr[0]); \
+			if (name##_less (arr[n - 1], arr[0])) \
+				name##_swap (&arr[n - 1], &arr[0]); \
+			if (name##_less (arr[n - 1], arr[mid])) \
+				name##_swap (&arr[n - 1], &arr[mid]); \
+			name##_swap (&arr[0], &arr[mid]); \
+			\
+			const type pivot = arr[0]; \
+			size_t i = 0; \
+			size_t j = n; \
+			while (1) { \
+				do i++; while ((i < n) && name##_less (arr[i], pivot)); \
+				do j--; while (name##_less (pivot, arr[j])); \
+				if (i >= j) \
+					break; \
+				name##_swap (&arr[i], &arr[j]); \
+			} \
+			name##_swap (&arr[0], &arr[j]); \
+			return j; \
+		} \
+		\
+		static void name##_introsort_loop (type* arr, size_t n, int depthlimit) \
+		{ \
+			while (n > 16) { \
+				if (depthlimit-- == 0) { \
+					name##_heapsort (arr, n); \
+					return; \
+				} \
+				size_t p = name##_partition (arr, n); \
+				if (p < n - p - 1) { \
+					name##_introsort_loop (arr, p, depthlimit); \
+					arr += p + 1; \
+					n -= p + 1; \
+				} \
+				else { \
+					name##_introsort_loop (arr + p + 1, n - p - 1, depthlimit); \
+					n = p; \
+				} \
+			} \
+			name##_insertion_sort (arr, n); \
+		} \
+		\
+		scope void name##_introsort (type* arr, const size_t n) \
+		{ \
+			int depthlimit = 0; \
+			for (size_t m = n; m > 1; m >>= 1) \
+				depthlimit += 2; \
+			name##_introsort_loop (arr, n, depthlimit); \
+		}
+
+
+	/*
+	 * Top-down mergesort with a single auxiliary buffer, source and destination swap
+	 * roles between levels (see mergesort.c).
+	 */
+	#define SORT_DEFINE_MERGESORT_(scope, name, type) \
+		static void name##_mergesort_rec (type* src, type* dst, const size_t n) \
+		{ \
+			if (n <= 16) { \
+				name##_insertion_sort (dst, n); \
+				return; \
+			} \
+			size_t m = n / 2; \
+			name##_mergesort_rec (dst, src, m); \
+			name##_mergesort_rec (dst + m, src + m, n - m); \
+			SORTSTATS_MOVES (n); \
+			if (!name##_less (src[m], src[m - 1])) { \
+				memcpy (dst, src, n * sizeof (type)); \
+				return; \
+			} \
+			size_t i = 0, j = m, k = 0; \
+			while (i < m && j < n) \
+				dst[k++] = name##_less (src[j], src[i]) ? src[j++] : src[i++]; \
+			while (i < m) \
+				dst[k++] = src[i++]; \
+			while (j < n) \
+				dst[k++] = src[j++]; \
+		} \
+		\
+		scope void name##_mergesort (type* arr, const size_t n) \
+		{ \
+			if (n < 2) \
+				return; \
+			type* buf = sortstats_malloc (n * sizeof (type)); \
+			if (buf == NULL) { \
+				fprintf (stderr, "Error: failed to allocate memory for merge sort."); \
+				abort (); \
+			} \
+			memcpy (buf, arr, n * sizeof (type)); \
+			SORTSTATS_MOVES (n); \
+			name##_mergesort_rec (buf, arr, n); \
+			sortstats_free (buf); \
+		}
+
+
+	/*
+	 * Timsort: natural runs (strictly descending ones are reversed) extended to
+	 * 'minrun' with binary insertion sort, merged following the run stack invariants.
+	 * Before merging, the head of the left run and the tail of the right run that are
+	 * already in place are skipped with binary searches, then the smaller run is moved
+	 * to the buffer.
+	 */
+	#define SORT_DEFINE_TIMSORT_(scope, name, type) \
+		static inline size_t name##_count_run (type* arr, const size_t n) \
+		{ \
+			size_t r = 2; \
+			if (n < 2) \
+				return n; \
+			if (name##_less (arr[1], arr[0])) { \
+				while ((r < n) && name##_less (arr[r], arr[r - 1])) \
+					r++; \
+				for (size_t lo = 0, hi = r - 1; lo < hi; lo++, hi--) \
+					name##_swap (&arr[lo], &arr[hi]); \
+			} \
+			else { \
+				while ((r < n) && !name##_less (arr[r], arr[r - 1])) \
+					r++; \
+			} \
+			return r; \
+		} \
+		\
+		static inline void name##_binary_insertion_sort (type* arr, const size_t n, \
+														 size_t start) \
+		{ \
+			for (; start < n; ++start) { \
+				type key = arr[start]; \
+				size_t lo = 0, hi = start; \
+				while (lo < hi) { \
+					size_t mid = lo + (hi - lo) / 2; \
+					if (name##_less (key, arr[mid])) \
+						hi = mid; \
+					else \
+						lo = mid + 1; \
+				} \
+				memmove (&arr[lo + 1], &arr[lo], (start - lo) * sizeof (type)); \
+				arr[lo] = key; \
+				SORTSTATS_MOVES (start - lo + 1); \
+			} \
+		} \
+		\
+		static inline void name##_merge_runs (type* a, size_t n1, size_t n2, type* buf) \
+		{ \
+			type* b = a + n1; \
+			size_t lo, hi; \
+			\
+			/* Left run elements not greater than b[0] are already in place */ \
+			for (lo = 0, hi = n1; lo < hi; ) { \
+				size_t mid = lo + (hi - lo) / 2; \
+				if (name##_less (b[0], a[mid])) \
+					hi = mid; \
+				else \
+					lo = mid + 1; \
+			} \
+			a += lo; \
+			n1 -= lo; \
+			if (n1 == 0) \
+				return; \
+			\
+			/* Right run elements not less than the last of left run are in place too */ \
+			for (lo = 0, hi = n2; lo < hi; ) { \
+				size_t mid = lo + (hi - lo) / 2; \
+				if (name##_less (b[mid], a[n1 - 1])) \
+					lo = mid + 1; \
+				else \
+					hi = mid; \
+			} \
+			n2 = lo; \
+			if (n2 == 0) \
+				return; \
+			\
+			/* The smaller run is copied to the buffer and both are merged back */ \
+			SORTSTATS_MOVES (((n1 <= n2) ? n1 : n2) + n1 + n2); \
+			if (n1 <= n2) { \
+				size_t i = 0, j = 0, k = 0; \
+				memcpy (buf, a, n1 * sizeof (type)); \
+				while (i < n1 && j < n2) \
+					a[k++] = name##_less (b[j], buf[i]) ? b[j++] : buf[i++]; \
+				while (i < n1) \
+					a[k++] = buf[i++]; \
+			} \
+			else { \
+				size_t i = n1, j = n2, k = n1 + n2; \
+				memcpy (buf, b, n2 * sizeof (type)); \
+				while (i > 0 && j > 0) \
+					a[--k] = name##_less (buf[j - 1], a[i - 1]) ? a[--i] : buf[--j]; \
+				while (j > 0) \
+					a[--k] = buf[--j]; \
+			} \
+		} \
+		\
+		static inline void name##_merge_at (type* arr, size_t* runbase, size_t* runlen, \
+											int* nruns, const int i, type* buf) \
+		{ \
+			name##_merge_runs (arr + runbase[i], runlen[i], runlen[i + 1], buf); \
+			runlen[i] += runlen[i + 1]; \
+			if (i + 2 < *nruns) { \
+				runbase[i + 1] = runbase[i + 2]; \
+				runlen[i + 1] = runlen[i + 2]; \
+			} \
+			(*nruns)--; \
+		} \
+		\
+		scope void name##_timsort (type* arr, const size_t n) \
+		{ \
+			size_t runbase[85], runlen[85]; \
+			int nruns = 0; \
+			\
+			if (n < 64) { \
+				name##_binary_insertion_sort (arr, n, name##_count_run (arr, n)); \
+				return; \
+			} \
+			\
+			/* minrun is n/2^k rounded up, in [32..64] */ \
+			size_t minrun = n, r = 0; \
+			while (minrun >= 64) { \
+				r |= minrun & 1; \
+				minrun >>= 1; \
+			} \
+			minrun += r; \
+			\
+			type* buf = sortstats_malloc ((n / 2 + 1) * sizeof (type)); \
+			if (buf == NULL) { \
+				fprintf (stderr, "Error: failed to allocate memory for timsort."); \
+				abort (); \
+			} \
+			\
+			for (size_t lo = 0; lo < n; ) { \
+				size_t len = name##_count_run (arr + lo, n - lo); \
+				if (len < minrun) { \
+					size_t force = (n - lo < minrun) ? (n - lo) : minrun; \
+					name##_binary_insertion_sort (arr + lo, force, len); \
+					len = force; \
+				} \
+				runbase[nruns] = lo; \
+				runlen[nruns] = len; \
+				nruns++; \
+				lo += len; \
+				\
+				/* Keep len[i-2] > len[i-1] + len[i] and len[i-1] > len[i] */ \
+				while (nruns > 1) { \
+					int k = nruns - 2; \
+					if ((k > 0 && runlen[k - 1] <= runlen[k] + runlen[k + 1]) || \
+							(k > 1 && runlen[k - 2] <= runlen[k - 1] + runlen[k])) { \
+						if (runlen[k - 1] < runlen[k + 1]) \
+							k--; \
+					} \
+					else if (runlen[k] > runlen[k + 1]) \
+						break; \
+					name##_merge_at (arr, runbase, runlen, &nruns, k, buf); \
+				} \
+			} \
+			\
+			while (nruns > 1) { \
+				int k = nruns - 2; \
+				if (k > 0 && runlen[k - 1] < runlen[k + 1]) \
+					k--; \
+				name##_merge_at (arr, runbase, runlen, &nruns, k, buf); \
+			} \
+			\
+			sortstats_free (buf); \
+		}
+
+#endif /* SORTDEF_H_ */
@@ -0,0 +1,177 @@
+/*
+ * sortstats.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements the instrumentation counters of the sorting functions.
+ *
+ * About:
+ *
+ * 	The complexity tables at the beginning of each file tell how an algorithm grows,
+ * 	not what it does on a given input. Counting the comparisons, swaps, moves and
+ * 	memory of a sort shows why it is slow on some data: e.g. a quicksort doing n^2/2
+ * 	comparisons on many duplicates, or a mergesort whose time goes to moves when the
+ * 	elements are big.
+ *
+ * 	The size of a block is not stored with it: 'malloc_usable_size ()' gives the
+ * 	bytes of a block when it is allocated and when it is released, so blocks can be
+ * 	released by 'free ()' and the counted functions can release blocks allocated by
+ * 	'malloc ()'.
+ *
+ */
+
+#include <malloc.h>
+#include <stdatomic.h>
+#include "sortstats.h"
+
+/*
+ * Counters.
+ */
+static atomic_ullong sortstats_comparisons;
+static atomic_ullong sortstats_swaps;
+static atomic_ullong sortstats_moves;
+static atomic_ullong sortstats_allocations;
+static atomic_llong sortstats_aux_bytes;
+static atomic_llong sortstats_peak_aux_bytes;
+
+/*
+ * Comparison function counted by 'sortstats_compare ()'.
+ */
+static SortCompareFunc sortstats_comparefunc = NULL;
+
+/*
+ * Clears the counters.
+ */
+void sortstats_reset (void)
+{
+	atomic_store (&sortstats_comparisons, 0);
+	atomic_store (&sortstats_swaps, 0);
+	atomic_store (&sortstats_moves, 0);
+	atomic_store (&sortstats_allocations, 0);
+	atomic_store (&sortstats_aux_bytes, 0);
+	atomic_store (&sortstats_peak_aux_bytes, 0);
+}
+
+/*
+ * Copies the counters to 'stats'.
+ */
+void sortstats_get (struct SortStats* stats)
+{
+	long long aux = atomic_load (&sortstats_aux_bytes);
+	long long peak = atomic_load (&sortstats_peak_aux_bytes);
+
+	stats->comparisons = atomic_load (&sortstats_comparisons);
+	stats->swaps = atomic_load (&sortstats_swaps);
+	stats->moves = atomic_load (&sortstats_moves);
+	stats->allocations = atomic_load (&sortstats_allocations);
+
+	// Blocks allocated before the reset and released after it make aux negative
+	stats->aux_bytes = (aux > 0) ? (size_t)aux : 0;
+	stats->peak_aux_bytes = (peak > 0) ? (size_t)peak : 0;
+}
+
+/*
+ * Returns 1 if the library was built with -DSORT_STATS, 0 otherwise.
+ */
+int sortstats_enabled (void)
+{
+#ifdef SORT_STATS
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+/*
+ * Counts a comparison and compares a and b with the counted comparison function.
+ */
+static int sortstats_compare (const void* a, const void* b)
+{
+	atomic_fetch_add_explicit (&sortstats_comparisons, 1, memory_order_relaxed);
+	return sortstats_comparefunc (a, b);
+}
+
+/*
+ * Returns a comparison function that counts its calls and calls 'comparefunc'.
+ */
+SortCompareFunc sortstats_counting_compare (SortCompareFunc comparefunc)
+{
+	sortstats_comparefunc = comparefunc;
+	return sortstats_compare;
+}
+
+/*
+ * Adds to the counters.
+ */
+void sortstats_add_comparisons (const uint64_t n)
+{
+	atomic_fetch_add_explicit (&sortstats_comparisons, n, memory_order_relaxed);
+}
+
+void sortstats_add_swaps (const uint64_t n)
+{
+	atomic_fetch_add_explicit (&sortstats_swaps, n, memory_order_relaxed);
+}
+
+void sortstats_add_moves (const uint64_t n)
+{
+	atomic_fetch_add_explicit (&sortstats_moves, n, memory_order_relaxed);
+}
+
+/*
+ * Adds 'bytes' (negative when released) to the auxiliary bytes and updates the peak.
+ */
+static void sortstats_add_aux (const long long bytes)
+{
+	long long aux = atomic_fetch_add (&sortstats_aux_bytes, bytes) + bytes;
+	long long peak = atomic_load (&sortstats_peak_aux_bytes);
+
+	while ((aux > peak) &&
+		   !atomic_compare_exchange_weak (&sortstats_peak_aux_bytes, &peak, aux))
+		;
+}
+
+/*
+ * Counts an allocated block.
+ */
+static void* sortstats_allocated (void* ptr)
+{
+	if (ptr != NULL) {
+		atomic_fetch_add_explicit (&sortstats_allocations, 1, memory_order_relaxed);
+		sortstats_add_aux ((long long)malloc_usable_size (ptr));
+	}
+	return ptr;
+}
+
+/*
+ * Allocation functions that count the blocks and the auxiliary bytes.
+ */
+void* sortstats_counted_malloc (const size_t size)
+{
+	return sortstats_allocated (malloc (size));
+}
+
+void* sortstats_counted_calloc (const size_t n, const size_t size)
+{
+	return sortstats_allocated (calloc (n, size));
+}
+
+void* sortstats_counted_realloc (void* ptr, const size_t size)
+{
+	long long oldsize = (ptr != NULL) ? (long long)malloc_usable_size (ptr) : 0;
+	void* newptr = realloc (ptr, size);
+
+	if (newptr != NULL) {
+		sortstats_add_aux (-oldsize);
+		sortstats_allocated (newptr);
+	}
+	return newptr;
+}
+
+void sortstats_counted_free (void* ptr)
+{
+	if (ptr != NULL) {
+		sortstats_add_aux (-(long long)malloc_usable_size (ptr));
+		free (ptr);
+	}
+}
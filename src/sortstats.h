@@ -0,0 +1,107 @@
+/*
+ * sortstats.h
+ *
+ *  Created on: 17/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the instrumentation of the sorting functions: counts of
+ * 				comparisons, swaps, element moves, allocations and peak auxiliary
+ * 				memory of a sort.
+ *
+ * 	The counters are global, they are cleared by 'sortstats_reset ()' and read by
+ * 	'sortstats_get ()', so the counts of a call are read as:
+ *
+ * 		sortstats_reset ();
+ * 		pdqsort_sort (arr, 0, n - 1, sortstats_counting_compare (compare_ints));
+ * 		sortstats_get (&stats);
+ *
+ * 	Comparisons through a 'SortCompareFunc' are counted by wrapping the comparison
+ * 	function with 'sortstats_counting_compare ()', in any build.
+ *
+ * 	Swaps, moves, allocations and the comparisons of the typed sorts (sortdef.h) are
+ * 	counted inside the library, only when it is built with -DSORT_STATS. Otherwise
+ * 	the hooks below compile to nothing and those counts stay 0.
+ *
+ * 	The counters are atomic, so the parallel sorts are counted too, but only one
+ * 	sort at a time can be measured.
+ */
+
+#ifndef SORTSTATS_H_
+	#define SORTSTATS_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+	#include <stdlib.h>
+	#include "sort.h"
+	#include "sortapi.h"
+
+	/*
+	 * Counts of the sorts since the last 'sortstats_reset ()'.
+	 */
+	struct SortStats {
+		uint64_t comparisons;		// calls of the comparison function
+		uint64_t swaps;				// exchanges of two elements or linked list nodes
+		uint64_t moves;				// elements copied (shifts, merges, buffers)
+		uint64_t allocations;		// blocks allocated (malloc, calloc, realloc)
+		size_t aux_bytes;			// bytes allocated and not released yet
+		size_t peak_aux_bytes;		// maximum of aux_bytes
+	};
+
+	/*
+	 * Clears the counters.
+	 */
+	SORT_API void sortstats_reset (void);
+
+	/*
+	 * Copies the counters to 'stats'.
+	 */
+	SORT_API void sortstats_get (struct SortStats* stats);
+
+	/*
+	 * Returns 1 if the library was built with -DSORT_STATS (swaps, moves and
+	 * allocations are counted), 0 otherwise.
+	 */
+	SORT_API int sortstats_enabled (void);
+
+	/*
+	 * Returns a comparison function that counts its calls and calls 'comparefunc'.
+	 * The function is shared, so only one comparison function can be counted at a time.
+	 */
+	SORT_API SortCompareFunc sortstats_counting_compare (SortCompareFunc comparefunc);
+
+	/*
+	 * Adds to the counters, used by the hooks below.
+	 */
+	SORT_API void sortstats_add_comparisons (const uint64_t n);
+	SORT_API void sortstats_add_swaps (const uint64_t n);
+	SORT_API void sortstats_add_moves (const uint64_t n);
+
+	/*
+	 * Allocation functions that count the blocks and the auxiliary bytes.
+	 */
+	SORT_API void* sortstats_counted_malloc (const size_t size);
+	SORT_API void* sortstats_counted_calloc (const size_t n, const size_t size);
+	SORT_API void* sortstats_counted_realloc (void* ptr, const size_t size);
+	SORT_API void sortstats_counted_free (void* ptr);
+
+	/*
+	 * Hooks of the sorting functions.
+	 */
+	#ifdef SORT_STATS
+		#define SORTSTATS_COMPARE() sortstats_add_comparisons (1)
+		#define SORTSTATS_SWAP() sortstats_add_swaps (1)
+		#define SORTSTATS_MOVES(n) sortstats_add_moves ((uint64_t)(n))
+		#define sortstats_malloc(size) sortstats_counted_malloc (size)
+		#define sortstats_calloc(n, size) sortstats_counted_calloc (n, size)
+		#define sortstats_realloc(ptr, size) sortstats_counted_realloc (ptr, size)
+		#define sortstats_free(ptr) sortstats_counted_free (ptr)
+	#else
+		#define SORTSTATS_COMPARE() ((void) 0)
+		#define SORTSTATS_SWAP() ((void) 0)
+		#define SORTSTATS_MOVES(n) ((void) 0)
+		#define sortstats_malloc(size) malloc (size)
+		#define sortstats_calloc(n, size) calloc (n, size)
+		#define sortstats_realloc(ptr, size) realloc (ptr, size)
+		#define sortstats_free(ptr) free (ptr)
+	#endif
+
+#endif /* SORTSTATS_H_ */
@@ -0,0 +1,16 @@
+/*
+ * sorttyped.c
+ *
+ *  Created on: 16/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Type specialized sorting functions of ints, floats, doubles, int64_t
+ * 				and uint64_t arrays, with the comparison inlined.
+ */
+
+#include "sorttyped.h"
+
+SORT_DEFINE_SCOPE (, sort_int, int, a < b)
+SORT_DEFINE_SCOPE (, sort_float, float, SORT_LESS_NAN_LAST (a, b))
+SORT_DEFINE_SCOPE (, sort_double, double, SORT_LESS_NAN_LAST (a, b))
+SORT_DEFINE_SCOPE (, sort_int64, int64_t, a < b)
+SORT_DEFINE_SCOPE (, sort_uint64, uint64_t, a < b)
@@ -0,0 +1,33 @@
+/*
+ * sorttyped.h
+ *
+ *  Created on: 16/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the type specialized sorting functions of ints, floats,
+ * 				doubles, int64_t and uint64_t arrays (generated with sortdef.h).
+ *
+ * 	For each type prefix (sort_int, sort_float, sort_double, sort_int64, sort_uint64)
+ * 	the following functions sort arr[0..n-1] in ascending order:
+ *
+ * 		prefix_introsort (arr, n)	not stable, in place
+ * 		prefix_heapsort (arr, n)	not stable, in place
+ * 		prefix_mergesort (arr, n)	stable, n extra elements
+ * 		prefix_timsort (arr, n)		stable, n/2 extra elements
+ *
+ * 	Floats and doubles NaNs are sorted to the end of the array.
+ */
+
+#ifndef SORTTYPED_H_
+	#define SORTTYPED_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+	#include "sortdef.h"
+
+	SORT_DECLARE (sort_int, int)
+	SORT_DECLARE (sort_float, float)
+	SORT_DECLARE (sort_double, double)
+	SORT_DECLARE (sort_int64, int64_t)
+	SORT_DECLARE (sort_uint64, uint64_t)
+
+#endif /* SORTTYPED_H_ */
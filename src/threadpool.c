@@ -0,0 +1,405 @@
+/*
+ * threadpool.c
+ *
+ *  Created on: 16/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements a small work-stealing thread pool for the parallel sorting
+ * 				algorithms.
+ *
+ * About:
+ *
+ *    Divide and conquer sorting algorithms (quicksort, mergesort, samplesort, ...)
+ *    produce an unbalanced tree of tasks whose sizes are not known in advance. A
+ *    single shared queue becomes a point of contention and gives no locality, so each
+ *    worker keeps its own queue:
+ *
+ *      - The owner pushes new tasks and pops them back from the bottom of its queue,
+ *        so it keeps working on the data it just touched (still in cache).
+ *      - An idle worker steals from the top of a victim queue, taking the oldest
+ *        task which, on recursive algorithms, is the biggest one.
+ *
+ *    Queues are protected by a mutex each. Tasks of the sorting algorithms are coarse
+ *    (thousands of elements), so the lock is never the bottleneck and the code stays
+ *    simple and portable.
+ *
+ *    Idle workers sleep on a condition variable and are woken up when new tasks are
+ *    submitted. A thread waiting for a group of tasks helps executing queued tasks
+ *    instead of sleeping, which makes nested fork-join safe.
+ *
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "threadpool.h"
+
+// Initial capacity of each task queue
+static const int threadpool_QUEUE_CAPACITY = 64;
+
+// A queued task
+struct ThreadPoolTask {
+	ThreadPoolTaskFunc func;
+	void* arg;
+	struct ThreadPoolGroup* group;
+};
+
+// Double ended queue of tasks (circular buffer)
+struct ThreadPoolQueue {
+	pthread_mutex_t lock;
+	struct ThreadPoolTask* tasks;
+	int capacity;
+	int top;							// index of the oldest task
+	int size;							// number of queued tasks
+};
+
+// Thread pool data structure
+struct ThreadPool {
+	int nthreads;						// number of threads including the waiting thread
+	int nworkers;						// number of started workers
+	int nqueues;						// one queue per worker plus the shared queue
+	pthread_t* workers;
+	struct ThreadPoolQueue* queues;
+	atomic_int queued;					// number of tasks in all queues
+	atomic_int sleeping;				// number of workers waiting for tasks
+	pthread_mutex_t lock;				// protects 'shutdown' and the wake up condition
+	pthread_cond_t wakeup;
+	int shutdown;
+};
+
+// Arguments of a worker thread
+struct ThreadPoolWorkerArg {
+	struct ThreadPool* pool;
+	int index;
+};
+
+// Pool and queue owned by the current thread (only set on workers)
+static _Thread_local struct ThreadPool* threadpool_self_pool = NULL;
+static _Thread_local int threadpool_self_index = -1;
+
+/*
+ * Gets the queue index where the current thread pushes its tasks.
+ */
+static int threadpool_own_queue (const struct ThreadPool* pool)
+{
+	if (threadpool_self_pool == pool)
+		return threadpool_self_index;
+
+	// Shared queue for threads not belonging to the pool
+	return pool->nworkers;
+}
+
+/*
+ * Initializes a task queue.
+ * Returns 1 if succeeded, 0 otherwise.
+ */
+static int threadpool_queue_init (struct ThreadPoolQueue* queue)
+{
+	queue->tasks = malloc (threadpool_QUEUE_CAPACITY * sizeof (struct ThreadPoolTask));
+	if (queue->tasks == NULL)
+		return 0;
+
+	queue->capacity = threadpool_QUEUE_CAPACITY;
+	queue->top = 0;
+	queue->size = 0;
+	pthread_mutex_init (&queue->lock, NULL);
+	return 1;
+}
+
+/*
+ * Releases a task queue.
+ */
+static void threadpool_queue_destroy (struct ThreadPoolQueue* queue)
+{
+	pthread_mutex_destroy (&queue->lock);
+	free (queue->tasks);
+}
+
+/*
+ * Pushes a task at the bottom of the queue.
+ * Returns 1 if succeeded, 0 otherwise.
+ */
+static int threadpool_queue_push (struct ThreadPoolQueue* queue,
+								  const struct ThreadPoolTask* task)
+{
+	pthread_mutex_lock (&queue->lock);
+
+	if (queue->size == queue->capacity) {
+		// Grow the circular buffer, unrolling it at the beginning of the new one
+		int capacity = 2 * queue->capacity;
+		struct ThreadPoolTask* tasks = malloc (capacity * sizeof (struct ThreadPoolTask));
+		if (tasks == NULL) {
+			pthread_mutex_unlock (&queue->lock);
+			return 0;
+		}
+
+		for (int i = 0; i < queue->size; ++i)
+			tasks[i] = queue->tasks[(queue->top + i) % queue->capacity];
+
+		free (queue->tasks);
+		queue->tasks = tasks;
+		queue->capacity = capacity;
+		queue->top = 0;
+	}
+
+	queue->tasks[(queue->top + queue->size) % queue->capacity] = *task;
+	queue->size++;
+
+	pthread_mutex_unlock (&queue->lock);
+	return 1;
+}
+
+/*
+ * Pops a task from the bottom (newest) or the top (oldest) of the queue.
+ * Returns 1 if a task was taken, 0 if the queue is empty.
+ */
+static int threadpool_queue_pop (struct ThreadPoolQueue* queue, const int fromtop,
+								 struct ThreadPoolTask* task)
+{
+	int found = 0;
+
+	pthread_mutex_lock (&queue->lock);
+	if (queue->size > 0) {
+		if (fromtop) {
+			*task = queue->tasks[queue->top];
+			queue->top = (queue->top + 1) % queue->capacity;
+		}
+		else
+			*task = queue->tasks[(queue->top + queue->size - 1) % queue->capacity];
+
+		queue->size--;
+		found = 1;
+	}
+	pthread_mutex_unlock (&queue->lock);
+
+	return found;
+}
+
+/*
+ * Executes a task and signals its group.
+ */
+static void threadpool_run_task (const struct ThreadPoolTask* task)
+{
+	task->func (task->arg);
+	atomic_fetch_sub (&task->group->pending, 1);
+}
+
+/*
+ * Takes one task, from the own queue first and then stealing from the other queues,
+ * and executes it.
+ * Returns 1 if a task was executed, 0 if there was nothing to do.
+ */
+static int threadpool_run_one (struct ThreadPool* pool, const int self)
+{
+	struct ThreadPoolTask task;
+
+	if (atomic_load (&pool->queued) == 0)
+		return 0;
+
+	// Newest task of our own queue (the shared queue is never popped from the bottom,
+	// it behaves as a FIFO)
+	int found = (self < pool->nworkers) &&
+				threadpool_queue_pop (&pool->queues[self], 0, &task);
+
+	// Oldest task of any other queue, starting at our right neighbour
+	for (int i = 1; !found && i <= pool->nqueues; ++i)
+		found = threadpool_queue_pop (&pool->queues[(self + i) % pool->nqueues], 1, &task);
+
+	if (!found)
+		return 0;
+
+	atomic_fetch_sub (&pool->queued, 1);
+	threadpool_run_task (&task);
+	return 1;
+}
+
+/*
+ * Main loop of a worker thread.
+ */
+static void* threadpool_worker (void* arg)
+{
+	struct ThreadPoolWorkerArg* workerarg = arg;
+	struct ThreadPool* pool = workerarg->pool;
+	const int self = workerarg->index;
+	free (workerarg);
+
+	threadpool_self_pool = pool;
+	threadpool_self_index = self;
+
+	while (1) {
+		if (threadpool_run_one (pool, self))
+			continue;
+
+		// Nothing to do, sleep until new tasks are submitted
+		pthread_mutex_lock (&pool->lock);
+		atomic_fetch_add (&pool->sleeping, 1);
+		while ((atomic_load (&pool->queued) == 0) && !pool->shutdown)
+			pthread_cond_wait (&pool->wakeup, &pool->lock);
+		atomic_fetch_sub (&pool->sleeping, 1);
+		int stop = pool->shutdown && (atomic_load (&pool->queued) == 0);
+		pthread_mutex_unlock (&pool->lock);
+
+		if (stop)
+			break;
+	}
+
+	return NULL;
+}
+
+/*
+ * Gets the number of online processors, used when a parallel sort is requested
+ * with 'nthreads' <= 0.
+ */
+int threadpool_default_threads (void)
+{
+	long n = sysconf (_SC_NPROCESSORS_ONLN);
+	return (n > 0) ? (int)n : 1;
+}
+
+/*
+ * Creates a new thread pool where 'nthreads' threads work on tasks: 'nthreads'-1
+ * workers are started and the thread calling 'threadpool_wait ()' is the last one.
+ * If 'nthreads' <= 0 the number of online processors is used.
+ * Returns the new pool if succeeded, NULL otherwise.
+ */
+struct ThreadPool* threadpool_create (int nthreads)
+{
+	if (nthreads <= 0)
+		nthreads = threadpool_default_threads ();
+
+	struct ThreadPool* pool = malloc (sizeof (struct ThreadPool));
+	if (pool == NULL)
+		return NULL;
+
+	pool->nthreads = nthreads;
+	pool->nworkers = 0;
+	pool->nqueues = nthreads;
+	atomic_init (&pool->queued, 0);
+	atomic_init (&pool->sleeping, 0);
+	pool->shutdown = 0;
+	pthread_mutex_init (&pool->lock, NULL);
+	pthread_cond_init (&pool->wakeup, NULL);
+
+	pool->workers = malloc (nthreads * sizeof (pthread_t));
+	pool->queues = malloc (pool->nqueues * sizeof (struct ThreadPoolQueue));
+	if ((pool->workers == NULL) || (pool->queues == NULL)) {
+		free (pool->workers);
+		free (pool->queues);
+		free (pool);
+		return NULL;
+	}
+
+	int nqueues = 0;
+	while ((nqueues < pool->nqueues) && threadpool_queue_init (&pool->queues[nqueues]))
+		nqueues++;
+
+	// Start workers, the queue after the last worker is the shared one
+	int ok = (nqueues == pool->nqueues);
+	for (int i = 0; ok && i < (nthreads - 1); ++i) {
+		struct ThreadPoolWorkerArg* workerarg = malloc (sizeof (struct ThreadPoolWorkerArg));
+		ok = (workerarg != NULL);
+		if (ok) {
+			workerarg->pool = pool;
+			workerarg->index = i;
+			ok = (pthread_create (&pool->workers[i], NULL, threadpool_worker, workerarg) == 0);
+			if (ok)
+				pool->nworkers++;
+			else
+				free (workerarg);
+		}
+	}
+
+	if (!ok) {
+		// Workers only read 'nworkers' queues and the shared queue, shrink the pool
+		// to the started workers and shut it down
+		pool->nqueues = nqueues;
+		threadpool_destroy (pool);
+		return NULL;
+	}
+
+	return pool;
+}
+
+/*
+ * Gets the number of threads working on tasks, including the waiting thread.
+ */
+int threadpool_num_threads (const struct ThreadPool* pool)
+{
+	return pool->nthreads;
+}
+
+/*
+ * Initializes an empty tasks group.
+ */
+void threadpool_group_init (struct ThreadPoolGroup* group)
+{
+	atomic_init (&group->pending, 0);
+}
+
+/*
+ * Submits a new task of the given group.
+ * Tasks submitted from a worker go to its own queue, tasks submitted from any other
+ * thread go to a shared queue.
+ * Returns 1 if the task was queued, 0 if it could not be queued and was executed
+ * right away by the calling thread.
+ */
+int threadpool_submit (struct ThreadPool* pool, struct ThreadPoolGroup* group,
+					   ThreadPoolTaskFunc func, void* arg)
+{
+	struct ThreadPoolTask task = { func, arg, group };
+	atomic_fetch_add (&group->pending, 1);
+
+	if (!threadpool_queue_push (&pool->queues[threadpool_own_queue (pool)], &task)) {
+		threadpool_run_task (&task);
+		return 0;
+	}
+
+	atomic_fetch_add (&pool->queued, 1);
+
+	// Wake up a sleeping worker, if any
+	if (atomic_load (&pool->sleeping) > 0) {
+		pthread_mutex_lock (&pool->lock);
+		pthread_cond_signal (&pool->wakeup);
+		pthread_mutex_unlock (&pool->lock);
+	}
+
+	return 1;
+}
+
+/*
+ * Waits until all tasks of the group are done.
+ * The calling thread executes queued tasks while waiting.
+ */
+void threadpool_wait (struct ThreadPool* pool, struct ThreadPoolGroup* group)
+{
+	const int self = threadpool_own_queue (pool);
+
+	while (atomic_load (&group->pending) > 0) {
+		if (!threadpool_run_one (pool, self))
+			sched_yield ();
+	}
+}
+
+/*
+ * Stops all workers and releases the pool.
+ * Note: All groups must be waited for before destroying the pool.
+ */
+void threadpool_destroy (struct ThreadPool* pool)
+{
+	pthread_mutex_lock (&pool->lock);
+	pool->shutdown = 1;
+	pthread_cond_broadcast (&pool->wakeup);
+	pthread_mutex_unlock (&pool->lock);
+
+	for (int i = 0; i < pool->nworkers; ++i)
+		pthread_join (pool->workers[i], NULL);
+
+	for (int i = 0; i < pool->nqueues; ++i)
+		threadpool_queue_destroy (&pool->queues[i]);
+
+	pthread_mutex_destroy (&pool->lock);
+	pthread_cond_destroy (&pool->wakeup);
+	free (pool->workers);
+	free (pool->queues);
+	free (pool);
+}
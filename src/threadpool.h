@@ -0,0 +1,84 @@
+/*
+ * threadpool.h
+ *
+ *  Created on: 16/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for the work-stealing thread pool used by the parallel
+ * 				sorting algorithms.
+ *
+ * Every worker owns a double ended queue of tasks. A worker pushes and pops tasks
+ * at the bottom of its own queue (LIFO, good cache locality for divide and conquer
+ * algorithms) and, when its queue is empty, steals the oldest task from the top of
+ * another worker queue (FIFO, usually the biggest piece of work left).
+ *
+ * Tasks are tracked by groups. A thread waiting for a group does not block, it keeps
+ * executing queued tasks until every task of the group is done, so tasks may freely
+ * submit and wait for subtasks (fork-join) without deadlocking the pool.
+ */
+
+#ifndef THREADPOOL_H_
+	#define THREADPOOL_H_
+
+	#include <stdatomic.h>
+	#include "sortapi.h"
+
+	/*
+	 * Defines function prototype for a task executed by the thread pool.
+	 */
+	typedef void (*ThreadPoolTaskFunc)(void* arg);
+
+	// Opaque thread pool data structure
+	struct ThreadPool;
+
+	// Set of tasks that can be waited for as a whole
+	struct ThreadPoolGroup {
+		atomic_int pending;			// number of submitted tasks not yet finished
+	};
+
+	/*
+	 * Gets the number of online processors, used when a parallel sort is requested
+	 * with 'nthreads' <= 0.
+	 */
+	SORT_API int threadpool_default_threads (void);
+
+	/*
+	 * Creates a new thread pool where 'nthreads' threads work on tasks: 'nthreads'-1
+	 * workers are started and the thread calling 'threadpool_wait ()' is the last one.
+	 * If 'nthreads' <= 0 the number of online processors is used.
+	 * Returns the new pool if succeeded, NULL otherwise.
+	 */
+	SORT_API struct ThreadPool* threadpool_create (int nthreads);
+
+	/*
+	 * Gets the number of threads working on tasks, including the waiting thread.
+	 */
+	SORT_API int threadpool_num_threads (const struct ThreadPool* pool);
+
+	/*
+	 * Initializes an empty tasks group.
+	 */
+	SORT_API void threadpool_group_init (struct ThreadPoolGroup* group);
+
+	/*
+	 * Submits a new task of the given group.
+	 * Tasks submitted from a worker go to its own queue, tasks submitted from any other
+	 * thread go to a shared queue.
+	 * Returns 1 if the task was queued, 0 if it could not be queued and was executed
+	 * right away by the calling thread.
+	 */
+	SORT_API int threadpool_submit (struct ThreadPool* pool, struct ThreadPoolGroup* group,
+									ThreadPoolTaskFunc func, void* arg);
+
+	/*
+	 * Waits until all tasks of the group are done.
+	 * The calling thread executes queued tasks while waiting.
+	 */
+	SORT_API void threadpool_wait (struct ThreadPool* pool, struct ThreadPoolGroup* group);
+
+	/*
+	 * Stops all workers and releases the pool.
+	 * Note: All groups must be waited for before destroying the pool.
+	 */
+	SORT_API void threadpool_destroy (struct ThreadPool* pool);
+
+#endif /* THREADPOOL_H_ */
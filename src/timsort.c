@@ -18,6 +18,27 @@
  * 	these runs using a modified merge sort algorithm.
  *
  *
+ * Implementation (timsort_sort, timsort_sort_values):
+ *
+ * 	- Runs: the array is scanned for natural runs, ascending (a[i] <= a[i+1]) or
+ * 	  strictly descending (reversed in place, which keeps the sort stable).
+ * 	- Minrun: runs shorter than minrun (in [32..64], chosen so that n / minrun is
+ * 	  a power of 2 or close to it) are extended with binary insertion sort.
+ * 	- Merge stack: runs are pushed on a stack and merged while the invariants
+ * 	  len[i-2] > len[i-1] + len[i] and len[i-1] > len[i] don't hold, so merges
+ * 	  stay balanced and the stack depth is O(log n).
+ * 	- Merges: the head of the left run and the tail of the right run that are
+ * 	  already in place are skipped using galloping (exponential then binary)
+ * 	  searches. The smaller run is moved to a single heap buffer, that grows as
+ * 	  needed and is reused by all merges. When one run wins 'mingallop' times in a
+ * 	  row, the merge switches to galloping mode and moves whole blocks; 'mingallop'
+ * 	  adapts to the data.
+ *
+ * 	Sorted, reversed and mostly sorted inputs are sorted in near linear time.
+ * 	'timsort_sort_values ()' does the same on contiguous elements of any size,
+ * 	moving them with memcpy ().
+ *
+ *
  * Complexity Analysis:
  *
  * Case Complexity
@@ -51,136 +72,1177 @@
  *  |-----------------------------------------------------------|
  *
  *
- * Source: https://www.geeksforgeeks.org/timsort/
+ * Sources:
+ * 		https://www.geeksforgeeks.org/timsort/
+ * 		https://github.com/python/cpython/blob/main/Objects/listsort.txt
  *
  */
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "sort.h"
+#include "timsort.h"
+#include "sortstats.h"
+
+/*
+ * Runs shorter than this are sorted with binary insertion sort, no merges.
+ */
+static const int timsort_MIN_MERGE = 64;
+
+/*
+ * Initial number of consecutive wins of one run to enter galloping mode.
+ */
+static const int timsort_MIN_GALLOP = 7;
+
+/*
+ * Maximum number of pending runs. The stack invariants make run lengths grow
+ * at least as fast as Fibonacci numbers, so 85 runs are enough for any array
+ * that fits in a 64 bits address space.
+ */
+#define TIMSORT_MAX_PENDING 85
+
+/*
+ * Pending run, arr[base..base+len-1].
+ */
+struct TimsortRun {
+	int base;
+	int len;
+};
+
+/*
+ * Timsort state of one sort call.
+ */
+struct TimsortState {
+	void** arr;
+	SortCompareFunc comparefunc;
+	int mingallop;						// current galloping threshold
+	void** buf;							// merge buffer
+	int bufsize;						// merge buffer capacity (elements)
+	int nruns;							// number of pending runs
+	struct TimsortRun runs[TIMSORT_MAX_PENDING];
+};
+
+/*
+ * Pending run of values, arr[base..base+len-1].
+ */
+struct TimsortValuesRun {
+	size_t base;
+	size_t len;
+};
+
+/*
+ * Timsort state of one 'timsort_sort_values ()' call.
+ */
+struct TimsortValuesState {
+	char* arr;
+	size_t size;						// element size (bytes)
+	SortCompareFunc comparefunc;
+	size_t mingallop;					// current galloping threshold
+	char* buf;							// merge buffer
+	size_t bufsize;						// merge buffer capacity (elements)
+	void* key;							// one element, for binary insertion sort
+	unsigned char keybuf[128];
+	int nruns;							// number of pending runs
+	struct TimsortValuesRun runs[TIMSORT_MAX_PENDING];
+};
+
+/*
+ * Returns 1 if a < b and 0 otherwise.
+ */
+static inline int timsort_lt (void* a, void* b, SortCompareFunc comparefunc)
+{
+	return comparefunc (a, b) < 0;
+}
+
+/*
+ * Returns the minimum run length for an array of n elements: n itself if
+ * n < timsort_MIN_MERGE, else a value in [MIN_MERGE/2..MIN_MERGE] such that
+ * n / minrun is a power of 2 or slightly less.
+ */
+static size_t timsort_minrun (size_t n)
+{
+	size_t r = 0;
+	while (n >= timsort_MIN_MERGE) {
+		r |= n & 1;
+		n >>= 1;
+	}
+	return n + r;
+}
+
+/*
+ * Returns the length of the run starting at arr[lo] (arr[lo..hi-1] is the
+ * remaining array). A strictly descending run is reversed in place.
+ */
+static int timsort_count_run (void* arr[], const int lo, const int hi,
+							  SortCompareFunc comparefunc)
+{
+	int r = lo + 1;
+	if (r == hi)
+		return 1;
+
+	if (timsort_lt (arr[r++], arr[lo], comparefunc)) {
+		while (r < hi && timsort_lt (arr[r], arr[r - 1], comparefunc))
+			r++;
+		for (int i = lo, j = r - 1; i < j; i++, j--)
+			sort_swap (&arr[i], &arr[j]);
+	}
+	else {
+		while (r < hi && !timsort_lt (arr[r], arr[r - 1], comparefunc))
+			r++;
+	}
+
+	return r - lo;
+}
+
+/*
+ * Sorts arr[lo..hi-1] with binary insertion sort, arr[lo..start-1] is
+ * already sorted.
+ */
+static void timsort_binary_insertion_sort (void* arr[], const int lo, const int hi,
+										   int start, SortCompareFunc comparefunc)
+{
+	for (; start < hi; start++) {
+		void* pivot = arr[start];
+		int l = lo;
+		int r = start;
+		while (l < r) {
+			int m = l + ((r - l) >> 1);
+			if (timsort_lt (pivot, arr[m], comparefunc))
+				r = m;
+			else
+				l = m + 1;
+		}
+		memmove (&arr[l + 1], &arr[l], (start - l) * sizeof (void*));
+		arr[l] = pivot;
+		SORTSTATS_MOVES (start - l + 1);
+	}
+}
+
+/*
+ * Locates the position to insert key in the sorted a[0..n-1], starting the
+ * search at a[hint]. Returns k such that a[k-1] < key <= a[k] (leftmost
+ * position if there are equal elements).
+ */
+static int timsort_gallop_left (void* key, void* a[], const int n, const int hint,
+								SortCompareFunc comparefunc)
+{
+	int ofs = 1;
+	int lastofs = 0;
+	int maxofs;
 
-static const int timsort_RUN = 32;
+	if (timsort_lt (a[hint], key, comparefunc)) {
+		// a[hint] < key, gallop right until a[hint+lastofs] < key <= a[hint+ofs]
+		maxofs = n - hint;
+		while (ofs < maxofs && timsort_lt (a[hint + ofs], key, comparefunc)) {
+			lastofs = ofs;
+			ofs = (ofs << 1) + 1;
+			if (ofs <= 0)	// int overflow
+				ofs = maxofs;
+		}
+		if (ofs > maxofs)
+			ofs = maxofs;
+		lastofs += hint;
+		ofs += hint;
+	}
+	else {
+		// key <= a[hint], gallop left until a[hint-ofs] < key <= a[hint-lastofs]
+		maxofs = hint + 1;
+		while (ofs < maxofs && !timsort_lt (a[hint - ofs], key, comparefunc)) {
+			lastofs = ofs;
+			ofs = (ofs << 1) + 1;
+			if (ofs <= 0)
+				ofs = maxofs;
+		}
+		if (ofs > maxofs)
+			ofs = maxofs;
+		int k = lastofs;
+		lastofs = hint - ofs;
+		ofs = hint - k;
+	}
 
+	// Now a[lastofs] < key <= a[ofs], binary search in between
+	lastofs++;
+	while (lastofs < ofs) {
+		int m = lastofs + ((ofs - lastofs) >> 1);
+		if (timsort_lt (a[m], key, comparefunc))
+			lastofs = m + 1;
+		else
+			ofs = m;
+	}
+	return ofs;
+}
 
 /*
- * Auxiliary function to return min of two values.
+ * Like 'timsort_gallop_left ()' but returns k such that a[k-1] <= key < a[k]
+ * (rightmost position if there are equal elements).
  */
-static int timsort_min (const int a, const int b) {
-	return (a < b) ? a : b;
+static int timsort_gallop_right (void* key, void* a[], const int n, const int hint,
+								 SortCompareFunc comparefunc)
+{
+	int ofs = 1;
+	int lastofs = 0;
+	int maxofs;
+
+	if (timsort_lt (key, a[hint], comparefunc)) {
+		// key < a[hint], gallop left until a[hint-ofs] <= key < a[hint-lastofs]
+		maxofs = hint + 1;
+		while (ofs < maxofs && timsort_lt (key, a[hint - ofs], comparefunc)) {
+			lastofs = ofs;
+			ofs = (ofs << 1) + 1;
+			if (ofs <= 0)
+				ofs = maxofs;
+		}
+		if (ofs > maxofs)
+			ofs = maxofs;
+		int k = lastofs;
+		lastofs = hint - ofs;
+		ofs = hint - k;
+	}
+	else {
+		// a[hint] <= key, gallop right until a[hint+lastofs] <= key < a[hint+ofs]
+		maxofs = n - hint;
+		while (ofs < maxofs && !timsort_lt (key, a[hint + ofs], comparefunc)) {
+			lastofs = ofs;
+			ofs = (ofs << 1) + 1;
+			if (ofs <= 0)
+				ofs = maxofs;
+		}
+		if (ofs > maxofs)
+			ofs = maxofs;
+		lastofs += hint;
+		ofs += hint;
+	}
+
+	// Now a[lastofs] <= key < a[ofs], binary search in between
+	lastofs++;
+	while (lastofs < ofs) {
+		int m = lastofs + ((ofs - lastofs) >> 1);
+		if (timsort_lt (key, a[m], comparefunc))
+			ofs = m;
+		else
+			lastofs = m + 1;
+	}
+	return ofs;
+}
+
+/*
+ * Makes sure the merge buffer holds at least 'need' elements.
+ */
+static void timsort_ensure_buffer (struct TimsortState* ts, const int need)
+{
+	if (need <= ts->bufsize)
+		return;
+
+	// Grow geometrically so a few larger merges don't reallocate each time
+	int newsize = ts->bufsize * 2;
+	if (newsize < need)
+		newsize = need;
+
+	sortstats_free (ts->buf);
+	ts->buf = sortstats_malloc (newsize * sizeof (void*));
+	if (ts->buf == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for timsort.");
+		abort ();
+	}
+	ts->bufsize = newsize;
+}
+
+/*
+ * Merges the adjacent runs a[0..na-1] and b[0..nb-1] in a stable way, where
+ * na <= nb, a[0] > b[0] and a[na-1] > b[nb-1]. Run a is moved to the buffer and
+ * the merge goes from left to right.
+ */
+static void timsort_merge_lo (struct TimsortState* ts, void** pa, int na,
+							  void** pb, int nb)
+{
+	SortCompareFunc comparefunc = ts->comparefunc;
+	void** dest = pa;
+	int mingallop = ts->mingallop;
+
+	timsort_ensure_buffer (ts, na);
+	memcpy (ts->buf, pa, na * sizeof (void*));
+	SORTSTATS_MOVES (na + na + nb);		// to the buffer, then the merge
+	pa = ts->buf;
+
+	// b[0] is the smallest
+	*dest++ = *pb++;
+	if (--nb == 0)
+		goto succeed;
+	if (na == 1)
+		goto copyb;
+
+	for (;;) {
+		int acount = 0;		// times in a row run a won
+		int bcount = 0;		// times in a row run b won
+
+		// One at a time, until one run wins consistently
+		for (;;) {
+			if (timsort_lt (*pb, *pa, comparefunc)) {
+				*dest++ = *pb++;
+				bcount++;
+				acount = 0;
+				if (--nb == 0)
+					goto succeed;
+				if (bcount >= mingallop)
+					break;
+			}
+			else {
+				*dest++ = *pa++;
+				acount++;
+				bcount = 0;
+				if (--na == 1)
+					goto copyb;
+				if (acount >= mingallop)
+					break;
+			}
+		}
+
+		// Galloping mode, until neither run wins by timsort_MIN_GALLOP or more
+		mingallop++;
+		do {
+			mingallop -= (mingallop > 1);
+			ts->mingallop = mingallop;
+
+			int k = timsort_gallop_right (*pb, pa, na, 0, comparefunc);
+			acount = k;
+			if (k) {
+				memcpy (dest, pa, k * sizeof (void*));
+				dest += k;
+				pa += k;
+				na -= k;
+				if (na == 1)
+					goto copyb;
+				// na == 0 is only possible with an inconsistent comparison
+				if (na == 0)
+					goto succeed;
+			}
+			*dest++ = *pb++;
+			if (--nb == 0)
+				goto succeed;
+
+			k = timsort_gallop_left (*pa, pb, nb, 0, comparefunc);
+			bcount = k;
+			if (k) {
+				memmove (dest, pb, k * sizeof (void*));
+				dest += k;
+				pb += k;
+				nb -= k;
+				if (nb == 0)
+					goto succeed;
+			}
+			*dest++ = *pa++;
+			if (--na == 1)
+				goto copyb;
+		} while (acount >= timsort_MIN_GALLOP || bcount >= timsort_MIN_GALLOP);
+
+		// Penalize leaving galloping mode
+		mingallop++;
+		ts->mingallop = mingallop;
+	}
+
+succeed:
+	if (na)
+		memcpy (dest, pa, na * sizeof (void*));
+	return;
+
+copyb:
+	// Last element of run a goes after the rest of run b
+	memmove (dest, pb, nb * sizeof (void*));
+	dest[nb] = *pa;
 }
 
 /*
- * This function sorts array from left index to right index which is
- * of size atmost RUN.
+ * Merges the adjacent runs a[0..na-1] and b[0..nb-1] in a stable way, where
+ * na >= nb, a[0] > b[0] and a[na-1] > b[nb-1]. Run b is moved to the buffer and
+ * the merge goes from right to left.
  */
-static void timsort_insertion_sort (void* arr[], const int left, const int right,
-									SortCompareFunc comparefunc)
+static void timsort_merge_hi (struct TimsortState* ts, void** pa, int na,
+							  void** pb, int nb)
 {
-    for (int i = left + 1; i <= right; i++) {
-    	void* temp = arr[i];
-    	int j = i - 1;
-        while (j >= left && (comparefunc (arr[j], temp) > 0)) {
-            arr[j + 1] = arr[j];
-            j--;
-        }
-        arr[j + 1] = temp;
-    }
+	SortCompareFunc comparefunc = ts->comparefunc;
+	void** dest = pb + nb - 1;
+	void** basea = pa;
+	void** baseb;
+	int mingallop = ts->mingallop;
+
+	timsort_ensure_buffer (ts, nb);
+	memcpy (ts->buf, pb, nb * sizeof (void*));
+	SORTSTATS_MOVES (nb + na + nb);		// to the buffer, then the merge
+	baseb = ts->buf;
+	pb = baseb + nb - 1;
+	pa += na - 1;
+
+	// a[na-1] is the largest
+	*dest-- = *pa--;
+	if (--na == 0)
+		goto succeed;
+	if (nb == 1)
+		goto copya;
+
+	for (;;) {
+		int acount = 0;		// times in a row run a won
+		int bcount = 0;		// times in a row run b won
+
+		// One at a time, until one run wins consistently
+		for (;;) {
+			if (timsort_lt (*pb, *pa, comparefunc)) {
+				*dest-- = *pa--;
+				acount++;
+				bcount = 0;
+				if (--na == 0)
+					goto succeed;
+				if (acount >= mingallop)
+					break;
+			}
+			else {
+				*dest-- = *pb--;
+				bcount++;
+				acount = 0;
+				if (--nb == 1)
+					goto copya;
+				if (bcount >= mingallop)
+					break;
+			}
+		}
+
+		// Galloping mode, until neither run wins by timsort_MIN_GALLOP or more
+		mingallop++;
+		do {
+			mingallop -= (mingallop > 1);
+			ts->mingallop = mingallop;
+
+			int k = na - timsort_gallop_right (*pb, basea, na, na - 1, comparefunc);
+			acount = k;
+			if (k) {
+				dest -= k;
+				pa -= k;
+				memmove (dest + 1, pa + 1, k * sizeof (void*));
+				na -= k;
+				if (na == 0)
+					goto succeed;
+			}
+			*dest-- = *pb--;
+			if (--nb == 1)
+				goto copya;
+
+			k = nb - timsort_gallop_left (*pa, baseb, nb, nb - 1, comparefunc);
+			bcount = k;
+			if (k) {
+				dest -= k;
+				pb -= k;
+				memcpy (dest + 1, pb + 1, k * sizeof (void*));
+				nb -= k;
+				if (nb == 1)
+					goto copya;
+				// nb == 0 is only possible with an inconsistent comparison
+				if (nb == 0)
+					goto succeed;
+			}
+			*dest-- = *pa--;
+			if (--na == 0)
+				goto succeed;
+		} while (acount >= timsort_MIN_GALLOP || bcount >= timsort_MIN_GALLOP);
+
+		// Penalize leaving galloping mode
+		mingallop++;
+		ts->mingallop = mingallop;
+	}
+
+succeed:
+	if (nb)
+		memcpy (dest - (nb - 1), baseb, nb * sizeof (void*));
+	return;
+
+copya:
+	// First element of run b goes before the rest of run a
+	dest -= na;
+	pa -= na;
+	memmove (dest + 1, pa + 1, na * sizeof (void*));
+	*dest = *pb;
 }
 
 /*
- * Merge function merges the sorted runs.
+ * Merges the pending runs i and i+1.
  */
-static void timsort_merge (void* arr[], const int l, const int m, const int r,
-						   SortCompareFunc comparefunc)
+static void timsort_merge_at (struct TimsortState* ts, const int i)
 {
-    // Original array is broken in two
-    // parts left and right array
-	int len1 = m - l + 1;
-	int len2 = r - m;
-	void* left[len1];
-	void* right[len2];
+	void** arr = ts->arr;
+	void** pa = arr + ts->runs[i].base;
+	int na = ts->runs[i].len;
+	void** pb = arr + ts->runs[i + 1].base;
+	int nb = ts->runs[i + 1].len;
 
-    for (int i = 0; i < len1; i++)
-        left[i] = arr[l + i];
-    for (int i = 0; i < len2; i++)
-        right[i] = arr[m + 1 + i];
+	ts->runs[i].len = na + nb;
+	if (i == ts->nruns - 3)
+		ts->runs[i + 1] = ts->runs[i + 2];
+	ts->nruns--;
 
-    int i = 0;
-    int j = 0;
-    int k = l;
+	// Elements of run a not greater than b[0] are already in place
+	int k = timsort_gallop_right (*pb, pa, na, 0, ts->comparefunc);
+	pa += k;
+	na -= k;
+	if (na == 0)
+		return;
 
-    // After comparing, we
-    // merge those two array
-    // in larger sub array
-    while (i < len1 && j < len2) {
-        if (!(comparefunc (left[i], right[j]) > 0)) {
-            arr[k] = left[i];
-            i++;
-        }
-        else {
-            arr[k] = right[j];
-            j++;
-        }
-        k++;
-    }
+	// Elements of run b not less than a[na-1] are already in place
+	nb = timsort_gallop_left (pa[na - 1], pb, nb, nb - 1, ts->comparefunc);
+	if (nb == 0)
+		return;
 
-    // Copy remaining elements of
-    // left, if any
-    while (i < len1) {
-        arr[k] = left[i];
-        k++;
-        i++;
-    }
+	if (na <= nb)
+		timsort_merge_lo (ts, pa, na, pb, nb);
+	else
+		timsort_merge_hi (ts, pa, na, pb, nb);
+}
 
-    // Copy remaining element of
-    // right, if any
-    while (j < len2) {
-        arr[k] = right[j];
-        k++;
-        j++;
-    }
+/*
+ * Merges pending runs until the stack invariants hold again:
+ * 	len[i-2] > len[i-1] + len[i]
+ * 	len[i-1] > len[i]
+ */
+static void timsort_merge_collapse (struct TimsortState* ts)
+{
+	struct TimsortRun* runs = ts->runs;
+
+	while (ts->nruns > 1) {
+		int n = ts->nruns - 2;
+		if ((n > 0 && runs[n - 1].len <= runs[n].len + runs[n + 1].len) ||
+			(n > 1 && runs[n - 2].len <= runs[n - 1].len + runs[n].len)) {
+			if (runs[n - 1].len < runs[n + 1].len)
+				n--;
+		}
+		else if (runs[n].len > runs[n + 1].len)
+			break;
+		timsort_merge_at (ts, n);
+	}
+}
+
+/*
+ * Merges all pending runs.
+ */
+static void timsort_merge_force_collapse (struct TimsortState* ts)
+{
+	struct TimsortRun* runs = ts->runs;
+
+	while (ts->nruns > 1) {
+		int n = ts->nruns - 2;
+		if (n > 0 && runs[n - 1].len < runs[n + 1].len)
+			n--;
+		timsort_merge_at (ts, n);
+	}
 }
 
 /*
- * Iterative Timsort function to sort the
- * array[from...to] (similar to merge sort)
+ * Timsort function to sort the array[from...to] (stable).
  */
 void timsort_sort (void* arr[], const int from, const int to,
 				   SortCompareFunc comparefunc)
 {
-    // Sort individual subarrays of size RUN
-    for (int i = from; i < (to + 1); i += timsort_RUN)
-    	timsort_insertion_sort (arr, i, timsort_min ((i + timsort_RUN - 1), to),
-    							comparefunc);
+	const int n = to - from + 1;
+	const int hi = to + 1;
+
+	if (n < 2)
+		return;
+
+	// Small arrays, a single mini run
+	if (n < timsort_MIN_MERGE) {
+		int len = timsort_count_run (arr, from, hi, comparefunc);
+		timsort_binary_insertion_sort (arr, from, hi, from + len, comparefunc);
+		return;
+	}
+
+	struct TimsortState ts;
+	ts.arr = arr;
+	ts.comparefunc = comparefunc;
+	ts.mingallop = timsort_MIN_GALLOP;
+	ts.buf = NULL;
+	ts.bufsize = 0;
+	ts.nruns = 0;
+
+	const int minrun = (int)timsort_minrun ((size_t)n);
+	int lo = from;
+
+	while (lo < hi) {
+		int len = timsort_count_run (arr, lo, hi, comparefunc);
+
+		// Extend short runs to minrun
+		if (len < minrun) {
+			int force = (hi - lo < minrun) ? (hi - lo) : minrun;
+			timsort_binary_insertion_sort (arr, lo, lo + force, lo + len, comparefunc);
+			len = force;
+		}
+
+		ts.runs[ts.nruns].base = lo;
+		ts.runs[ts.nruns].len = len;
+		ts.nruns++;
+		timsort_merge_collapse (&ts);
+
+		lo += len;
+	}
+
+	timsort_merge_force_collapse (&ts);
+	sortstats_free (ts.buf);
+}
+
+/*
+ * Returns the length of the run of values starting at arr[lo] (arr[lo..hi-1] is
+ * the remaining array). A strictly descending run is reversed in place.
+ */
+static size_t timsort_values_count_run (struct TimsortValuesState* ts, const size_t lo,
+										const size_t hi)
+{
+	char* arr = ts->arr;
+	const size_t size = ts->size;
+	SortCompareFunc comparefunc = ts->comparefunc;
+	size_t r = lo + 1;
+	if (r == hi)
+		return 1;
+
+	if (comparefunc (arr + r * size, arr + lo * size) < 0) {
+		r++;
+		while (r < hi && comparefunc (arr + r * size, arr + (r - 1) * size) < 0)
+			r++;
+		for (size_t i = lo, j = r - 1; i < j; i++, j--)
+			sort_swap_values (arr + i * size, arr + j * size, size);
+	}
+	else {
+		r++;
+		while (r < hi && !(comparefunc (arr + r * size, arr + (r - 1) * size) < 0))
+			r++;
+	}
+
+	return r - lo;
+}
+
+/*
+ * Sorts the values arr[lo..hi-1] with binary insertion sort, arr[lo..start-1]
+ * is already sorted.
+ */
+static void timsort_values_binary_insertion_sort (struct TimsortValuesState* ts,
+												  const size_t lo, const size_t hi,
+												  size_t start)
+{
+	char* arr = ts->arr;
+	const size_t size = ts->size;
+	SortCompareFunc comparefunc = ts->comparefunc;
+
+	for (; start < hi; start++) {
+		char* pivot = arr + start * size;
+		size_t l = lo;
+		size_t r = start;
+		while (l < r) {
+			size_t m = l + ((r - l) >> 1);
+			if (comparefunc (pivot, arr + m * size) < 0)
+				r = m;
+			else
+				l = m + 1;
+		}
+		if (l == start)
+			continue;
+		memcpy (ts->key, pivot, size);
+		memmove (arr + (l + 1) * size, arr + l * size, (start - l) * size);
+		memcpy (arr + l * size, ts->key, size);
+		SORTSTATS_MOVES (start - l + 1);
+	}
+}
+
+/*
+ * Locates the position to insert key in the sorted values a[0..n-1], starting
+ * the search at a[hint]. Returns k such that a[k-1] < key <= a[k] (leftmost
+ * position if there are equal elements).
+ */
+static size_t timsort_values_gallop_left (const void* key, const char* a, const size_t n,
+										  const size_t hint, const size_t size,
+										  SortCompareFunc comparefunc)
+{
+	size_t ofs = 1;
+	size_t lastofs = 0;
+	size_t maxofs;
+	size_t lo;
+	size_t hi;
+
+	if (comparefunc (a + hint * size, key) < 0) {
+		// a[hint] < key, gallop right until a[hint+lastofs] < key <= a[hint+ofs]
+		maxofs = n - hint;
+		while (ofs < maxofs && comparefunc (a + (hint + ofs) * size, key) < 0) {
+			lastofs = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		if (ofs > maxofs)
+			ofs = maxofs;
+		lo = hint + lastofs + 1;
+		hi = hint + ofs;
+	}
+	else {
+		// key <= a[hint], gallop left until a[hint-ofs] < key <= a[hint-lastofs]
+		maxofs = hint + 1;
+		while (ofs < maxofs && !(comparefunc (a + (hint - ofs) * size, key) < 0)) {
+			lastofs = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		if (ofs > maxofs)
+			ofs = maxofs;
+		lo = hint + 1 - ofs;
+		hi = hint - lastofs;
+	}
+
+	// Now a[lo-1] < key <= a[hi], binary search in between
+	while (lo < hi) {
+		size_t m = lo + ((hi - lo) >> 1);
+		if (comparefunc (a + m * size, key) < 0)
+			lo = m + 1;
+		else
+			hi = m;
+	}
+	return hi;
+}
+
+/*
+ * Like 'timsort_values_gallop_left ()' but returns k such that
+ * a[k-1] <= key < a[k] (rightmost position if there are equal elements).
+ */
+static size_t timsort_values_gallop_right (const void* key, const char* a, const size_t n,
+										   const size_t hint, const size_t size,
+										   SortCompareFunc comparefunc)
+{
+	size_t ofs = 1;
+	size_t lastofs = 0;
+	size_t maxofs;
+	size_t lo;
+	size_t hi;
+
+	if (comparefunc (key, a + hint * size) < 0) {
+		// key < a[hint], gallop left until a[hint-ofs] <= key < a[hint-lastofs]
+		maxofs = hint + 1;
+		while (ofs < maxofs && comparefunc (key, a + (hint - ofs) * size) < 0) {
+			lastofs = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		if (ofs > maxofs)
+			ofs = maxofs;
+		lo = hint + 1 - ofs;
+		hi = hint - lastofs;
+	}
+	else {
+		// a[hint] <= key, gallop right until a[hint+lastofs] <= key < a[hint+ofs]
+		maxofs = n - hint;
+		while (ofs < maxofs && !(comparefunc (key, a + (hint + ofs) * size) < 0)) {
+			lastofs = ofs;
+			ofs = (ofs << 1) + 1;
+		}
+		if (ofs > maxofs)
+			ofs = maxofs;
+		lo = hint + lastofs + 1;
+		hi = hint + ofs;
+	}
+
+	// Now a[lo-1] <= key < a[hi], binary search in between
+	while (lo < hi) {
+		size_t m = lo + ((hi - lo) >> 1);
+		if (comparefunc (key, a + m * size) < 0)
+			hi = m;
+		else
+			lo = m + 1;
+	}
+	return hi;
+}
+
+/*
+ * Makes sure the values merge buffer holds at least 'need' elements.
+ */
+static void timsort_values_ensure_buffer (struct TimsortValuesState* ts, const size_t need)
+{
+	if (need <= ts->bufsize)
+		return;
+
+	// Grow geometrically so a few larger merges don't reallocate each time
+	size_t newsize = ts->bufsize * 2;
+	if (newsize < need)
+		newsize = need;
+
+	sortstats_free (ts->buf);
+	ts->buf = sortstats_malloc (newsize * ts->size);
+	if (ts->buf == NULL) {
+		fprintf (stderr, "Error: failed to allocate memory for timsort.");
+		abort ();
+	}
+	ts->bufsize = newsize;
+}
+
+/*
+ * Merges the adjacent runs of values a[0..na-1] and b[0..nb-1] in a stable way,
+ * where na <= nb, a[0] > b[0] and a[na-1] > b[nb-1]. Run a is moved to the
+ * buffer and the merge goes from left to right.
+ */
+static void timsort_values_merge_lo (struct TimsortValuesState* ts, char* pa, size_t na,
+									 char* pb, size_t nb)
+{
+	SortCompareFunc comparefunc = ts->comparefunc;
+	const size_t size = ts->size;
+	const size_t mingallopmin = timsort_MIN_GALLOP;
+	char* dest = pa;
+	size_t mingallop = ts->mingallop;
+
+	timsort_values_ensure_buffer (ts, na);
+	memcpy (ts->buf, pa, na * size);
+	SORTSTATS_MOVES (na + na + nb);		// to the buffer, then the merge
+	pa = ts->buf;
+
+	// b[0] is the smallest
+	memcpy (dest, pb, size);
+	dest += size;
+	pb += size;
+	if (--nb == 0)
+		goto succeed;
+	if (na == 1)
+		goto copyb;
+
+	for (;;) {
+		size_t acount = 0;		// times in a row run a won
+		size_t bcount = 0;		// times in a row run b won
+
+		// One at a time, until one run wins consistently
+		for (;;) {
+			if (comparefunc (pb, pa) < 0) {
+				memcpy (dest, pb, size);
+				dest += size;
+				pb += size;
+				bcount++;
+				acount = 0;
+				if (--nb == 0)
+					goto succeed;
+				if (bcount >= mingallop)
+					break;
+			}
+			else {
+				memcpy (dest, pa, size);
+				dest += size;
+				pa += size;
+				acount++;
+				bcount = 0;
+				if (--na == 1)
+					goto copyb;
+				if (acount >= mingallop)
+					break;
+			}
+		}
+
+		// Galloping mode, until neither run wins by timsort_MIN_GALLOP or more
+		mingallop++;
+		do {
+			mingallop -= (mingallop > 1);
+			ts->mingallop = mingallop;
+
+			size_t k = timsort_values_gallop_right (pb, pa, na, 0, size, comparefunc);
+			acount = k;
+			if (k) {
+				memcpy (dest, pa, k * size);
+				dest += k * size;
+				pa += k * size;
+				na -= k;
+				if (na == 1)
+					goto copyb;
+				// na == 0 is only possible with an inconsistent comparison
+				if (na == 0)
+					goto succeed;
+			}
+			memcpy (dest, pb, size);
+			dest += size;
+			pb += size;
+			if (--nb == 0)
+				goto succeed;
+
+			k = timsort_values_gallop_left (pa, pb, nb, 0, size, comparefunc);
+			bcount = k;
+			if (k) {
+				memmove (dest, pb, k * size);
+				dest += k * size;
+				pb += k * size;
+				nb -= k;
+				if (nb == 0)
+					goto succeed;
+			}
+			memcpy (dest, pa, size);
+			dest += size;
+			pa += size;
+			if (--na == 1)
+				goto copyb;
+		} while (acount >= mingallopmin || bcount >= mingallopmin);
+
+		// Penalize leaving galloping mode
+		mingallop++;
+		ts->mingallop = mingallop;
+	}
+
+succeed:
+	if (na)
+		memcpy (dest, pa, na * size);
+	return;
+
+copyb:
+	// Last element of run a goes after the rest of run b
+	memmove (dest, pb, nb * size);
+	memcpy (dest + nb * size, pa, size);
+}
+
+/*
+ * Merges the adjacent runs of values a[0..na-1] and b[0..nb-1] in a stable way,
+ * where na >= nb, a[0] > b[0] and a[na-1] > b[nb-1]. Run b is moved to the
+ * buffer and the merge goes from right to left.
+ */
+static void timsort_values_merge_hi (struct TimsortValuesState* ts, char* pa, size_t na,
+									 char* pb, size_t nb)
+{
+	SortCompareFunc comparefunc = ts->comparefunc;
+	const size_t size = ts->size;
+	const size_t mingallopmin = timsort_MIN_GALLOP;
+	char* dest = pb + (nb - 1) * size;
+	char* basea = pa;
+	char* baseb;
+	size_t mingallop = ts->mingallop;
+
+	timsort_values_ensure_buffer (ts, nb);
+	memcpy (ts->buf, pb, nb * size);
+	SORTSTATS_MOVES (nb + na + nb);		// to the buffer, then the merge
+	baseb = ts->buf;
+	pb = baseb + (nb - 1) * size;
+	pa += (na - 1) * size;
+
+	// a[na-1] is the largest
+	memcpy (dest, pa, size);
+	dest -= size;
+	pa -= size;
+	if (--na == 0)
+		goto succeed;
+	if (nb == 1)
+		goto copya;
+
+	for (;;) {
+		size_t acount = 0;		// times in a row run a won
+		size_t bcount = 0;		// times in a row run b won
+
+		// One at a time, until one run wins consistently
+		for (;;) {
+			if (comparefunc (pb, pa) < 0) {
+				memcpy (dest, pa, size);
+				dest -= size;
+				pa -= size;
+				acount++;
+				bcount = 0;
+				if (--na == 0)
+					goto succeed;
+				if (acount >= mingallop)
+					break;
+			}
+			else {
+				memcpy (dest, pb, size);
+				dest -= size;
+				pb -= size;
+				bcount++;
+				acount = 0;
+				if (--nb == 1)
+					goto copya;
+				if (bcount >= mingallop)
+					break;
+			}
+		}
+
+		// Galloping mode, until neither run wins by timsort_MIN_GALLOP or more
+		mingallop++;
+		do {
+			mingallop -= (mingallop > 1);
+			ts->mingallop = mingallop;
+
+			size_t k = na - timsort_values_gallop_right (pb, basea, na, na - 1, size,
+														 comparefunc);
+			acount = k;
+			if (k) {
+				dest -= k * size;
+				pa -= k * size;
+				memmove (dest + size, pa + size, k * size);
+				na -= k;
+				if (na == 0)
+					goto succeed;
+			}
+			memcpy (dest, pb, size);
+			dest -= size;
+			pb -= size;
+			if (--nb == 1)
+				goto copya;
+
+			k = nb - timsort_values_gallop_left (pa, baseb, nb, nb - 1, size, comparefunc);
+			bcount = k;
+			if (k) {
+				dest -= k * size;
+				pb -= k * size;
+				memcpy (dest + size, pb + size, k * size);
+				nb -= k;
+				if (nb == 1)
+					goto copya;
+				// nb == 0 is only possible with an inconsistent comparison
+				if (nb == 0)
+					goto succeed;
+			}
+			memcpy (dest, pa, size);
+			dest -= size;
+			pa -= size;
+			if (--na == 0)
+				goto succeed;
+		} while (acount >= mingallopmin || bcount >= mingallopmin);
+
+		// Penalize leaving galloping mode
+		mingallop++;
+		ts->mingallop = mingallop;
+	}
+
+succeed:
+	if (nb)
+		memcpy (dest - (nb - 1) * size, baseb, nb * size);
+	return;
+
+copya:
+	// First element of run b goes before the rest of run a
+	dest -= na * size;
+	pa -= na * size;
+	memmove (dest + size, pa + size, na * size);
+	memcpy (dest, pb, size);
+}
+
+/*
+ * Merges the pending runs of values i and i+1.
+ */
+static void timsort_values_merge_at (struct TimsortValuesState* ts, const int i)
+{
+	const size_t size = ts->size;
+	char* pa = ts->arr + ts->runs[i].base * size;
+	size_t na = ts->runs[i].len;
+	char* pb = ts->arr + ts->runs[i + 1].base * size;
+	size_t nb = ts->runs[i + 1].len;
 
-    // Start merging from size RUN (or 32).
-    // It will merge
-    // to form size 64, then 128, 256
-    // and so on ....
-    for (int size = timsort_RUN; size < (to + 1); size = 2 * size) {
+	ts->runs[i].len = na + nb;
+	if (i == ts->nruns - 3)
+		ts->runs[i + 1] = ts->runs[i + 2];
+	ts->nruns--;
 
-        // pick starting point of
-        // left sub array. We
-        // are going to merge
-        // arr[left..left+size-1]
-        // and arr[left+size, left+2*size-1]
-        // After every merge, we
-        // increase left by 2*size
-        for (int left = from; left < (to + 1); left += 2 * size) {
+	// Elements of run a not greater than b[0] are already in place
+	size_t k = timsort_values_gallop_right (pb, pa, na, 0, size, ts->comparefunc);
+	pa += k * size;
+	na -= k;
+	if (na == 0)
+		return;
 
-            // Find ending point of
-            // left sub array
-            // mid+1 is starting point
-            // of right sub array
-        	int mid = left + size - 1;
-        	int right = timsort_min ( (left + 2 * size - 1), to );
+	// Elements of run b not less than a[na-1] are already in place
+	nb = timsort_values_gallop_left (pa + (na - 1) * size, pb, nb, nb - 1, size,
+									 ts->comparefunc);
+	if (nb == 0)
+		return;
 
-            // merge sub array arr[left.....mid] &
-            // arr[mid+1....right]
-            if (mid < right)
-            	timsort_merge (arr, left, mid, right, comparefunc);
-        }
-    }
+	if (na <= nb)
+		timsort_values_merge_lo (ts, pa, na, pb, nb);
+	else
+		timsort_values_merge_hi (ts, pa, na, pb, nb);
 }
 
+/*
+ * Merges pending runs of values until the stack invariants hold again
+ * (see 'timsort_merge_collapse ()').
+ */
+static void timsort_values_merge_collapse (struct TimsortValuesState* ts)
+{
+	struct TimsortValuesRun* runs = ts->runs;
 
+	while (ts->nruns > 1) {
+		int n = ts->nruns - 2;
+		if ((n > 0 && runs[n - 1].len <= runs[n].len + runs[n + 1].len) ||
+			(n > 1 && runs[n - 2].len <= runs[n - 1].len + runs[n].len)) {
+			if (runs[n - 1].len < runs[n + 1].len)
+				n--;
+		}
+		else if (runs[n].len > runs[n + 1].len)
+			break;
+		timsort_values_merge_at (ts, n);
+	}
+}
 
+/*
+ * Merges all pending runs of values.
+ */
+static void timsort_values_merge_force_collapse (struct TimsortValuesState* ts)
+{
+	struct TimsortValuesRun* runs = ts->runs;
+
+	while (ts->nruns > 1) {
+		int n = ts->nruns - 2;
+		if (n > 0 && runs[n - 1].len < runs[n + 1].len)
+			n--;
+		timsort_values_merge_at (ts, n);
+	}
+}
+
+/*
+ * Timsort function to sort 'n' contiguous elements of 'size' bytes each
+ * starting at 'base' (stable).
+ * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+ */
+void timsort_sort_values (void* base, const size_t n, const size_t size,
+						  SortCompareFunc comparefunc)
+{
+	const size_t minmerge = timsort_MIN_MERGE;
+
+	if (n < 2)
+		return;
+
+	struct TimsortValuesState ts;
+	ts.arr = base;
+	ts.size = size;
+	ts.comparefunc = comparefunc;
+	ts.mingallop = timsort_MIN_GALLOP;
+	ts.buf = NULL;
+	ts.bufsize = 0;
+	ts.nruns = 0;
+
+	// Elements bigger than the local buffer need a heap allocated key
+	ts.key = ts.keybuf;
+	if (size > sizeof (ts.keybuf)) {
+		ts.key = sortstats_malloc (size);
+		if (ts.key == NULL) {
+			fprintf (stderr, "Error: failed to allocate memory for timsort.");
+			abort ();
+		}
+	}
+
+	// Small arrays, a single mini run
+	if (n < minmerge) {
+		size_t len = timsort_values_count_run (&ts, 0, n);
+		timsort_values_binary_insertion_sort (&ts, 0, n, len);
+	}
+	else {
+		const size_t minrun = timsort_minrun (n);
+		size_t lo = 0;
+
+		while (lo < n) {
+			size_t len = timsort_values_count_run (&ts, lo, n);
+
+			// Extend short runs to minrun
+			if (len < minrun) {
+				size_t force = (n - lo < minrun) ? (n - lo) : minrun;
+				timsort_values_binary_insertion_sort (&ts, lo, lo + force, lo + len);
+				len = force;
+			}
+
+			ts.runs[ts.nruns].base = lo;
+			ts.runs[ts.nruns].len = len;
+			ts.nruns++;
+			timsort_values_merge_collapse (&ts);
+
+			lo += len;
+		}
+
+		timsort_values_merge_force_collapse (&ts);
+	}
+
+	sortstats_free (ts.buf);
+	if (ts.key != ts.keybuf)
+		sortstats_free (ts.key);
+}
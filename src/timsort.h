@@ -11,12 +11,24 @@
 
 	#include <stdlib.h>
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
-	 * Iterative Timsort function to sort the
-	 * array[0...n-1] (similar to merge sort)
+	 * Timsort function to sort the array[from...to] (stable).
+	 * Natural runs are merged with galloping, so sorted, reversed and mostly
+	 * sorted inputs take near linear time. Uses a buffer of at most n/2 elements.
+	 * Note: from (inclusive) .. to (inclusive)
 	 */
-	void timsort_sort (void* arr[], const int from, const int to,
-					   SortCompareFunc comparefunc);
+	SORT_API void timsort_sort (void* arr[], const int from, const int to,
+								SortCompareFunc comparefunc);
+
+	/*
+	 * Timsort function to sort 'n' contiguous elements of 'size' bytes each
+	 * starting at 'base' (stable). Same runs, merges and galloping as
+	 * 'timsort_sort ()', with a buffer of at most n/2 elements.
+	 * Note: 'comparefunc' receives pointers to the elements (like 'qsort ()').
+	 */
+	SORT_API void timsort_sort_values (void* base, const size_t n, const size_t size,
+									   SortCompareFunc comparefunc);
 
 #endif /* TIMSORT_H_ */
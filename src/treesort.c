@@ -55,6 +55,8 @@
 
 #include <stdlib.h>
 #include "sort.h"
+#include "treesort.h"
+#include "sortstats.h"
 
 struct TreesortNode
 {
@@ -68,8 +70,9 @@ struct TreesortNode
  */
 static struct TreesortNode* treesort_new_node (void* item)
 {
-    struct TreesortNode* temp = (struct TreesortNode*)malloc (sizeof (*temp));
+    struct TreesortNode* temp = (struct TreesortNode*)sortstats_malloc (sizeof (*temp));
     temp->key = item;
+    SORTSTATS_MOVES (1);
     temp->left = temp->right = NULL;
     return temp;
 }
@@ -83,6 +86,7 @@ static void treesort_store_sorted (struct TreesortNode* root, void* arr[], int*
     {
     	treesort_store_sorted (root->left, arr, i);
         arr[(*i)++] = root->key;
+        SORTSTATS_MOVES (1);
         treesort_store_sorted (root->right, arr, i);
     }
 }
@@ -117,7 +121,7 @@ static void treesort_destroy_bst (struct TreesortNode* root)
 	if (root != NULL) {
 		treesort_destroy_bst (root->left);
 		treesort_destroy_bst (root->right);
-		free (root);
+		sortstats_free (root);
 	}
 }
 
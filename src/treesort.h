@@ -9,11 +9,12 @@
 #ifndef TREESORT_H_
 	#define TREESORT_H_
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
 	 * This function sorts arr[from..to] using Tree Sort
 	 */
-	void treesort_sort (void* arr[], const int from, const int to,
-						SortCompareFunc comparefunc);
+	SORT_API void treesort_sort (void* arr[], const int from, const int to,
+								 SortCompareFunc comparefunc);
 
 #endif /* TREESORT_H_ */
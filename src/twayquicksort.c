@@ -50,6 +50,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "sort.h"
+#include "twayquicksort.h"
 
 /* This function partitions a[] in three parts
  *  a) a[l..i] contains all elements smaller than pivot
@@ -105,13 +106,13 @@ static void twayquicksort_partition (void* a[], int l, int r, int* i, int* j,
     // Move all left same occurrences from beginning
     // to adjacent to arr[i]
     *j = *i - 1;
-    for (int k = l; k < p; k++, *j--)
+    for (int k = l; k < p; k++, (*j)--)
         sort_swap (&a[k], &a[*j]);
 
     // Move all right same occurrences from end
     // to adjacent to arr[i]
     *i = *i + 1;
-    for (int k = r - 1; k > q; k--, *i++)
+    for (int k = r - 1; k > q; k--, (*i)++)
         sort_swap (&a[*i], &a[k]);
 }
 
@@ -11,13 +11,14 @@
 	#define TWAYQUICKSORT_H_
 
 	#include "sort.h"
+	#include "sortapi.h"
 
 	/*
 	 * 3-way partition based quick sort.
 	 * Note: When input data repeats many times, this variant is muck more eficient
 	 * 		 than simple quicksort.
 	 */
-	void twayquicksort_sort (void* a[], const int l, const int r,
-							 SortCompareFunc comparefunc);
+	SORT_API void twayquicksort_sort (void* a[], const int l, const int r,
+									  SortCompareFunc comparefunc);
 
 #endif /* TWAYQUICKSORT_H_ */